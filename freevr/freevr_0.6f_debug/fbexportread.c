@@ -0,0 +1,297 @@
+/* ======================================================================
+ *
+ *  CCCCC          fbexportread.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for a reader of the shared-memory framebuffer export of a
+ *   FreeVR window (see vr_fbexport.h).  It is both an example of how a
+ *   compositor or encoder can use the exported frames in place, and a
+ *   test of the export: it checks that the frames arrive in order and
+ *   whole, and measures the rate, throughput and age of the frames it
+ *   gets.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+/*************************************************************************
+
+USAGE:
+	fbexportread [-n <frames>] [-t <seconds>] [-q] [<name>]
+
+	-n -- stop after this many frames (default: no limit)
+	-t -- stop after this many seconds (default 10)
+	-q -- only print the summary, not the once-a-second report
+	<name> -- the shared-memory object of the export (default
+		"/freevr-default" -- ie. the "default" window)
+
+	For example, start a FreeVR application with a window exporting
+	(eg. the window argument "export=1;", or the telnet command
+	"window[0] export start"), then run "fbexportread /freevr-<window>".
+
+	The reader doesn't copy the frames, but does read every pixel (as
+	an encoder would), to measure the throughput of the memory.  The
+	summary counts:
+		frames -- frames read whole
+		gaps -- frames the writer put in the ring that weren't read
+			(the reader fell behind, or was polling too slowly)
+		torn -- frames overwritten while they were being read
+		out of order -- frames older than one already read (an error)
+	The exit status is 1 if any frames were out of order.
+
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "vr_fbexport.h"
+
+
+/* the settings of this run */
+static	char		*name = "/freevr-default";
+static	long		max_frames = 0;
+static	double		max_time = 10.0;
+static	int		quiet = 0;
+
+/* the open export */
+static	int		fd = -1;
+static	size_t		map_size = 0;
+static	vrFBExportHeader *header = NULL;
+
+/* the counts of the run */
+static	long		frames = 0;
+static	long		gaps = 0;
+static	long		torn = 0;
+static	long		out_of_order = 0;
+static	long		reopens = 0;
+static	double		bytes = 0.0;
+static	double		age_sum = 0.0;
+static	double		age_max = 0.0;
+
+static	volatile int	done = 0;
+
+
+/*****************************************************************/
+static double wall_time()
+{
+	struct timeval	now;
+
+	gettimeofday(&now, NULL);
+	return (double)now.tv_sec + (double)now.tv_usec / 1000000.0;
+}
+
+
+/*****************************************************************/
+static void stop_handler(int sig)
+{
+	done = 1;
+}
+
+
+/*****************************************************************/
+static void close_export()
+{
+	if (header != NULL)
+		munmap(header, map_size);
+	if (fd >= 0)
+		close(fd);
+	header = NULL;
+	fd = -1;
+}
+
+
+/*****************************************************************/
+/* open_export(): map the export, waiting (until the run is over) */
+/*   for the writer to create it.  Returns 0 if the run ended.    */
+static int open_export(double end_time)
+{
+	struct stat	info;
+
+	while (!done && wall_time() < end_time) {
+		if ((fd = shm_open(name, O_RDONLY, 0)) >= 0) {
+			if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(vrFBExportHeader)) {
+				map_size = info.st_size;
+				header = (vrFBExportHeader *)mmap(NULL, map_size, PROT_READ, MAP_SHARED, fd, 0);
+				if (header == MAP_FAILED) {
+					fprintf(stderr, "fbexportread: unable to map '%s' (%s).\n", name, strerror(errno));
+					header = NULL;
+					close_export();
+					return 0;
+				}
+
+				/* the magic number is put last, once the header is complete */
+				if (header->magic == VR_FBEXPORT_MAGIC && header->writer_alive
+				    && header->slot_offset + header->slot_size * header->num_slots <= map_size) {
+					if (header->version != VR_FBEXPORT_VERSION) {
+						fprintf(stderr, "fbexportread: '%s' is version %u, not %d.\n", name, header->version, VR_FBEXPORT_VERSION);
+						close_export();
+						return 0;
+					}
+					if (!quiet)
+						printf("opened '%s': %ux%u, %u slots, from process %u\n",
+							name, header->width, header->height, header->num_slots, header->writer_pid);
+					return 1;
+				}
+			}
+			close_export();
+		}
+		usleep(100000);
+	}
+
+	return 0;
+}
+
+
+/*****************************************************************/
+/* read_pixels(): go through every pixel of a frame, as a user of */
+/*   it would -- the sum is only there so it can't be skipped.    */
+static uint64_t read_pixels(unsigned char *pixels, uint64_t size)
+{
+	const uint64_t	*word = (const uint64_t *)pixels;
+	uint64_t	sum = 0;
+	uint64_t	count;
+
+	for (count = 0; count < size / sizeof(uint64_t); count++)
+		sum += word[count];
+
+	return sum;
+}
+
+
+/*****************************************************************/
+int main(int argc, char *argv[])
+{
+	double		start_time;
+	double		end_time;
+	double		report_time;
+	double		now;
+	double		age;
+	double		frame_time;
+	uint64_t	last_seq = 0;
+	uint64_t	last_frame = 0;
+	uint64_t	seq;
+	uint64_t	frame;
+	uint64_t	sum = 0;
+	long		report_frames = 0;
+	double		report_bytes = 0.0;
+	int		num;
+	int		opt;
+
+	while ((opt = getopt(argc, argv, "n:t:q")) != -1) {
+		switch (opt) {
+		case 'n':	max_frames = atol(optarg);	break;
+		case 't':	max_time = atof(optarg);	break;
+		case 'q':	quiet = 1;			break;
+		default:
+			fprintf(stderr, "Usage: %s [-n <frames>] [-t <seconds>] [-q] [<name>]\n", argv[0]);
+			exit(2);
+		}
+	}
+	if (optind < argc)
+		name = argv[optind];
+
+	signal(SIGINT, stop_handler);
+
+	start_time = wall_time();
+	end_time = start_time + max_time;
+	report_time = start_time + 1.0;
+
+	if (!open_export(end_time)) {
+		fprintf(stderr, "fbexportread: no export '%s' found.\n", name);
+		exit(2);
+	}
+
+	while (!done && (max_frames == 0 || frames < max_frames)) {
+		now = wall_time();
+		if (now >= end_time)
+			break;
+
+		/* the writer stopped (or the window changed size) -- start over */
+		if (!header->writer_alive) {
+			if (!quiet)
+				printf("the writer of '%s' has stopped -- reopening\n", name);
+			close_export();
+			reopens++;
+			if (!open_export(end_time))
+				break;
+			last_seq = 0;
+			last_frame = 0;
+			continue;
+		}
+
+		seq = header->frame_seq;
+		if (seq == last_seq) {
+			usleep(200);
+			continue;
+		}
+		__sync_synchronize();
+
+		if (seq < last_seq) {
+			out_of_order++;
+			last_seq = seq;
+			continue;
+		}
+		if (last_seq != 0 && seq > last_seq + 1)
+			gaps += seq - last_seq - 1;
+		last_seq = seq;
+
+		/* use the frame in place, then check it wasn't overwritten meanwhile */
+		num = (int)(seq % header->num_slots);
+		if (header->slot[num].seq != seq) {
+			torn++;
+			continue;
+		}
+		__sync_synchronize();
+		frame = header->slot[num].frame;
+		age = wall_time() - header->slot[num].render_wtime;
+		sum += read_pixels(VR_FBEXPORT_PIXELS(header, num), header->slot_size);
+		__sync_synchronize();
+		if (header->slot[num].seq != seq) {
+			torn++;
+			continue;
+		}
+
+		if (last_frame != 0 && frame <= last_frame)
+			out_of_order++;
+		last_frame = frame;
+
+		frames++;
+		bytes += header->slot_size;
+		age_sum += age;
+		if (age > age_max)
+			age_max = age;
+		frame_time = wall_time();
+
+		if (!quiet && frame_time >= report_time) {
+			printf("%6.1f fps  %7.1f MB/s  age %6.2f ms  (frame %llu)\n",
+				(double)(frames - report_frames) / (frame_time - report_time + 1.0),
+				(bytes - report_bytes) / (frame_time - report_time + 1.0) / (1024.0 * 1024.0),
+				age * 1000.0,
+				(unsigned long long)frame);
+			report_frames = frames;
+			report_bytes = bytes;
+			report_time = frame_time + 1.0;
+		}
+	}
+
+	now = wall_time() - start_time;
+	printf("'%s': %ld frames in %.2f secs -- %.1f fps, %.1f MB/s\n",
+		name, frames, now, frames / now, bytes / now / (1024.0 * 1024.0));
+	printf("\tframe age (render to read): mean %.2f ms, max %.2f ms\n",
+		(frames > 0 ? age_sum / frames * 1000.0 : 0.0), age_max * 1000.0);
+	printf("\tgaps = %ld; torn = %ld; out of order = %ld; reopens = %ld (checksum %llx)\n",
+		gaps, torn, out_of_order, reopens, (unsigned long long)sum);
+
+	close_export();
+
+	exit(out_of_order > 0 ? 1 : 0);
+}
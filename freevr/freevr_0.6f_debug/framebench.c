@@ -0,0 +1,471 @@
+/* ======================================================================
+ *
+ *  CCCCC          framebench.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for a benchmark of the FreeVR frame loop.  A synthetic scene
+ *   with a configurable drawing cost is rendered for a fixed number of
+ *   frames, and the vrProcessStats measures of each visual rendering
+ *   process are gathered and reported as percentiles in JSON format.
+ *
+ * The companion configuration file "rc_framebench" has a set of systems
+ *   that use the text and headless (EGL) visual rendering windows, so
+ *   the benchmark can run without a display, and any change to the
+ *   library can be compared from one run to the next.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+/*************************************************************************
+
+USAGE:
+	framebench [-n <frames>] [-w <warmup frames>] [-q <quads>]
+		[-c <usecs>] [-i <inputs>] [-s] [-b <ms>] [-S <system>]
+		[-o <json file>] [<config strings> ...]
+
+	-n -- the number of frames to measure in each visren process (default 1000)
+	-w -- the number of frames to skip before measuring (default 20)
+	-q -- the number of quads drawn for each eye (default 1000)
+	-c -- the microseconds of CPU spent for each eye (default 0)
+	-i -- the number of inputs read for each eye (default 16)
+	-s -- also set a single-pass stereo callback, which (in windows
+		that can use it) draws both eyes in one call, and so reads
+		the inputs and spends the CPU time only once for the pair
+	-b -- give each window a frame budget of this many milliseconds,
+		and set a budget callback that draws 10% fewer quads each
+		time a frame is predicted to go over it
+	-S -- read "rc_framebench" (from the current directory) and use
+		the named system (eg. "bench-txt", "bench-egl", "bench-cave4")
+	-o -- write the JSON report to a file rather than stdout
+
+	Any remaining arguments are passed on to vrConfigure() as
+	configuration strings.  The visren processes of the system must
+	have statistics enabled (eg. stats = "show=off; frames=1000";),
+	since those are the measures that are reported.
+
+	The "bench-egl-dualvp" system has a window with both eyes side by
+	side, which is rendered in a single pass when "-s" is given.
+
+	The report has the p50, p95, p99 and max (in milliseconds) of each
+	of the labeled stats elements (sync, freeze, render, swap, etc.) and
+	of the whole frame, as well as of each labeled stats value.
+
+NOTE: the text visren doesn't call the application's rendering callback,
+	so with it only the framework overhead is measured.
+
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <GL/gl.h>
+
+#include "freevr.h"
+
+
+#define	MAX_PHASES	(VR_MAXSTATSVALUES + 32)
+
+/* the settings of this run */
+static	int		quads = 1000;
+static	int		cpu_usecs = 0;
+static	int		inputs = 16;
+static	int		stereo = 0;
+static	float		budget = 0.0;
+
+/* shared with the visren processes */
+static	volatile int	*eye_renders;
+static	volatile double	*input_sum;
+static	volatile int	*budget_calls;
+
+
+/*********************************************************************/
+static double wall_time()
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+
+/*********************************************************************/
+/* draw_quads(): the geometry of the synthetic scene -- a fan of     */
+/*   small quads.                                                    */
+static void draw_quads()
+{
+	int		count;
+
+	glBegin(GL_QUADS);
+	for (count = 0; count < quads; count++) {
+		float	x = (float)(count % 100) * 0.1 - 5.0;
+		float	y = (float)(count / 100 % 100) * 0.1;
+		float	z = -5.0 + (float)(count / 10000) * 0.01;
+
+		glColor3f(x * 0.1 + 0.5, y * 0.1, 0.5);
+		glVertex3f(x,       y,       z);
+		glVertex3f(x + 0.1, y,       z);
+		glVertex3f(x + 0.1, y + 0.1, z);
+		glVertex3f(x,       y + 0.1, z);
+	}
+	glEnd();
+}
+
+
+/*********************************************************************/
+/* scene_work(): the non-drawing work of the synthetic scene -- a    */
+/*   handful of input reads, and some spent CPU time.                */
+static void scene_work()
+{
+	double		start;
+	double		sum = 0.0;
+	int		count;
+	int		num_valuators = vrContext->input->num_valuators;
+	int		num_2ways = vrContext->input->num_2ways;
+
+	for (count = 0; count < inputs; count++) {
+		if (count & 0x01 && num_2ways > 0)
+			sum += vrGet2switchValue(count % num_2ways);
+		else if (num_valuators > 0)
+			sum += vrGetValuatorValue(count % num_valuators);
+	}
+
+	if (cpu_usecs > 0) {
+		start = wall_time();
+		while ((wall_time() - start) * 1000000.0 < cpu_usecs)
+			sum += 1.0e-9;
+	}
+
+	*input_sum += sum;
+}
+
+
+/*********************************************************************/
+/* draw_world(): render the synthetic scene for one eye.             */
+static void draw_world(vrRenderInfo *renderinfo)
+{
+	glClearColor(0.0, 0.0, 0.0, 0.0);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	draw_quads();
+	scene_work();
+
+	vrAtomicIncrement(eye_renders);
+}
+
+
+/*********************************************************************/
+/* draw_world_stereo(): render the synthetic scene for both eyes of  */
+/*   a window at once.  The scene work is done once, and only the    */
+/*   geometry is drawn into the viewport of each eye.                */
+static void draw_world_stereo(vrRenderInfo *renderinfo)
+{
+	vrStereoInfo	*stereo = renderinfo->stereo;
+	vrMatrix	mat;
+	int		eye;
+
+	glClearColor(0.0, 0.0, 0.0, 0.0);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	scene_work();
+
+	for (eye = VR_STEREO_LEFT; eye <= VR_STEREO_RIGHT; eye++) {
+		glViewport(stereo->viewport[eye].origX, stereo->viewport[eye].origY,
+			stereo->viewport[eye].width, stereo->viewport[eye].height);
+		glMatrixMode(GL_PROJECTION);
+		glLoadMatrixd(vrRenderGetStereoProjection(renderinfo, eye, &mat)->v);
+		glMatrixMode(GL_MODELVIEW);
+		glLoadMatrixd(vrRenderGetStereoView(renderinfo, eye, &mat)->v);
+
+		draw_quads();
+
+		vrAtomicIncrement(eye_renders);
+	}
+}
+
+
+/*********************************************************************/
+/* over_budget(): lower the level-of-detail of the scene (in this    */
+/*   visren process) when its frame is predicted to miss the budget. */
+static void over_budget(vrRenderInfo *renderinfo)
+{
+	if (quads > 100)
+		quads -= quads / 10;
+
+	vrAtomicIncrement(budget_calls);
+}
+
+
+/*********************************************************************/
+static int cmp_double(const void *a, const void *b)
+{
+	double	da = *(const double *)a;
+	double	db = *(const double *)b;
+
+	return (da > db) - (da < db);
+}
+
+
+/*********************************************************************/
+/* percentile(): nearest-rank percentile of a sorted array */
+static double percentile(double *sorted, int num, double pct)
+{
+	int	rank;
+
+	if (num == 0)
+		return 0.0;
+
+	rank = (int)ceil(pct / 100.0 * num) - 1;
+	if (rank < 0)
+		rank = 0;
+	if (rank >= num)
+		rank = num - 1;
+
+	return sorted[rank];
+}
+
+
+/*********************************************************************/
+static void print_percentiles(FILE *fp, char *name, double *data, int num, int last)
+{
+	qsort(data, num, sizeof(double), cmp_double);
+	fprintf(fp, "        \"%s\": { \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+		name,
+		percentile(data, num, 50.0),
+		percentile(data, num, 95.0),
+		percentile(data, num, 99.0),
+		(num > 0 ? data[num-1] : 0.0),
+		(last ? "" : ","));
+}
+
+
+/*********************************************************************/
+int main(int argc, char* argv[])
+{
+	vrProcessInfo	**procs;		/* the visren processes */
+	vrProcessStats	*stats;
+	int		num_procs = 0;
+	double		**samples;		/* per-process: [phase][frame] */
+	long		*next_frame;		/* per-process: next frame to copy */
+	long		*dropped;		/* per-process: frames that were overwritten before being copied */
+	int		*num_samples;
+	int		frames = 1000;
+	int		warmup = 20;
+	char		*system = NULL;
+	char		*json_file = NULL;
+	char		sys_string[256];
+	FILE		*fp = stdout;
+	long		total_frames;
+	double		eyes_per_frame;
+	int		done;
+	int		new_argc;
+	int		count;
+	int		proc;
+
+	/* handle (and remove) our own options -- the rest are config strings */
+	new_argc = 1;
+	for (count = 1; count < argc; count++) {
+		if (!strcmp(argv[count], "-n") && count+1 < argc)
+			frames = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-w") && count+1 < argc)
+			warmup = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-q") && count+1 < argc)
+			quads = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-c") && count+1 < argc)
+			cpu_usecs = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-i") && count+1 < argc)
+			inputs = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-s"))
+			stereo = 1;
+		else if (!strcmp(argv[count], "-b") && count+1 < argc)
+			budget = atof(argv[++count]);
+		else if (!strcmp(argv[count], "-S") && count+1 < argc)
+			system = argv[++count];
+		else if (!strcmp(argv[count], "-o") && count+1 < argc)
+			json_file = argv[++count];
+		else if (argv[count][0] == '-') {
+			printf("usage: %s [-n <frames>] [-w <warmup>] [-q <quads>] [-c <usecs>] [-i <inputs>] [-s] [-b <ms>] [-S <system>] [-o <json file>] [<config strings>]\n", argv[0]);
+			exit(1);
+		} else	argv[new_argc++] = argv[count];
+	}
+	if (system != NULL) {
+		sprintf(sys_string, "readconfig \"rc_framebench\"; usesystem \"%.200s\";", system);
+		argv[new_argc++] = sys_string;
+	}
+	argv[new_argc] = NULL;
+	argc = new_argc;
+
+	if (frames < 1)
+		frames = 1;
+
+	vrShmemInit(30 * 1024 * 1024);
+	vrConfigure(&argc, argv, NULL);
+
+	eye_renders = (volatile int *)vrShmemAlloc0(sizeof(int));
+	input_sum = (volatile double *)vrShmemAlloc0(sizeof(double));
+	budget_calls = (volatile int *)vrShmemAlloc0(sizeof(int));
+	vrCallbackSet(VRFUNC_DISPLAY, "framebench:draw_world", draw_world, 0);
+	if (stereo)
+		vrCallbackSet(VRFUNC_DISPLAY_STEREO, "framebench:draw_world_stereo", draw_world_stereo, 0);
+	if (budget > 0.0) {
+		for (count = 0; count < vrContext->config->num_windows; count++)
+			vrContext->config->windows[count]->frame_budget = budget;
+		vrCallbackSet(VRFUNC_DISPLAY_BUDGET, "framebench:over_budget", over_budget, 0);
+	}
+
+	vrStart();
+
+	/*****************************************/
+	/* find the visren processes with stats */
+	procs = (vrProcessInfo **)calloc(vrContext->config->num_procs, sizeof(vrProcessInfo *));
+	for (count = 0; count < vrContext->config->num_procs; count++) {
+		if (vrContext->config->procs[count]->type != VRPROC_VISREN)
+			continue;
+		if (vrContext->config->procs[count]->stats_args == NULL) {
+			vrErrPrintf(RED_TEXT "framebench: visren process '%s' has no stats -- skipping it (add 'stats = \"show=off\";' to it)\n" NORM_TEXT,
+				vrContext->config->procs[count]->name);
+			continue;
+		}
+		procs[num_procs++] = vrContext->config->procs[count];
+	}
+	if (num_procs == 0) {
+		vrErrPrintf(RED_TEXT "framebench: no visren processes with stats to measure.\n" NORM_TEXT);
+		vrExit();
+		exit(1);
+	}
+
+	/* the stats are created by the processes themselves, so wait for them */
+	for (proc = 0; proc < num_procs; proc++) {
+		while (procs[proc]->stats == NULL && vrContext->status == VRSTATUS_RUNNING)
+			vrSleep(10000);
+	}
+
+	samples = (double **)calloc(num_procs, sizeof(double *));
+	next_frame = (long *)calloc(num_procs, sizeof(long));
+	dropped = (long *)calloc(num_procs, sizeof(long));
+	num_samples = (int *)calloc(num_procs, sizeof(int));
+	for (proc = 0; proc < num_procs; proc++) {
+		samples[proc] = (double *)calloc(MAX_PHASES * frames, sizeof(double));
+		next_frame[proc] = warmup + 1;
+	}
+
+	/***********************************************************/
+	/* copy each completed frame's measures out of the rings.  */
+	/*   Frame number "k" (counting from 1) is stored in slot  */
+	/*   (k-1) % frames, and the slot after the most recently  */
+	/*   completed frame is being filled (and was just cleared) */
+	/*   so it can't be used.                                  */
+	do {
+		vrSleep(1000);
+		done = 1;
+		for (proc = 0; proc < num_procs; proc++) {
+			long	latest = procs[proc]->frame_count;
+
+			stats = procs[proc]->stats;
+			vrMemoryBarrier();
+
+			if (next_frame[proc] <= latest - (stats->frames - 2)) {
+				dropped[proc] += (latest - (stats->frames - 2)) - next_frame[proc] + 1;
+				next_frame[proc] = latest - (stats->frames - 2) + 1;
+			}
+
+			for (; next_frame[proc] <= latest && num_samples[proc] < frames; next_frame[proc]++) {
+				int	slot = (next_frame[proc] - 1) % stats->frames;
+				double	*sample = &samples[proc][MAX_PHASES * num_samples[proc]];
+				double	total = 0.0;
+
+				for (count = 0; count < stats->elements && count < MAX_PHASES - VR_MAXSTATSVALUES - 1; count++) {
+					sample[count] = stats->measures[stats->elements * slot + count] * 1000.0;
+					total += sample[count];
+				}
+				sample[MAX_PHASES - VR_MAXSTATSVALUES - 1] = total;
+				for (count = 0; count < VR_MAXSTATSVALUES; count++)
+					sample[MAX_PHASES - VR_MAXSTATSVALUES + count] = stats->values[VR_MAXSTATSVALUES * slot + count];
+				num_samples[proc]++;
+			}
+
+			if (num_samples[proc] < frames)
+				done = 0;
+		}
+	} while (!done && vrContext->status == VRSTATUS_RUNNING);
+
+	/* the number of eyes rendered in each frame of a visren process */
+	total_frames = 0;
+	for (proc = 0; proc < num_procs; proc++)
+		total_frames += procs[proc]->frame_count;
+	eyes_per_frame = (total_frames > 0 ? (double)*eye_renders / total_frames : 0.0);
+
+	/**************************/
+	/* report it all as JSON */
+	if (json_file != NULL) {
+		fp = fopen(json_file, "w");
+		if (fp == NULL) {
+			vrErrPrintf(RED_TEXT "framebench: unable to open '%s' -- using stdout.\n" NORM_TEXT, json_file);
+			fp = stdout;
+		}
+	}
+
+	fprintf(fp, "{\n");
+	fprintf(fp, "  \"benchmark\": \"framebench\",\n");
+	fprintf(fp, "  \"frames\": %d,\n", frames);
+	fprintf(fp, "  \"warmup\": %d,\n", warmup);
+	fprintf(fp, "  \"quads_per_eye\": %d,\n", quads);
+	fprintf(fp, "  \"cpu_usecs_per_eye\": %d,\n", cpu_usecs);
+	fprintf(fp, "  \"inputs_per_eye\": %d,\n", inputs);
+	fprintf(fp, "  \"single_pass_stereo\": %s,\n", (stereo ? "true" : "false"));
+	fprintf(fp, "  \"frame_budget_ms\": %.2f,\n", budget);
+	fprintf(fp, "  \"budget_callbacks\": %d,\n", *budget_calls);
+	fprintf(fp, "  \"windows\": %d,\n", vrContext->config->num_windows);
+	fprintf(fp, "  \"visren_procs\": %d,\n", num_procs);
+	fprintf(fp, "  \"eyes_per_frame\": %.2f,\n", eyes_per_frame);
+	fprintf(fp, "  \"procs\": {\n");
+	for (proc = 0; proc < num_procs; proc++) {
+		double	*data = (double *)calloc(frames, sizeof(double));
+		int	num = num_samples[proc];
+		int	phase;
+
+		stats = procs[proc]->stats;
+		fprintf(fp, "    \"%s\": {\n", procs[proc]->name);
+		fprintf(fp, "      \"frames\": %d,\n", num);
+		fprintf(fp, "      \"dropped\": %ld,\n", dropped[proc]);
+		fprintf(fp, "      \"phases_ms\": {\n");
+		for (phase = 0; phase < stats->elements && phase < MAX_PHASES - VR_MAXSTATSVALUES - 1; phase++) {
+			if (stats->elem_labels[phase] == NULL || stats->elem_labels[phase][0] == '\0')
+				continue;
+			for (count = 0; count < num; count++)
+				data[count] = samples[proc][MAX_PHASES * count + phase];
+			print_percentiles(fp, stats->elem_labels[phase], data, num, 0);
+		}
+		for (count = 0; count < num; count++)
+			data[count] = samples[proc][MAX_PHASES * count + MAX_PHASES - VR_MAXSTATSVALUES - 1];
+		print_percentiles(fp, "total", data, num, 1);
+		fprintf(fp, "      },\n");
+
+		fprintf(fp, "      \"values\": {\n");
+		for (phase = VR_MAXSTATSVALUES-1; phase >= 0 && stats->value_labels[phase] == NULL; phase--)
+			;
+		for (count = 0; count <= phase; count++) {
+			int	frame;
+
+			if (stats->value_labels[count] == NULL)
+				continue;
+			for (frame = 0; frame < num; frame++)
+				data[frame] = samples[proc][MAX_PHASES * frame + MAX_PHASES - VR_MAXSTATSVALUES + count];
+			print_percentiles(fp, stats->value_labels[count], data, num, (count == phase));
+		}
+		fprintf(fp, "      }\n");
+		fprintf(fp, "    }%s\n", (proc < num_procs-1 ? "," : ""));
+		free(data);
+	}
+	fprintf(fp, "  }\n");
+	fprintf(fp, "}\n");
+	if (fp != stdout)
+		fclose(fp);
+
+	vrExit();
+
+	return 0;
+}
@@ -0,0 +1,271 @@
+/* ======================================================================
+ *
+ *  CCCCC          inputbench.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for a microbenchmark of the ways of finding an input by name:
+ *   - a linear search of the input names (as done by vrObjectSearch())
+ *   - the strncmp() chain of vrInputGetFromMapname() (without the hash)
+ *   - the hash table lookup of vrInputLookupName()
+ *   - resolving a handle once, and then using it directly.
+ *
+ * As a lookup is only half of reading an input, the last tests time
+ *   reading a valuator with vrGetValuatorValueDirect() -- after each way
+ *   of finding it -- which is what the frame loop of an application pays.
+ *
+ * The inputs are not attached to any devices -- this only exercises the
+ *   lookups, so no configuration or FreeVR processes are needed.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+/*************************************************************************
+
+USAGE:
+	inputbench [-n <num inputs>] [-l <lookups>]
+
+	The inputs are split as 40% 2-switches, 40% valuators and 20%
+	6-sensors.  The default is 500 inputs and 1000000 lookups per test.
+
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+
+#include "freevr.h"
+#include "vr_config.h"
+
+
+/* step through the inputs in a scattered (but repeatable) order */
+#define PICK(count, num)	((int)(((unsigned long)(count) * 7919) % (num)))
+
+/*********************************************************************/
+static double wall_time()
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+
+/*********************************************************************/
+/* make_inputs(): fill in the given type of input in the input map, */
+/*   with names that look like those of a configuration file.       */
+static void **make_inputs(vrInputType type, char *prefix, int num, size_t container_size, vrInput **objects, int *num_objects)
+{
+	void		**inputs;
+	vrGenericInput	*input;
+	char		name[128];
+	int		count;
+
+	inputs = (void **)calloc(num, sizeof(void *));
+	for (count = 0; count < num; count++) {
+		input = (vrGenericInput *)calloc(1, container_size);
+		input->object_type = VROBJECT_INPUTDATA;
+		input->input_type = type;
+		input->lock = vrLockCreateName(vrContext, "bench input");
+
+		sprintf(name, "%s[input%03d]", prefix, count);
+		objects[*num_objects] = (vrInput *)calloc(1, sizeof(vrInput));
+		objects[*num_objects]->name = strdup(name);
+		objects[*num_objects]->container.generic = input;
+		input->my_object = objects[*num_objects];
+		(*num_objects)++;
+
+		inputs[count] = input;
+	}
+
+	return inputs;
+}
+
+
+/*********************************************************************/
+static void report(char *test, double start, double end, int lookups, int found)
+{
+	printf("  %-40s %10.1f ns/lookup  (%d found)\n", test, (end - start) * 1.0e9 / lookups, found);
+}
+
+
+/*********************************************************************/
+int main(int argc, char* argv[])
+{
+	vrInputInfo	*inputs;
+	vrInput		**objects;
+	int		num_objects = 0;
+	int		num_inputs = 500;
+	int		lookups = 1000000;
+	char		**names;		/* the configured names */
+	char		**mapnames;		/* the indexed names */
+	vrValuator	**handles;
+	float		sum;
+	double		start;
+	double		end;
+	int		found;
+	int		count;
+	int		which;
+
+	for (count = 1; count < argc; count++) {
+		if (!strcmp(argv[count], "-n") && count+1 < argc)
+			num_inputs = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-l") && count+1 < argc)
+			lookups = atoi(argv[++count]);
+		else {
+			printf("usage: %s [-n <num inputs>] [-l <lookups>]\n", argv[0]);
+			exit(1);
+		}
+	}
+	if (num_inputs < 5)
+		num_inputs = 5;
+
+	/***********************************************************/
+	/* a minimal context, with all the debug output turned off */
+	vrShmemInit(4 * 1024 * 1024 + num_inputs * 1024);
+	vrContext = (vrContextInfo *)calloc(1, sizeof(vrContextInfo));
+	vrContext->config = (vrConfigInfo *)calloc(1, sizeof(vrConfigInfo));
+	vrContext->config->defaults.debug_level = 0;
+	vrContext->head_lock = vrLockCreateName(vrContext, "lock list");
+	vrContext->tail_lock = vrContext->head_lock;
+
+	inputs = (vrInputInfo *)calloc(1, sizeof(vrInputInfo));
+	vrContext->input = inputs;
+
+	objects = (vrInput **)calloc(num_inputs, sizeof(vrInput *));
+	inputs->num_2ways = num_inputs * 2 / 5;
+	inputs->num_valuators = num_inputs * 2 / 5;
+	inputs->num_6sensors = num_inputs - inputs->num_2ways - inputs->num_valuators;
+	inputs->switch2 = (vr2switch **)make_inputs(VRINPUT_BINARY, "2switch", inputs->num_2ways, sizeof(vr2switch), objects, &num_objects);
+	inputs->valuator = (vrValuator **)make_inputs(VRINPUT_VALUATOR, "valuator", inputs->num_valuators, sizeof(vrValuator), objects, &num_objects);
+	inputs->sensor6 = (vr6sensor **)make_inputs(VRINPUT_6SENSOR, "6sensor", inputs->num_6sensors, sizeof(vr6sensor), objects, &num_objects);
+
+	/* the names to look up -- spread over all the inputs */
+	names = (char **)calloc(num_objects, sizeof(char *));
+	mapnames = (char **)calloc(num_objects, sizeof(char *));
+	for (count = 0; count < num_objects; count++) {
+		names[count] = objects[count]->name;
+		mapnames[count] = (char *)malloc(64);
+		if (count < inputs->num_2ways)
+			sprintf(mapnames[count], "2switch[%d]", count);
+		else if (count < inputs->num_2ways + inputs->num_valuators)
+			sprintf(mapnames[count], "valuator[%d]", count - inputs->num_2ways);
+		else	sprintf(mapnames[count], "6sensor[%d]", count - inputs->num_2ways - inputs->num_valuators);
+	}
+
+	printf("Input lookup benchmark: %d inputs, %d lookups per test\n", num_objects, lookups);
+
+	/**************************************************/
+	/* linear search of the names (ala vrObjectSearch) */
+	found = 0;
+	start = wall_time();
+	for (count = 0; count < lookups; count++) {
+		char	*name = names[PICK(count, num_objects)];
+
+		for (which = 0; which < num_objects; which++) {
+			if (!strcasecmp(name, objects[which]->name)) {
+				found++;
+				break;
+			}
+		}
+	}
+	end = wall_time();
+	report("linear name search", start, end, lookups, found);
+
+	/**********************************************/
+	/* the strncmp() chain (before the hash table) */
+	found = 0;
+	start = wall_time();
+	for (count = 0; count < lookups; count++) {
+		if (vrInputGetFromMapname(vrContext, mapnames[PICK(count, num_objects)]) != NULL)
+			found++;
+	}
+	end = wall_time();
+	report("vrInputGetFromMapname() w/o hash", start, end, lookups, found);
+
+	/* ... and reading the valuator so found */
+	found = 0;
+	sum = 0.0;
+	start = wall_time();
+	for (count = 0; count < lookups; count++) {
+		vrValuator	*input = (vrValuator *)vrInputGetFromMapname(vrContext, mapnames[inputs->num_2ways + PICK(count, inputs->num_valuators)]);
+
+		if (input != NULL) {
+			sum += vrGetValuatorValueDirect(input);
+			found++;
+		}
+	}
+	end = wall_time();
+	report("w/o hash + vrGetValuatorValueDirect()", start, end, lookups, found);
+
+	/*******************/
+	/* make the hashes */
+	start = wall_time();
+	vrInputHashNames(inputs);
+	end = wall_time();
+	printf("  %-40s %10.1f us\n", "vrInputHashNames()", (end - start) * 1.0e6);
+
+	/************************************/
+	/* the hash table, configured names */
+	found = 0;
+	start = wall_time();
+	for (count = 0; count < lookups; count++) {
+		if (vrInputLookupName(inputs, names[PICK(count, num_objects)]) != NULL)
+			found++;
+	}
+	end = wall_time();
+	report("vrInputLookupName() of names", start, end, lookups, found);
+
+	/***********************************/
+	/* the hash table, indexed names   */
+	found = 0;
+	start = wall_time();
+	for (count = 0; count < lookups; count++) {
+		if (vrInputGetFromMapname(vrContext, mapnames[PICK(count, num_objects)]) != NULL)
+			found++;
+	}
+	end = wall_time();
+	report("vrInputGetFromMapname() w/ hash", start, end, lookups, found);
+
+	/* ... and reading the valuator so found */
+	found = 0;
+	start = wall_time();
+	for (count = 0; count < lookups; count++) {
+		vrValuator	*input = (vrValuator *)vrInputGetFromMapname(vrContext, mapnames[inputs->num_2ways + PICK(count, inputs->num_valuators)]);
+
+		if (input != NULL) {
+			sum += vrGetValuatorValueDirect(input);
+			found++;
+		}
+	}
+	end = wall_time();
+	report("w/ hash + vrGetValuatorValueDirect()", start, end, lookups, found);
+
+	/****************************************************/
+	/* handles: resolve once, then read with the handle */
+	handles = (vrValuator **)calloc(inputs->num_valuators, sizeof(vrValuator *));
+	for (count = 0; count < inputs->num_valuators; count++)
+		handles[count] = vrGetValuatorHandle(names[inputs->num_2ways + count]);
+
+	found = 0;
+	start = wall_time();
+	for (count = 0; count < lookups; count++) {
+		vrValuator	*input = handles[PICK(count, inputs->num_valuators)];
+
+		if (input != NULL) {
+			sum += vrGetValuatorValueDirect(input);
+			found++;
+		}
+	}
+	end = wall_time();
+	report("handle + vrGetValuatorValueDirect()", start, end, lookups, found);
+
+	/* (the sum keeps the reads from being optimized away) */
+	if (sum != 0.0)
+		printf("  (sum of the values read: %g)\n", sum);
+
+	return 0;
+}
@@ -0,0 +1,390 @@
+/* ======================================================================
+ *
+ *  CCCCC          pagedgen.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for a generator of a synthetic paged (PagedLOD) terrain, for
+ *   testing the OpenSceneGraph database pager integration of the GLX
+ *   visual rendering (see vrOSGSetDatabasePager() & vrOSGSetPagerBudget())
+ *   without needing a real terrain database.
+ *
+ * The terrain is a quadtree of square tiles, written in the ASCII ".osg"
+ *   format, so this program itself doesn't need OSG.  Each tile is a
+ *   height-field grid with its own (generated) texture image, and all
+ *   but the finest tiles are PagedLOD nodes whose four children are
+ *   paged in from a separate file when the viewer comes close.  So the
+ *   pager always has textures & geometry to compile, and tiles to merge.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+/*************************************************************************
+
+USAGE:
+	pagedgen [-d <depth>] [-g <grid>] [-s <size>] [-t <texture size>]
+		[-r <range factor>] [-o <directory>]
+
+	-d -- the number of levels of the quadtree (default 4, which makes
+		85 tiles in 22 files)
+	-g -- the number of grid cells along each side of a tile (default 32)
+	-s -- the length (in feet) of each side of the whole terrain (default 1000)
+	-t -- the width & height of each tile's texture image (default 256,
+		0 for no textures)
+	-r -- a tile's children are paged in within this many of the tile's
+		radii of the eye (default 3.0)
+	-o -- the directory to write the files to (default "paged")
+
+	The top of the tree is written to "<directory>/root.osg", which is
+	the file to give to osgDB::readNodeFile().  The terrain is centered
+	on the origin, in the X-Z plane, with heights along +Y.
+
+	The textures are written as binary PPM images, so OSG's "pnm" image
+	plugin is needed to read them.
+
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+
+/* the settings of this run */
+static	int		depth = 4;
+static	int		grid = 32;
+static	double		size = 1000.0;
+static	int		tex_size = 256;
+static	double		range_factor = 3.0;
+static	char		*directory = "paged";
+
+/* the totals of what was written */
+static	int		total_tiles = 0;
+static	int		total_files = 0;
+static	long		total_vertices = 0;
+
+
+/*********************************************************************/
+/* terrain_height(): the height of the (synthetic) terrain at a spot */
+/*   -- a couple of layers of rolling hills.                         */
+static double terrain_height(double x, double z)
+{
+	return	size * 0.02 * sin(x * 6.0 / size) * cos(z * 8.0 / size)
+		+ size * 0.005 * sin(x * 31.0 / size + z * 23.0 / size);
+}
+
+
+/*********************************************************************/
+/* tile_bounds(): the region of the terrain covered by a tile */
+static void tile_bounds(int level, int tx, int tz, double *x0, double *z0, double *width)
+{
+	*width = size / (double)(1 << level);
+	*x0 = -size / 2.0 + tx * *width;
+	*z0 = -size / 2.0 + tz * *width;
+}
+
+
+/*********************************************************************/
+static void indent(FILE *file, int level)
+{
+	int	count;
+
+	for (count = 0; count < level; count++)
+		fputs("  ", file);
+}
+
+
+/*********************************************************************/
+/* write_texture(): write a tile's texture image -- a height-shaded  */
+/*   color with a tint for each level, and a border, so the level of */
+/*   each tile in view can be seen.                                  */
+static void write_texture(char *filename, int level, int tx, int tz)
+{
+	FILE		*file;
+	unsigned char	*row;
+	double		x0, z0, width;
+	double		height;
+	int		count, count2;
+
+	if ((file = fopen(filename, "wb")) == NULL) {
+		fprintf(stderr, "pagedgen: unable to write '%s' -- %s.\n", filename, strerror(errno));
+		exit(1);
+	}
+
+	tile_bounds(level, tx, tz, &x0, &z0, &width);
+	row = (unsigned char *)malloc(tex_size * 3);
+
+	fprintf(file, "P6\n%d %d\n255\n", tex_size, tex_size);
+	for (count = tex_size-1; count >= 0; count--) {
+		for (count2 = 0; count2 < tex_size; count2++) {
+			height = terrain_height(x0 + width * (count2 + 0.5) / tex_size, z0 + width * (count + 0.5) / tex_size);
+			height = 0.5 + height / (size * 0.05);
+			if (height < 0.0) height = 0.0;
+			if (height > 1.0) height = 1.0;
+
+			if (count == 0 || count2 == 0 || count == tex_size-1 || count2 == tex_size-1) {
+				row[count2*3+0] = 255;
+				row[count2*3+1] = 255;
+				row[count2*3+2] = 255;
+			} else {
+				row[count2*3+0] = (unsigned char)(height * 160.0 + (level & 0x01 ? 80 : 0));
+				row[count2*3+1] = (unsigned char)(height * 200.0 + (level & 0x02 ? 40 : 0));
+				row[count2*3+2] = (unsigned char)(height * 120.0 + (level & 0x04 ? 120 : 0));
+			}
+		}
+		fwrite(row, 3, tex_size, file);
+	}
+
+	free(row);
+	fclose(file);
+}
+
+
+/*********************************************************************/
+/* write_geode(): write the geometry (and texture state) of one tile */
+static void write_geode(FILE *file, int level, int tx, int tz, int ind)
+{
+	char		texname[256];
+	double		x0, z0, width;
+	double		x, z, step;
+	double		nx, ny, nz, len;
+	int		verts = (grid+1) * (grid+1);
+	int		count, count2;
+
+	tile_bounds(level, tx, tz, &x0, &z0, &width);
+	step = width / grid;
+
+	indent(file, ind);   fprintf(file, "Geode {\n");
+	indent(file, ind+1); fprintf(file, "DataVariance STATIC\n");
+	indent(file, ind+1); fprintf(file, "name \"tile %d %d %d\"\n", level, tx, tz);
+	indent(file, ind+1); fprintf(file, "num_drawables 1\n");
+	indent(file, ind+1); fprintf(file, "Geometry {\n");
+	indent(file, ind+2); fprintf(file, "DataVariance STATIC\n");
+
+	if (tex_size > 0) {
+		sprintf(texname, "t%d_%d_%d.ppm", level, tx, tz);
+		indent(file, ind+2); fprintf(file, "StateSet {\n");
+		indent(file, ind+3); fprintf(file, "DataVariance STATIC\n");
+		indent(file, ind+3); fprintf(file, "rendering_hint DEFAULT_BIN\n");
+		indent(file, ind+3); fprintf(file, "renderBinMode INHERIT\n");
+		indent(file, ind+3); fprintf(file, "textureUnit 0 {\n");
+		indent(file, ind+4); fprintf(file, "GL_TEXTURE_2D ON\n");
+		indent(file, ind+4); fprintf(file, "Texture2D {\n");
+		indent(file, ind+5); fprintf(file, "file \"%s\"\n", texname);
+		indent(file, ind+5); fprintf(file, "wrap_s CLAMP_TO_EDGE\n");
+		indent(file, ind+5); fprintf(file, "wrap_t CLAMP_TO_EDGE\n");
+		indent(file, ind+5); fprintf(file, "min_filter LINEAR_MIPMAP_LINEAR\n");
+		indent(file, ind+5); fprintf(file, "mag_filter LINEAR\n");
+		indent(file, ind+4); fprintf(file, "}\n");
+		indent(file, ind+3); fprintf(file, "}\n");
+		indent(file, ind+2); fprintf(file, "}\n");
+	}
+
+	indent(file, ind+2); fprintf(file, "useDisplayList FALSE\n");
+	indent(file, ind+2); fprintf(file, "useVertexBufferObjects TRUE\n");
+
+	/* two triangles per grid cell */
+	indent(file, ind+2); fprintf(file, "PrimitiveSets 1\n");
+	indent(file, ind+2); fprintf(file, "{\n");
+	indent(file, ind+3); fprintf(file, "DrawElementsUShort TRIANGLES %d\n", grid * grid * 6);
+	indent(file, ind+3); fprintf(file, "{\n");
+	for (count = 0; count < grid; count++) {
+		for (count2 = 0; count2 < grid; count2++) {
+			int	v = count * (grid+1) + count2;
+
+			indent(file, ind+4);
+			fprintf(file, "%d %d %d %d %d %d\n", v, v + grid+1, v + 1, v + 1, v + grid+1, v + grid+2);
+		}
+	}
+	indent(file, ind+3); fprintf(file, "}\n");
+	indent(file, ind+2); fprintf(file, "}\n");
+
+	indent(file, ind+2); fprintf(file, "VertexArray Vec3Array %d\n", verts);
+	indent(file, ind+2); fprintf(file, "{\n");
+	for (count = 0; count <= grid; count++) {
+		for (count2 = 0; count2 <= grid; count2++) {
+			x = x0 + count2 * step;
+			z = z0 + count * step;
+			indent(file, ind+3);
+			fprintf(file, "%g %g %g\n", x, terrain_height(x, z), z);
+		}
+	}
+	indent(file, ind+2); fprintf(file, "}\n");
+
+	/* normals from the slope of the height field */
+	indent(file, ind+2); fprintf(file, "NormalBinding PER_VERTEX\n");
+	indent(file, ind+2); fprintf(file, "NormalArray Vec3Array %d\n", verts);
+	indent(file, ind+2); fprintf(file, "{\n");
+	for (count = 0; count <= grid; count++) {
+		for (count2 = 0; count2 <= grid; count2++) {
+			x = x0 + count2 * step;
+			z = z0 + count * step;
+			nx = terrain_height(x - step, z) - terrain_height(x + step, z);
+			nz = terrain_height(x, z - step) - terrain_height(x, z + step);
+			ny = 2.0 * step;
+			len = sqrt(nx*nx + ny*ny + nz*nz);
+			indent(file, ind+3);
+			fprintf(file, "%g %g %g\n", nx / len, ny / len, nz / len);
+		}
+	}
+	indent(file, ind+2); fprintf(file, "}\n");
+
+	if (tex_size > 0) {
+		/* NOTE: the rows of the image were written from the top (far Z) down */
+		indent(file, ind+2); fprintf(file, "TexCoordArray 0 Vec2Array %d\n", verts);
+		indent(file, ind+2); fprintf(file, "{\n");
+		for (count = 0; count <= grid; count++) {
+			for (count2 = 0; count2 <= grid; count2++) {
+				indent(file, ind+3);
+				fprintf(file, "%g %g\n", (double)count2 / grid, (double)count / grid);
+			}
+		}
+		indent(file, ind+2); fprintf(file, "}\n");
+	}
+
+	indent(file, ind+1); fprintf(file, "}\n");
+	indent(file, ind);   fprintf(file, "}\n");
+
+	total_tiles++;
+	total_vertices += verts;
+}
+
+
+static void write_children_file(int level, int tx, int tz);
+
+/*********************************************************************/
+/* write_tile(): write one tile into the current file -- as a plain  */
+/*   Geode at the finest level, else as a PagedLOD whose children    */
+/*   (the four tiles of the next level) are in a file of their own.  */
+static void write_tile(FILE *file, int level, int tx, int tz, int ind)
+{
+	char		filename[256];
+	double		x0, z0, width;
+	double		radius;
+
+	if (tex_size > 0) {
+		sprintf(filename, "%s/t%d_%d_%d.ppm", directory, level, tx, tz);
+		write_texture(filename, level, tx, tz);
+	}
+
+	if (level == depth-1) {
+		write_geode(file, level, tx, tz, ind);
+		return;
+	}
+
+	tile_bounds(level, tx, tz, &x0, &z0, &width);
+	radius = width * 0.75;		/* a bit more than half the diagonal, to include the hills */
+
+	indent(file, ind);   fprintf(file, "PagedLOD {\n");
+	indent(file, ind+1); fprintf(file, "DataVariance STATIC\n");
+	indent(file, ind+1); fprintf(file, "Center %g %g %g\n", x0 + width/2.0, terrain_height(x0 + width/2.0, z0 + width/2.0), z0 + width/2.0);
+	indent(file, ind+1); fprintf(file, "Radius %g\n", radius);
+	indent(file, ind+1); fprintf(file, "RangeMode DISTANCE_FROM_EYE_POINT\n");
+	indent(file, ind+1); fprintf(file, "RangeList 2 {\n");
+	indent(file, ind+2); fprintf(file, "%g 1e+30\n", radius * range_factor);
+	indent(file, ind+2); fprintf(file, "0 %g\n", radius * range_factor);
+	indent(file, ind+1); fprintf(file, "}\n");
+	indent(file, ind+1); fprintf(file, "NumChildrenThatCannotBeExpired 1\n");
+	indent(file, ind+1); fprintf(file, "RangeDataList 2 {\n");
+	indent(file, ind+2); fprintf(file, "\"\"\n");
+	indent(file, ind+2); fprintf(file, "\"t%d_%d_%d.osg\"\n", level, tx, tz);
+	indent(file, ind+1); fprintf(file, "}\n");
+	indent(file, ind+1); fprintf(file, "num_children 1\n");
+	write_geode(file, level, tx, tz, ind+1);
+	indent(file, ind);   fprintf(file, "}\n");
+
+	write_children_file(level, tx, tz);
+}
+
+
+/*********************************************************************/
+/* write_children_file(): write the file paged in for a tile -- a    */
+/*   Group of the tile's four children.                              */
+static void write_children_file(int level, int tx, int tz)
+{
+	char		filename[256];
+	FILE		*file;
+
+	sprintf(filename, "%s/t%d_%d_%d.osg", directory, level, tx, tz);
+	if ((file = fopen(filename, "w")) == NULL) {
+		fprintf(stderr, "pagedgen: unable to write '%s' -- %s.\n", filename, strerror(errno));
+		exit(1);
+	}
+	total_files++;
+
+	fprintf(file, "Group {\n");
+	fprintf(file, "  DataVariance STATIC\n");
+	fprintf(file, "  num_children 4\n");
+	write_tile(file, level+1, tx*2,   tz*2,   1);
+	write_tile(file, level+1, tx*2+1, tz*2,   1);
+	write_tile(file, level+1, tx*2,   tz*2+1, 1);
+	write_tile(file, level+1, tx*2+1, tz*2+1, 1);
+	fprintf(file, "}\n");
+
+	fclose(file);
+}
+
+
+/*********************************************************************/
+int main(int argc, char* argv[])
+{
+	char		filename[256];
+	FILE		*file;
+	int		count;
+
+	for (count = 1; count < argc; count++) {
+		if (!strcmp(argv[count], "-d") && count+1 < argc)
+			depth = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-g") && count+1 < argc)
+			grid = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-s") && count+1 < argc)
+			size = atof(argv[++count]);
+		else if (!strcmp(argv[count], "-t") && count+1 < argc)
+			tex_size = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-r") && count+1 < argc)
+			range_factor = atof(argv[++count]);
+		else if (!strcmp(argv[count], "-o") && count+1 < argc)
+			directory = argv[++count];
+		else {
+			printf("usage: %s [-d <depth>] [-g <grid>] [-s <size>] [-t <texture size>] [-r <range factor>] [-o <directory>]\n", argv[0]);
+			exit(1);
+		}
+	}
+
+	/* keep the values within what the tiles can hold */
+	if (depth < 1)
+		depth = 1;
+	if (depth > 10)
+		depth = 10;
+	if (grid < 1)
+		grid = 1;
+	if (grid > 254)			/* the indices are unsigned shorts */
+		grid = 254;
+	if (tex_size < 0)
+		tex_size = 0;
+	if (size <= 0.0)
+		size = 1000.0;
+
+	if (mkdir(directory, 0755) < 0 && errno != EEXIST) {
+		fprintf(stderr, "pagedgen: unable to make the directory '%s' -- %s.\n", directory, strerror(errno));
+		exit(1);
+	}
+
+	sprintf(filename, "%s/root.osg", directory);
+	if ((file = fopen(filename, "w")) == NULL) {
+		fprintf(stderr, "pagedgen: unable to write '%s' -- %s.\n", filename, strerror(errno));
+		exit(1);
+	}
+	total_files++;
+	write_tile(file, 0, 0, 0, 0);
+	fclose(file);
+
+	printf("pagedgen: wrote %d tiles (%ld vertices) in %d files to '%s' -- load '%s'.\n",
+		total_tiles, total_vertices, total_files, directory, filename);
+
+	return 0;
+}
@@ -0,0 +1,316 @@
+/* ======================================================================
+ *
+ *  CCCCC          travelbench.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for a microbenchmark of the two ways of changing the travel
+ *   of the users each frame:
+ *   - a call of the travel functions (vrUserTravelRotateId(), etc.)
+ *     for each operation, each of which locks the user's data
+ *   - a travel batch (vrUserTravelBatch*()), which accumulates the
+ *     operations without a lock, and commits them with one.
+ *
+ * Each is run through the same navigation patterns, for each user, and
+ *   the travel that results from the two (both its rw2vw and vw2rw
+ *   transforms) is compared.  Optionally, a second thread reads the
+ *   travel of the users meanwhile (as other threads of an application,
+ *   or the publishing of the travel do), to give the locks some
+ *   contention.
+ *
+ * The users are not attached to any inputs -- this only exercises the
+ *   travel, so no configuration or FreeVR processes are needed.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+/*************************************************************************
+
+USAGE:
+	travelbench [-u <num users>] [-f <frames>] [-c]
+
+	The default is 4 users and 200000 frames per test.  With "-c",
+	a thread reads the users' travel (with vrMatrixGetUserTravel())
+	throughout the tests.
+
+	The navigation patterns are:
+		walk -- turn and move forward (as the "travel" example does)
+		fly -- turn, pitch and move forward
+		grab -- move the world by a grab matrix, and scale it
+		all -- each of the above, and a reset every 1000 frames
+			(but not in the last 1000, so the results compared
+			are of many frames of travel)
+
+	Only the navigation is timed -- the travel is still published
+	each frame (as vrFrame() does), but outside the timing.
+
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "freevr.h"
+#include "vr_config.h"
+
+
+/* the navigation patterns */
+#define	NAV_WALK	0x01
+#define	NAV_FLY		0x02
+#define	NAV_GRAB	0x04
+#define	NAV_RESET	0x08
+#define	NAV_ALL		(NAV_WALK | NAV_FLY | NAV_GRAB | NAV_RESET)
+
+static	volatile int	reader_done = 0;
+static	long		reader_reads = 0;
+static	long		frames_last_reset = 0;	/* no resets from here on, so the last 1000+ frames are compared */
+
+
+/*********************************************************************/
+static double wall_time()
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+
+/*********************************************************************/
+/* reader_thread(): read the travel of each user, until the tests are done */
+static void *reader_thread(void *arg)
+{
+	vrMatrix	mat;
+	int		num_users = *(int *)arg;
+
+	while (!reader_done) {
+		vrMatrixGetUserTravel(&mat, (int)(reader_reads % num_users));
+		reader_reads++;
+	}
+
+	return NULL;
+}
+
+
+/*********************************************************************/
+/* the motion of a frame of navigation -- it varies, but repeatably */
+static void frame_motion(long frame, int user, double *yaw, double *pitch, vrVector *forward, vrMatrix *grab, double *scale)
+{
+	double		phase = (double)frame * 0.001 + user;
+
+	*yaw = 0.5 * sin(phase);
+	*pitch = 0.25 * cos(phase * 1.3);
+	forward->v[VR_X] = 0.01 * sin(phase * 0.7);
+	forward->v[VR_Y] = 0.0;
+	forward->v[VR_Z] = -0.05;
+	vrMatrixSetTranslation3d(grab, 0.02 * cos(phase), 0.01, 0.02 * sin(phase));
+	vrMatrixPreRotateId(grab, VR_Y, 0.1 * sin(phase * 0.3));
+	*scale = 1.0 + 0.001 * sin(phase * 2.0);
+}
+
+
+/*********************************************************************/
+/* the travel functions -- each operation locks the user's data */
+static void nav_direct(int patterns, long frame, int user)
+{
+	double		yaw, pitch, scale;
+	vrVector	forward;
+	vrMatrix	grab;
+
+	frame_motion(frame, user, &yaw, &pitch, &forward, &grab, &scale);
+
+	if (patterns & NAV_RESET && frame % 1000 == 999 && frame < frames_last_reset)
+		vrUserTravelReset(user);
+	if (patterns & NAV_WALK) {
+		vrUserTravelRotateId(user, VR_Y, yaw);
+		vrUserTravelTranslateVec(user, &forward);
+	}
+	if (patterns & NAV_FLY) {
+		vrUserTravelRotateId(user, VR_Y, yaw);
+		vrUserTravelRotateId(user, VR_X, pitch);
+		vrUserTravelTranslateVec(user, &forward);
+	}
+	if (patterns & NAV_GRAB) {
+		vrUserTravelTransformMatrix(user, &grab);
+		vrUserTravelScale(user, scale);
+	}
+}
+
+
+/*********************************************************************/
+/* a travel batch -- the operations are committed with one lock */
+static void nav_batch(int patterns, long frame, int user)
+{
+	double		yaw, pitch, scale;
+	vrVector	forward;
+	vrMatrix	grab;
+	vrUserTravelBatch batch;
+
+	frame_motion(frame, user, &yaw, &pitch, &forward, &grab, &scale);
+
+	vrUserTravelBatchBegin(&batch, user);
+	if (patterns & NAV_RESET && frame % 1000 == 999 && frame < frames_last_reset)
+		vrUserTravelBatchReset(&batch);
+	if (patterns & NAV_WALK) {
+		vrUserTravelBatchRotateId(&batch, VR_Y, yaw);
+		vrUserTravelBatchTranslateVec(&batch, &forward);
+	}
+	if (patterns & NAV_FLY) {
+		vrUserTravelBatchRotateId(&batch, VR_Y, yaw);
+		vrUserTravelBatchRotateId(&batch, VR_X, pitch);
+		vrUserTravelBatchTranslateVec(&batch, &forward);
+	}
+	if (patterns & NAV_GRAB) {
+		vrUserTravelBatchTransformMatrix(&batch, &grab);
+		vrUserTravelBatchScale(&batch, scale);
+	}
+	vrUserTravelBatchCommit(&batch);
+}
+
+
+/*********************************************************************/
+/* run(): navigate all the users for the given frames, publishing the */
+/*   travel each frame (as vrFrame() does), and return the time taken  */
+/*   by the navigation alone.                                          */
+static double run(void (*nav)(int, long, int), int patterns, long frames, int num_users)
+{
+	double		start;
+	double		nav_time = 0.0;
+	long		frame;
+	int		user;
+
+	vrUserTravelReset(VR_ALLUSERS);
+
+	for (frame = 0; frame < frames; frame++) {
+		start = wall_time();
+		for (user = 0; user < num_users; user++)
+			nav(patterns, frame, user);
+		nav_time += wall_time() - start;
+
+		vrUserTravelPublish(vrContext);
+	}
+
+	return nav_time;
+}
+
+
+/*********************************************************************/
+/* difference(): the largest difference between the travel of the */
+/*   users and the given copies of it -- of both the rw2vw and    */
+/*   vw2rw transforms, since each is kept separately.             */
+static double difference(vrMatrix *rw2vw_copies, vrMatrix *vw2rw_copies, int num_users)
+{
+	double		diff = 0.0;
+	int		user;
+	int		count;
+
+	for (user = 0; user < num_users; user++) {
+		for (count = 0; count < 16; count++) {
+			if (fabs(vrContext->input->users[user]->rw2vw_xform->v[count] - rw2vw_copies[user].v[count]) > diff)
+				diff = fabs(vrContext->input->users[user]->rw2vw_xform->v[count] - rw2vw_copies[user].v[count]);
+			if (fabs(vrContext->input->users[user]->vw2rw_xform->v[count] - vw2rw_copies[user].v[count]) > diff)
+				diff = fabs(vrContext->input->users[user]->vw2rw_xform->v[count] - vw2rw_copies[user].v[count]);
+		}
+	}
+
+	return diff;
+}
+
+
+/*********************************************************************/
+int main(int argc, char* argv[])
+{
+	vrInputInfo	*inputs;
+	vrMatrix	*direct_travel;		/* the rw2vw transforms of the direct run */
+	vrMatrix	*direct_inverse;	/* the vw2rw transforms of the direct run */
+	pthread_t	reader_tid;
+	int		num_users = 4;
+	long		frames = 200000;
+	int		contend = 0;
+	double		direct_time;
+	double		batch_time;
+	int		count;
+	int		test;
+static	struct {
+		char	*name;
+		int	patterns;
+		int	ops;		/* travel operations per frame and user (w/o the reset) */
+	} tests[] = {
+		{ "walk", NAV_WALK, 2 },
+		{ "fly", NAV_FLY, 3 },
+		{ "grab", NAV_GRAB, 2 },
+		{ "all", NAV_ALL, 7 },
+	};
+
+	for (count = 1; count < argc; count++) {
+		if (!strcmp(argv[count], "-u") && count+1 < argc)
+			num_users = atoi(argv[++count]);
+		else if (!strcmp(argv[count], "-f") && count+1 < argc)
+			frames = atol(argv[++count]);
+		else if (!strcmp(argv[count], "-c"))
+			contend = 1;
+		else {
+			printf("usage: %s [-u <num users>] [-f <frames>] [-c]\n", argv[0]);
+			exit(1);
+		}
+	}
+	if (num_users < 1)
+		num_users = 1;
+	frames_last_reset = frames - 1000;
+
+	/***********************************************************/
+	/* a minimal context, with all the debug output turned off */
+	vrShmemInit(4 * 1024 * 1024 + num_users * 4096);
+	vrContext = (vrContextInfo *)calloc(1, sizeof(vrContextInfo));
+	vrContext->config = (vrConfigInfo *)calloc(1, sizeof(vrConfigInfo));
+	vrContext->config->defaults.debug_level = 0;
+	vrContext->head_lock = vrLockCreateName(vrContext, "lock list");
+	vrContext->tail_lock = vrContext->head_lock;
+
+	inputs = (vrInputInfo *)calloc(1, sizeof(vrInputInfo));
+	vrContext->input = inputs;
+	inputs->publish_lock = vrLockCreateName(vrContext, "travel publish");
+	inputs->num_users = num_users;
+	inputs->users = (vrUserInfo **)calloc(num_users, sizeof(vrUserInfo *));
+	for (count = 0; count < num_users; count++) {
+		inputs->users[count] = (vrUserInfo *)vrShmemAlloc0(sizeof(vrUserInfo));
+		vrUserClear(inputs->users[count]);
+	}
+	direct_travel = (vrMatrix *)calloc(num_users, sizeof(vrMatrix));
+	direct_inverse = (vrMatrix *)calloc(num_users, sizeof(vrMatrix));
+
+	if (contend)
+		pthread_create(&reader_tid, NULL, reader_thread, &num_users);
+
+	printf("Travel benchmark: %d users, %ld frames per test%s\n", num_users, frames, (contend ? ", with a reading thread" : ""));
+	printf("  %-8s %14s %14s %9s %12s\n", "pattern", "direct", "batch", "speedup", "difference");
+
+	for (test = 0; test < sizeof(tests) / sizeof(tests[0]); test++) {
+		direct_time = run(nav_direct, tests[test].patterns, frames, num_users);
+		for (count = 0; count < num_users; count++) {
+			direct_travel[count] = *(inputs->users[count]->rw2vw_xform);
+			direct_inverse[count] = *(inputs->users[count]->vw2rw_xform);
+		}
+
+		batch_time = run(nav_batch, tests[test].patterns, frames, num_users);
+
+		printf("  %-8s %8.1f ns/op %8.1f ns/op %8.2fx %12.3g\n",
+			tests[test].name,
+			direct_time * 1.0e9 / ((double)frames * num_users * tests[test].ops),
+			batch_time * 1.0e9 / ((double)frames * num_users * tests[test].ops),
+			direct_time / batch_time,
+			difference(direct_travel, direct_inverse, num_users));
+	}
+
+	if (contend) {
+		reader_done = 1;
+		pthread_join(reader_tid, NULL);
+		printf("  (the reading thread read the travel %ld times)\n", reader_reads);
+	}
+
+	return 0;
+}
@@ -15,12 +15,25 @@
  *	??? blending enable/function
  * Also, the outline lines will be rendered with current linewidth
  *
+ * When the context supports them (OpenGL 1.5 and later), the shapes are
+ *   drawn from vertex buffer objects that are filled once per context,
+ *   rather than vertex by vertex.  The vertex array state of the caller
+ *   is saved and restored around each shape (or, for the simulator view,
+ *   once around the whole view).
+ *
  * Copyright 2014, Bill Sherman, All rights reserved.
  * With the intent to provide an open-source license to be named later.
  * ====================================================================== */
 #include <GL/gl.h>
+#include <GL/glx.h>		/* for glXGetCurrentContext() */
+#if defined(WIN_EGL)
+#  include <EGL/egl.h>		/* for eglGetCurrentContext() */
+#endif
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 #include "vr_debug.h"
 #include "vr_basicgfx.glx.h"
 #include "vr_input.h"		/* for input sensing functions in vrGLRenderDefaultSimultor() */
@@ -93,10 +106,343 @@ static float pyramid_normals[5][3] = {			/* specifies the normal    */
 	};
 
 
+
+/****************************************************************************/
+/** Retained (vertex buffer object) versions of the shapes                 **/
+/****************************************************************************/
+#if 1 /* compile-time option: set to 0 to always draw the shapes in immediate mode */
+#  define VR_BASICGFX_RETAINED
+#endif
+
+#define	VR_BASICGFX_MAXCONTEXTS	16	/* the number of contexts (per process) that can have shape buffers */
+
+/* The shapes are packed into one array of (x,y,z, nx,ny,nz) vertices.  */
+/*   The faces have their own vertices (for the flat normals), and the  */
+/*   outlines are given the normal that the last face would have left.  */
+#define	SHAPE_CUBE		0	/* 24 vertices: the six faces as GL_QUADS */
+#define	SHAPE_CUBE_OPEN		4	/* 20 vertices: the cube without its front */
+#define	SHAPE_PYRAMID		24	/* 18 vertices: four sides and the (split) bottom as GL_TRIANGLES */
+#define	SHAPE_CUBE_OUTLINE	42	/* 16 vertices: a GL_LINE_STRIP */
+#define	SHAPE_PYRAMID_OUTLINE	58	/* 10 vertices: a GL_LINE_STRIP */
+#define	SHAPE_FLOOR		68	/*  4 vertices: a GL_QUADS */
+#define	SHAPE_VERTICES		72
+
+static int cube_outline_strip[16] = { 0, 1, 2, 3, 0, 7, 6, 1, 2, 5, 6, 7, 4, 3, 4, 5 };
+static int pyramid_outline_strip[10] = { 1, 8, 2, 1, 6, 8, 5, 2, 5, 6 };
+
+/* The buffers of the shapes within one context.  The buffers can only be */
+/*   used by the context that made them (unless its objects are shared),  */
+/*   and a context is only current in one thread at a time, so nothing    */
+/*   but the table lookup needs to be locked.                             */
+typedef struct {
+		void		*context;	/* the GLX or EGL context the buffers belong to */
+		int		status;		/* 1 when the buffers are ready, -1 when they can't be made */
+		int		bound;		/* the depth of nested _GLShapeBind() calls */
+		GLuint		shape_vbo;	/* the vertices of all the shapes */
+		GLuint		outline_vbo;	/* the lines of the window outlines in the simulator view */
+		int		outline_size;	/* the number of floats in outline_vbo */
+		int		outline_alloc;	/* the number of floats allocated for each of the copies */
+		GLfloat		*outline_verts;	/* a copy of what is in outline_vbo */
+		GLfloat		*outline_next;	/* the outlines of the current frame */
+		GLuint		stats_vbo;	/* the (streamed) vertices of the statistics charts */
+		int		stats_alloc;	/* the number of floats allocated for stats_verts */
+		GLfloat		*stats_verts;	/* the vertices of the chart being drawn */
+	} _GLShapeBuffers;
+
+#ifdef VR_BASICGFX_RETAINED
+static	_GLShapeBuffers			shape_buffers[VR_BASICGFX_MAXCONTEXTS];
+static	int				shape_num_buffers = 0;
+static	pthread_mutex_t			shape_buffers_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The buffer functions are beyond OpenGL 1.1, so they are fetched at run   */
+/*   time, with the function of the graphics type that vrShapeGLContextInit() */
+/*   was given.  The pointers are the same for every context, so they are    */
+/*   only fetched once per process.  Until then, the shapes are drawn in     */
+/*   immediate mode.                                                         */
+static	PFNGLGENBUFFERSPROC		glGenBuffers_func = NULL;
+static	PFNGLDELETEBUFFERSPROC		glDeleteBuffers_func = NULL;
+static	PFNGLBINDBUFFERPROC		glBindBuffer_func = NULL;
+static	PFNGLBUFFERDATAPROC		glBufferData_func = NULL;
+static	PFNGLBUFFERSUBDATAPROC		glBufferSubData_func = NULL;
+
+
+/*********************************************************************/
+/* _GLShapeVertex(): put one vertex of a shape into the packed array. */
+static GLfloat *_GLShapeVertex(GLfloat *vert, float *position, float *normal)
+{
+	vert[0] = position[0];
+	vert[1] = position[1];
+	vert[2] = position[2];
+	vert[3] = normal[0];
+	vert[4] = normal[1];
+	vert[5] = normal[2];
+
+	return vert + 6;
+}
+
+
+/**************************************************************************/
+/* _GLShapeBuild(): fill the buffers of the shapes in the current context. */
+/*   Returns 1 on success, and -1 if the context has no buffer objects.    */
+static int _GLShapeBuild(_GLShapeBuffers *buffers)
+{
+	const char	*version = (const char *)glGetString(GL_VERSION);
+	int		major = 0;
+	int		minor = 0;
+	GLfloat		verts[SHAPE_VERTICES * 6];
+	GLfloat		*vert = verts;
+	static float	up[3] = { 0.0, 1.0, 0.0 };
+	int		poly;
+	int		count;
+
+	if (version != NULL)
+		sscanf(version, "%d.%d", &major, &minor);
+	if (major < 1 || (major == 1 && minor < 5))
+		return -1;
+
+	if (glGenBuffers_func == NULL || glDeleteBuffers_func == NULL || glBindBuffer_func == NULL
+			|| glBufferData_func == NULL || glBufferSubData_func == NULL)
+		return -1;
+
+	/* the cube */
+	for (poly = 0; poly < 6; poly++) {
+		for (count = 0; count < 4; count++)
+			vert = _GLShapeVertex(vert, cube_vertices[cube_polygons[poly][count]], cube_normals[poly]);
+	}
+
+	/* the pyramid -- the bottom is split into two triangles */
+	for (poly = 0; poly < 4; poly++) {
+		for (count = 0; count < 3; count++)
+			vert = _GLShapeVertex(vert, cube_vertices[pyramid_polygons[poly][count]], pyramid_normals[poly]);
+	}
+	vert = _GLShapeVertex(vert, cube_vertices[pyramid_polygons[4][0]], pyramid_normals[4]);
+	vert = _GLShapeVertex(vert, cube_vertices[pyramid_polygons[4][1]], pyramid_normals[4]);
+	vert = _GLShapeVertex(vert, cube_vertices[pyramid_polygons[4][2]], pyramid_normals[4]);
+	vert = _GLShapeVertex(vert, cube_vertices[pyramid_polygons[4][0]], pyramid_normals[4]);
+	vert = _GLShapeVertex(vert, cube_vertices[pyramid_polygons[4][2]], pyramid_normals[4]);
+	vert = _GLShapeVertex(vert, cube_vertices[pyramid_polygons[4][3]], pyramid_normals[4]);
+
+	/* the outlines */
+	for (count = 0; count < 16; count++)
+		vert = _GLShapeVertex(vert, cube_vertices[cube_outline_strip[count]], cube_normals[5]);
+	for (count = 0; count < 10; count++)
+		vert = _GLShapeVertex(vert, cube_vertices[pyramid_outline_strip[count]], pyramid_normals[4]);
+
+	/* the floor */
+	{	float	floor_vertices[4][3] = {
+				{ -5.0, 0.0, -5.0 },
+				{  5.0, 0.0, -5.0 },
+				{  5.0, 0.0,  5.0 },
+				{ -5.0, 0.0,  5.0 } };
+
+		for (count = 0; count < 4; count++)
+			vert = _GLShapeVertex(vert, floor_vertices[count], up);
+	}
+
+	glGenBuffers_func(1, &buffers->shape_vbo);
+	glGenBuffers_func(1, &buffers->outline_vbo);
+	glGenBuffers_func(1, &buffers->stats_vbo);
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+	glBindBuffer_func(GL_ARRAY_BUFFER, buffers->shape_vbo);
+	glBufferData_func(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+	glPopClientAttrib();
+
+	vrDbgPrintfN(SELDOM_DBGLVL, "_GLShapeBuild(): shape buffers made for context %#p.\n", buffers->context);
+
+	return 1;
+}
+
+
+/*************************************************************************/
+/* _GLShapeBuffersLookup(): return the buffer data of the current        */
+/*   context, making the buffers the first time the context is seen.     */
+/*   Returns NULL when there is no current context, or no room for it.   */
+static _GLShapeBuffers *_GLShapeBuffersLookup()
+{
+static	int		table_full_reported = 0;
+	_GLShapeBuffers	*buffers = NULL;
+	void		*context;
+	int		count;
+
+	context = (void *)glXGetCurrentContext();
+#  if defined(WIN_EGL)
+	if (context == NULL)
+		context = (void *)eglGetCurrentContext();
+#  endif
+	if (context == NULL)
+		return NULL;
+
+	pthread_mutex_lock(&shape_buffers_lock);
+	for (count = 0; count < shape_num_buffers; count++) {
+		if (shape_buffers[count].context == context) {
+			buffers = &shape_buffers[count];
+			break;
+		}
+	}
+
+	if (buffers == NULL) {
+		/* reuse an entry freed by vrShapeGLContextRelease() */
+		for (count = 0; count < shape_num_buffers; count++) {
+			if (shape_buffers[count].context == NULL) {
+				buffers = &shape_buffers[count];
+				break;
+			}
+		}
+		if (buffers == NULL && shape_num_buffers < VR_BASICGFX_MAXCONTEXTS)
+			buffers = &shape_buffers[shape_num_buffers++];
+
+		if (buffers != NULL) {
+			memset(buffers, 0, sizeof(_GLShapeBuffers));
+			buffers->context = context;
+			buffers->status = _GLShapeBuild(buffers);
+		} else if (!table_full_reported) {
+			vrErrPrintf("_GLShapeBuffersLookup(): " RED_TEXT "more than %d contexts, drawing shapes in immediate mode.\n" NORM_TEXT, VR_BASICGFX_MAXCONTEXTS);
+			table_full_reported = 1;
+		}
+	}
+	pthread_mutex_unlock(&shape_buffers_lock);
+
+	return buffers;
+}
+
+
+/*************************************************************************/
+/* _GLShapeBuffersCurrent(): return the shape buffers of the current     */
+/*   context.  Returns NULL when the shapes have to be drawn in immediate */
+/*   mode.                                                               */
+static _GLShapeBuffers *_GLShapeBuffersCurrent()
+{
+	_GLShapeBuffers	*buffers = _GLShapeBuffersLookup();
+
+	if (buffers == NULL || buffers->status < 0)
+		return NULL;
+
+	return buffers;
+}
+#endif /* VR_BASICGFX_RETAINED */
+
+
+/*************************************************************************/
+/* vrShapeGLContextInit(): called by a graphics type once the context of */
+/*   a window is current, to give the shapes the function that fetches   */
+/*   the GL functions of that graphics type (ie. glXGetProcAddressARB()  */
+/*   or eglGetProcAddress()).  The buffers themselves are made the first */
+/*   time a shape is drawn in the context.                               */
+void vrShapeGLContextInit(void *(*getproc)(const char *))
+{
+#ifdef VR_BASICGFX_RETAINED
+	pthread_mutex_lock(&shape_buffers_lock);
+	if (glGenBuffers_func == NULL && getproc != NULL) {
+		glGenBuffers_func = (PFNGLGENBUFFERSPROC)getproc("glGenBuffers");
+		glDeleteBuffers_func = (PFNGLDELETEBUFFERSPROC)getproc("glDeleteBuffers");
+		glBindBuffer_func = (PFNGLBINDBUFFERPROC)getproc("glBindBuffer");
+		glBufferData_func = (PFNGLBUFFERDATAPROC)getproc("glBufferData");
+		glBufferSubData_func = (PFNGLBUFFERSUBDATAPROC)getproc("glBufferSubData");
+	}
+	pthread_mutex_unlock(&shape_buffers_lock);
+#endif
+}
+
+
+/*************************************************************************/
+/* vrShapeGLContextRelease(): called by a graphics type (with the context */
+/*   of a window current) as the window is closed, to delete the shape   */
+/*   buffers of the context and free its entry of the table -- so that a */
+/*   new context given the same address doesn't use stale buffers.      */
+void vrShapeGLContextRelease()
+{
+#ifdef VR_BASICGFX_RETAINED
+	_GLShapeBuffers	*buffers = NULL;
+	void		*context;
+	int		count;
+
+	context = (void *)glXGetCurrentContext();
+#  if defined(WIN_EGL)
+	if (context == NULL)
+		context = (void *)eglGetCurrentContext();
+#  endif
+	if (context == NULL)
+		return;
+
+	pthread_mutex_lock(&shape_buffers_lock);
+	for (count = 0; count < shape_num_buffers; count++) {
+		if (shape_buffers[count].context == context) {
+			buffers = &shape_buffers[count];
+			break;
+		}
+	}
+
+	if (buffers != NULL) {
+		if (buffers->status > 0) {
+			glDeleteBuffers_func(1, &buffers->shape_vbo);
+			glDeleteBuffers_func(1, &buffers->outline_vbo);
+			glDeleteBuffers_func(1, &buffers->stats_vbo);
+		}
+		free(buffers->outline_verts);
+		free(buffers->outline_next);
+		free(buffers->stats_verts);
+		memset(buffers, 0, sizeof(_GLShapeBuffers));	/* ie. the entry is free */
+
+		vrDbgPrintfN(SELDOM_DBGLVL, "vrShapeGLContextRelease(): shape buffers of context %#p released.\n", context);
+	}
+	pthread_mutex_unlock(&shape_buffers_lock);
+#endif
+}
+
+
+/**************************************************************************/
+/* _GLShapeBind(): make the shape buffer the source of the vertex arrays,  */
+/*   (saving the caller's vertex array state the first time).  Returns     */
+/*   NULL when the shapes have to be drawn in immediate mode.              */
+static _GLShapeBuffers *_GLShapeBind()
+{
+#ifdef VR_BASICGFX_RETAINED
+	_GLShapeBuffers	*buffers;
+
+	if ((buffers = _GLShapeBuffersCurrent()) == NULL)
+		return NULL;
+
+	if (buffers->bound++ == 0) {
+		glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+		glBindBuffer_func(GL_ARRAY_BUFFER, buffers->shape_vbo);
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_INDEX_ARRAY);
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_EDGE_FLAG_ARRAY);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glVertexPointer(3, GL_FLOAT, 6 * sizeof(GLfloat), (GLvoid *)0);
+		glNormalPointer(GL_FLOAT, 6 * sizeof(GLfloat), (GLvoid *)(3 * sizeof(GLfloat)));
+	}
+
+	return buffers;
+#else
+	return NULL;
+#endif
+}
+
+
+/************************************************************************/
+/* _GLShapeUnbind(): restore the caller's vertex array state once the   */
+/*   outermost _GLShapeBind() is done.                                   */
+static void _GLShapeUnbind(_GLShapeBuffers *buffers)
+{
+	if (--buffers->bound == 0)
+		glPopClientAttrib();
+}
+
+
 /*********************************************************************/
 void vrShapeGLCube()
 {
-	int	poly;
+	_GLShapeBuffers	*buffers;
+	int		poly;
+
+	if ((buffers = _GLShapeBind()) != NULL) {
+		glDrawArrays(GL_QUADS, SHAPE_CUBE, 24);
+		_GLShapeUnbind(buffers);
+		return;
+	}
 
 	for (poly = 0; poly < 6; poly++) {
 		glBegin(GL_POLYGON);
@@ -113,7 +459,14 @@ void vrShapeGLCube()
 /*********************************************************************/
 void vrShapeGLCubeOpen()
 {
-	int	poly;
+	_GLShapeBuffers	*buffers;
+	int		poly;
+
+	if ((buffers = _GLShapeBind()) != NULL) {
+		glDrawArrays(GL_QUADS, SHAPE_CUBE_OPEN, 20);
+		_GLShapeUnbind(buffers);
+		return;
+	}
 
 	for (poly = 0; poly < 6; poly++) {
 		if (poly != 0) {
@@ -132,8 +485,16 @@ void vrShapeGLCubeOpen()
 /*********************************************************************/
 void vrShapeGLCubeOutline()
 {
+	_GLShapeBuffers	*buffers;
+
 	glPushAttrib(GL_COLOR_BUFFER_BIT);
 	glDisable(GL_BLEND);
+	if ((buffers = _GLShapeBind()) != NULL) {
+		glDrawArrays(GL_LINE_STRIP, SHAPE_CUBE_OUTLINE, 16);
+		_GLShapeUnbind(buffers);
+		glPopAttrib();
+		return;
+	}
 	glBegin(GL_LINE_STRIP);
 		glVertex3fv(cube_vertices[0]);
 		glVertex3fv(cube_vertices[1]);
@@ -190,7 +551,14 @@ void vrShapeGLCubePlusOutline()
 /*********************************************************************/
 void vrShapeGLPyramid()
 {
-	int	poly;
+	_GLShapeBuffers	*buffers;
+	int		poly;
+
+	if ((buffers = _GLShapeBind()) != NULL) {
+		glDrawArrays(GL_TRIANGLES, SHAPE_PYRAMID, 18);
+		_GLShapeUnbind(buffers);
+		return;
+	}
 
 	for (poly = 0; poly < 5; poly++) {
 		glBegin(GL_POLYGON);
@@ -208,8 +576,16 @@ void vrShapeGLPyramid()
 /*********************************************************************/
 void vrShapeGLPyramidOutline()
 {
+	_GLShapeBuffers	*buffers;
+
 	glPushAttrib(GL_COLOR_BUFFER_BIT);
 	glDisable(GL_BLEND);
+	if ((buffers = _GLShapeBind()) != NULL) {
+		glDrawArrays(GL_LINE_STRIP, SHAPE_PYRAMID_OUTLINE, 10);
+		_GLShapeUnbind(buffers);
+		glPopAttrib();
+		return;
+	}
 	glBegin(GL_LINE_STRIP);
 		glVertex3fv(cube_vertices[1]);
 		glVertex3fv(cube_vertices[8]);
@@ -242,7 +618,14 @@ void vrShapeGLPyramidPlusOutline()
 /*******************************************************************/
 void vrShapeGLFloor()
 {
+	_GLShapeBuffers	*buffers;
+
 	glColor3ub((GLbyte)25, (GLbyte)25, (GLbyte)200);	/* blue */
+	if ((buffers = _GLShapeBind()) != NULL) {
+		glDrawArrays(GL_QUADS, SHAPE_FLOOR, 4);
+		_GLShapeUnbind(buffers);
+		return;
+	}
 	glBegin(GL_POLYGON);
 		glVertex3f(-5.0, 0.0, -5.0);
 		glVertex3f( 5.0, 0.0, -5.0);
@@ -604,6 +987,29 @@ static	int	header_count = 0;
 }
 
 
+/*************************************************************************/
+/* _GLRenderWindowName(): puts the name of the window in its upper-left  */
+/*   corner (in white), over whatever else has been drawn there.         */
+static void _GLRenderWindowName(vrRenderInfo *renderinfo, vrWindowInfo *window)
+{
+	char		msg[128];
+
+	glPushAttrib(GL_DEPTH_BUFFER_BIT);
+	glDisable(GL_DEPTH_TEST);
+
+	glColor3ub((GLbyte)255, (GLbyte)255, (GLbyte)255);		/* white */
+	glRasterPos3dv(window->coords_ul);
+#  if 1 /* set to '0' for more detail (i.e. inclusion of the window's arguments) */
+	sprintf(msg, "%s (%d)", window->name, window->id);
+#  else
+	sprintf(msg, "%s (%d) -- %s", window->name, window->id, window->args);
+#  endif
+	vrRenderText(renderinfo, msg);
+
+	glPopAttrib();
+}
+
+
 /******************************************************************************/
 /* _GLRenderWindowOutline(): renders the outline of the provided window (in   */
 /*   pink/magenta), and puts the name of the window in the upper-left corner. */
@@ -618,7 +1024,6 @@ static	int	header_count = 0;
 void _GLRenderWindowOutline(vrRenderInfo *renderinfo, vrWindowInfo *window)
 {
 	double		coords_ur[3];
-	char		msg[128];
 
 	/********************************************/
 	/*** Calculate the upper-right coordinate ***/
@@ -653,19 +1058,7 @@ void _GLRenderWindowOutline(vrRenderInfo *renderinfo, vrWindowInfo *window)
 
 	/****************************/
 	/*** draw the window name ***/
-	glPushAttrib(GL_DEPTH_BUFFER_BIT);
-	glDisable(GL_DEPTH_TEST);
-
-	glColor3ub((GLbyte)255, (GLbyte)255, (GLbyte)255);		/* white */
-	glRasterPos3dv(window->coords_ul);
-#  if 1 /* set to '0' for more detail (i.e. inclusion of the window's arguments) */
-	sprintf(msg, "%s (%d)", window->name, window->id);
-#  else
-	sprintf(msg, "%s (%d) -- %s", window->name, window->id, window->args);
-#  endif
-	vrRenderText(renderinfo, msg);
-
-	glPopAttrib();
+	_GLRenderWindowName(renderinfo, window);
 
 #if 0 /* More development code that will normally be off (0) (tempchange) { */
 	/*************************************************************/
@@ -781,6 +1174,101 @@ void _GLRenderWindowOutline(vrRenderInfo *renderinfo, vrWindowInfo *window)
 }
 
 
+#ifdef VR_BASICGFX_RETAINED
+/****************************************************************************/
+/* _GLRenderWindowOutlinesRetained(): renders the outlines of all the       */
+/*   windows shown in the simulator with one draw, and then their names.    */
+/*   The outlines are only sent to the buffer when they have changed, which */
+/*   for most windows (those not mounted to a sensor) is just once.         */
+static void _GLRenderWindowOutlinesRetained(vrRenderInfo *renderinfo, vrWindowInfo *windowdefs, _GLShapeBuffers *buffers)
+{
+	vrWindowInfo	*window;
+	GLfloat		*vert;
+	GLfloat		*swap;
+	double		*corners[5];
+	double		coords_ur[3];
+	int		size;
+	int		count;
+
+	/* count the floats needed -- 4 lines (8 vertices) per window */
+	size = 0;
+	for (window = windowdefs; window->next != NULL; window = window->next) {
+		if (window->show_in_simulator)
+			size += 8 * 3;
+	}
+	if (size == 0)
+		return;
+
+	if (size > buffers->outline_alloc) {
+		buffers->outline_verts = (GLfloat *)realloc(buffers->outline_verts, size * sizeof(GLfloat));
+		buffers->outline_next = (GLfloat *)realloc(buffers->outline_next, size * sizeof(GLfloat));
+		buffers->outline_alloc = size;
+		buffers->outline_size = 0;	/* force the buffer to be refilled */
+	}
+
+	/* put the frame of each window into the array */
+	vert = buffers->outline_next;
+	for (window = windowdefs; window->next != NULL; window = window->next) {
+		if (!window->show_in_simulator)
+			continue;
+
+		coords_ur[VR_X] = window->coords_ul[VR_X] - window->coords_ll[VR_X] + window->coords_lr[VR_X];
+		coords_ur[VR_Y] = window->coords_ul[VR_Y] - window->coords_ll[VR_Y] + window->coords_lr[VR_Y];
+		coords_ur[VR_Z] = window->coords_ul[VR_Z] - window->coords_ll[VR_Z] + window->coords_lr[VR_Z];
+
+		corners[0] = window->coords_ul;
+		corners[1] = window->coords_ll;
+		corners[2] = window->coords_lr;
+		corners[3] = coords_ur;
+		corners[4] = window->coords_ul;
+		for (count = 0; count < 4; count++) {
+			*vert++ = corners[count][VR_X];
+			*vert++ = corners[count][VR_Y];
+			*vert++ = corners[count][VR_Z];
+			*vert++ = corners[count+1][VR_X];
+			*vert++ = corners[count+1][VR_Y];
+			*vert++ = corners[count+1][VR_Z];
+		}
+	}
+
+	/* send them to the buffer only when they differ from the last frame */
+	glBindBuffer_func(GL_ARRAY_BUFFER, buffers->outline_vbo);
+	if (size != buffers->outline_size || memcmp(buffers->outline_next, buffers->outline_verts, size * sizeof(GLfloat)) != 0) {
+		if (size != buffers->outline_size)
+			glBufferData_func(GL_ARRAY_BUFFER, size * sizeof(GLfloat), buffers->outline_next, GL_DYNAMIC_DRAW);
+		else	glBufferSubData_func(GL_ARRAY_BUFFER, 0, size * sizeof(GLfloat), buffers->outline_next);
+		swap = buffers->outline_verts;
+		buffers->outline_verts = buffers->outline_next;
+		buffers->outline_next = swap;
+		buffers->outline_size = size;
+	}
+
+	/******************************/
+	/*** draw the frame outlines ***/
+	glLineWidth(4.5);
+	glPolygonMode(GL_FRONT, GL_POINT);
+
+	glColor3ub((GLbyte)254,  (GLbyte)38, (GLbyte)174);		/* a magenta-ish/pink-ish color */
+
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, (GLvoid *)0);
+	glDrawArrays(GL_LINES, 0, size / 3);
+
+	/* back to the shape buffer for anything drawn after */
+	glBindBuffer_func(GL_ARRAY_BUFFER, buffers->shape_vbo);
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 6 * sizeof(GLfloat), (GLvoid *)0);
+
+	/*****************************/
+	/*** draw the window names ***/
+	for (window = windowdefs; window->next != NULL; window = window->next) {
+		if (window->show_in_simulator)
+			_GLRenderWindowName(renderinfo, window);
+	}
+}
+#endif /* VR_BASICGFX_RETAINED */
+
+
 /***************************************************************************/
 /* _GLRenderWindowOutlines(): loops through all the windows and render the */
 /*   ones with their "render-in-simulator" flag set.                       */
@@ -789,10 +1277,21 @@ void _GLRenderWindowOutlines(vrRenderInfo *renderinfo)
 	vrWindowInfo	*windowdefs;
 	vrWindowInfo	*window;
 	int		count;
+#ifdef VR_BASICGFX_RETAINED
+	_GLShapeBuffers	*buffers;
+#endif
 
 	/* get the first window of the global config list of windows */
 	windowdefs = (vrWindowInfo *)vrObjectFirst(renderinfo->context, VROBJECT_WINDOW);	/* get the head of the linked list of defined windows */
 
+#ifdef VR_BASICGFX_RETAINED
+	if ((buffers = _GLShapeBind()) != NULL) {
+		_GLRenderWindowOutlinesRetained(renderinfo, windowdefs, buffers);
+		_GLShapeUnbind(buffers);
+		return;
+	}
+#endif
+
 	/* loop over the entire linked list of windows in the configuration */
 	for (window = windowdefs; window->next != NULL; window = window->next) {
 		if (window->show_in_simulator) {
@@ -832,6 +1331,7 @@ void vrGLRenderDefaultSimulator(vrRenderInfo *renderinfo, int mask)
 	vrMatrix	dstmat;
 	int		num_6sensors = renderinfo->context->input->num_6sensors;
 	int		sensor_num;
+	_GLShapeBuffers	*buffers;		/* NULL when drawing in immediate mode */
 
 
 #define	ATTR_REPORT 0x00	/* Set this value to 0x0 to disable attribute reporting to stdout (was 0x3b) */
@@ -876,6 +1376,9 @@ void vrGLRenderDefaultSimulator(vrRenderInfo *renderinfo, int mask)
 	glFrontFace(GL_CCW);
 	glCullFace(GL_BACK);
 
+	/* set up the shape buffers once for all the shapes of the view */
+	buffers = _GLShapeBind();
+
 
 	/**********************************************/
 	/* draw a brown 0.5' cube to represent the head */
@@ -1052,7 +1555,176 @@ void vrGLRenderDefaultSimulator(vrRenderInfo *renderinfo, int mask)
 
 	/*********************************/
 	/* restore the OpenGL attributes */
+	if (buffers != NULL)
+		_GLShapeUnbind(buffers);
 	glPopAttrib();
 	vrGLReportAttributes("After  ", ATTR_REPORT);
 }
 
+
+
+/****************************************************************************/
+/* _GLStatsQuad(): put one (axis-aligned) quad of the statistics chart into */
+/*   the vertex array -- each vertex being (x,y, r,g,b,a).                  */
+static GLfloat *_GLStatsQuad(GLfloat *vert, double x0, double y0, double x1, double y1, float *color)
+{
+	double		corners[4][2];
+	int		count;
+
+	corners[0][0] = x0;	corners[0][1] = y0;
+	corners[1][0] = x1;	corners[1][1] = y0;
+	corners[2][0] = x1;	corners[2][1] = y1;
+	corners[3][0] = x0;	corners[3][1] = y1;
+
+	for (count = 0; count < 4; count++) {
+		*vert++ = corners[count][0];
+		*vert++ = corners[count][1];
+		*vert++ = color[0];
+		*vert++ = color[1];
+		*vert++ = color[2];
+		*vert++ = color[3];
+	}
+
+	return vert;
+}
+
+
+/****************************************************************************/
+/* vrGLRenderStatsChart(): draws the (non-text) parts of a statistics chart */
+/*   -- the backdrops, the time lines and the bars of every frame in the    */
+/*   ring -- as one array of quads, with a single draw.  The lines and bars */
+/*   become quads of the same width in pixels.  When the context has them,  */
+/*   the vertices are streamed through a buffer object, otherwise they are  */
+/*   drawn from a client-side array.                                        */
+/* NOTE: this assumes the 2D ortho projection (0.0 to 1.0) of the callers,  */
+/*   with blending enabled, and that GL_ENABLE_BIT has been pushed (as face */
+/*   culling is disabled).  The labels are left to the caller, since the    */
+/*   text is rendered differently by each window type.                      */
+void vrGLRenderStatsChart(vrProcessStats *stats, int width, int height)
+{
+	_GLShapeBuffers	*buffers = NULL;
+	GLfloat		*verts;
+	GLfloat		*vert;
+	double		char_height = 13;		/* empirically determined height of characters in pixels (as with the callers) */
+	double		scale = stats->time_scale * 2.0;
+	double		text_scale = (char_height / height);
+	double		bottom = stats->yloc;			/* y location of bottom of chart */
+	double		top =    bottom+(scale*stats->top_time);/* y location of top of chart */
+	double		hline_step = stats->hline_interval * scale;
+	double		pixel_x = 1.0 / width;
+	double		pixel_y = 1.0 / height;
+	double		bar_width;
+	double		y;
+	int		num_hlines = 0;
+	int		line;
+	int		num_quads;
+	int		size;
+	int		frame;
+	int		segment;
+	float		black[4] = { 0.0, 0.0, 0.0, 1.0 };
+	float		black_overlay[4] = { 0.0, 0.0, 0.0, 64.0/255.0 };
+
+	if (width <= 0 || height <= 0)
+		return;
+
+	/* count the quads: two backdrops for the labels, plus the chart's */
+	if (hline_step > 0.0) {
+		for (y = bottom; y <= top; y += hline_step)
+			num_hlines++;
+	}
+	num_quads = 3 + (2 * num_hlines) + (stats->frames * stats->elements);
+	size = num_quads * 4 * 6;
+
+#ifdef VR_BASICGFX_RETAINED
+	buffers = _GLShapeBuffersLookup();
+#endif
+	if (buffers != NULL) {
+		if (size > buffers->stats_alloc) {
+			buffers->stats_verts = (GLfloat *)realloc(buffers->stats_verts, size * sizeof(GLfloat));
+			buffers->stats_alloc = size;
+		}
+		verts = buffers->stats_verts;
+	} else {
+		verts = (GLfloat *)malloc(size * sizeof(GLfloat));
+	}
+	if (verts == NULL)
+		return;
+
+	/*************************************************************/
+	/* fill the array in the order things are to be drawn -- the */
+	/*   later quads are blended over the earlier ones.          */
+	vert = verts;
+
+	/* a semi-transparent background to help contrast */
+	vert = _GLStatsQuad(vert, 0.0, bottom, 1.0, top, stats->back_color);
+
+	/* some (1 pixel) horizontal lines to mark time */
+	for (y = bottom, line = 0; line < num_hlines; y += hline_step, line++)
+		vert = _GLStatsQuad(vert, 0.0, y - 0.5*pixel_y, 1.0, y + 0.5*pixel_y, black);
+
+	/* the statistics as a bar graph (bars are at least a pixel wide) */
+	bar_width = (width/stats->frames) * 0.80;
+	if (bar_width < 1.0)
+		bar_width = 1.0;
+	bar_width *= pixel_x;
+	for (frame = 0; frame < stats->frames; frame++) {
+		int	first_element = stats->elements * frame;
+		double	yloc = bottom;
+		double	ynext;
+#if 1 /* set to 0 for xloc that produces a heart-rate (oscilloscope) style display */
+		double	xloc = (((frame-stats->time_frame)+(stats->frames-1)) % stats->frames)/(double)stats->frames + 0.005;
+#else
+		double	xloc = (double)frame/stats->frames + 0.005;
+#endif
+		for (segment = 0; segment < stats->elements; segment++) {
+			if (stats->show_mask & (1 << segment)) {
+				ynext = yloc + scale * stats->measures[first_element+segment];
+				if (ynext > yloc)	/* most elements of most frames are empty */
+					vert = _GLStatsQuad(vert, xloc - 0.5*bar_width, yloc, xloc + 0.5*bar_width, ynext, stats->elem_colors[segment]);
+				yloc = ynext;
+			}
+		}
+	}
+
+	/* the lines again over the bars, in semi-transparent black */
+	for (y = bottom, line = 0; line < num_hlines; y += hline_step, line++)
+		vert = _GLStatsQuad(vert, 0.0, y - 0.5*pixel_y, 1.0, y + 0.5*pixel_y, black_overlay);
+
+	/* backdrops for the element labels, and for the overall label */
+	vert = _GLStatsQuad(vert, 0.03, bottom + (2.0 * text_scale), 0.05 + (8 * text_scale), bottom + (2.6 * text_scale) + (stats->elements * text_scale * 0.95), stats->back_color);
+	vert = _GLStatsQuad(vert, 0.005, bottom + (0.80 * text_scale), 0.060, bottom + (1.95 * text_scale), stats->back_color);
+
+	/* the hidden and empty bars were skipped, so the quad count can be short */
+	num_quads = (vert - verts) / (4 * 6);
+
+	/*******************************/
+	/* draw all the quads at once */
+	glDisable(GL_CULL_FACE);
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_INDEX_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_EDGE_FLAG_ARRAY);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+
+#ifdef VR_BASICGFX_RETAINED
+	if (buffers != NULL && buffers->status > 0) {
+		/* a new store each time, so there is no waiting on the last draw */
+		glBindBuffer_func(GL_ARRAY_BUFFER, buffers->stats_vbo);
+		glBufferData_func(GL_ARRAY_BUFFER, num_quads * 4 * 6 * sizeof(GLfloat), verts, GL_STREAM_DRAW);
+		glVertexPointer(2, GL_FLOAT, 6 * sizeof(GLfloat), (GLvoid *)0);
+		glColorPointer(4, GL_FLOAT, 6 * sizeof(GLfloat), (GLvoid *)(2 * sizeof(GLfloat)));
+	} else
+#endif
+	{
+		glVertexPointer(2, GL_FLOAT, 6 * sizeof(GLfloat), verts);
+		glColorPointer(4, GL_FLOAT, 6 * sizeof(GLfloat), verts + 2);
+	}
+	glDrawArrays(GL_QUADS, 0, num_quads * 4);
+
+	glPopClientAttrib();
+
+	if (buffers == NULL)
+		free(verts);
+}
@@ -3,7 +3,7 @@
  * HH   HH         vr_basicgfx.glx.h
  * HH   HH         Author(s): Bill Sherman
  * HHHHHHH         Created: November 30, 1999
- * HH   HH         Last Modified: September 9, 2001
+ * HH   HH         Last Modified: October 19, 2026
  * HH   HH
  *
  * Header file for FreeVR basic OpenGL graphics routines.
@@ -28,8 +28,11 @@ void	vrShapeGLPyramid();
 void	vrShapeGLPyramidOutline();
 void	vrShapeGLPyramidPlusOutline();
 void	vrShapeGLFloor();
+void	vrShapeGLContextInit(void *(*getproc)(const char *));
+void	vrShapeGLContextRelease();
 void	vrGLReportAttributes(char *msg, unsigned long reports);
 void	vrGLRenderDefaultSimulator(vrRenderInfo *renderinfo, int mask);
+void	vrGLRenderStatsChart(vrProcessStats *stats, int width, int height);
 
 #ifdef __cplusplus
 }
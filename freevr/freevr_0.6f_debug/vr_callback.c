@@ -54,6 +54,13 @@ char *vrCallbackTypeName(vrFuncType type)
 	case VRFUNC_HANDLE_USR2:
 		return "HandleUSR2";
 
+	case VRFUNC_ONE_DISPLAY_STEREO:
+		return "DisplayStereoOne";
+	case VRFUNC_ALL_DISPLAY_STEREO:
+		return "DisplayStereo";
+	case VRFUNC_DISPLAY_BUDGET:
+		return "DisplayBudget";
+
 	default:
 		return "unknown";
 	}
@@ -81,12 +88,16 @@ void vrFprintCallbackList(FILE *file, vrCallbackList *cblist, vrPrintStyle style
 		vrFprintf(file,
 			"\tVisrenInit = %#p (%s)\n\tVisrenFrame = %#p (%s)\n\tVisrenWorld = %#p (%s)\n"
 			"\tVisrenSim = %#p (%s)\n\tVisrenExit = %#p (%s)\n"
+			"\tVisrenWorldStereo = %#p (%s)\n"
+			"\tVisrenBudget = %#p (%s)\n"
 			"\tHandleUSR2 = %#p (%s)\n",
 			cblist->VisrenInit,		cblist->VisrenInit->name,
 			cblist->VisrenFrame,		cblist->VisrenFrame->name,
 			cblist->VisrenWorld,		cblist->VisrenWorld->name,
 			cblist->VisrenSim,		cblist->VisrenSim->name,
 			cblist->VisrenExit,		cblist->VisrenExit->name,
+			cblist->VisrenWorldStereo,	(cblist->VisrenWorldStereo != NULL ? cblist->VisrenWorldStereo->name : "-"),
+			cblist->VisrenBudget,		(cblist->VisrenBudget != NULL ? cblist->VisrenBudget->name : "-"),
 			cblist->HandleUSR2,		cblist->HandleUSR2->name);
 		vrFprintf(file, "}\n");
 
@@ -118,6 +129,8 @@ void vrCallbackListInitialize(vrCallbackList *cblist)
 	cblist->VisrenWorld = vrCallbackCreateNamed("Default:VisrenWorld-NullWorld", vrDoNothing, 0);
 #endif
 	cblist->VisrenSim = vrCallbackCreateNamed("Default:VisrenSim-DefSim", vrRenderDefaultSimulator, 0);
+	cblist->VisrenWorldStereo = NULL;	/* NULL: the app hasn't opted in to single-pass stereo */
+	cblist->VisrenBudget = NULL;		/* NULL: the app doesn't adjust to the frame budget */
 	cblist->HandleUSR2 = vrCallbackCreateNamed("Default:HandleUSR2-DN", vrDoNothing, 0);
 }
 
@@ -554,6 +567,28 @@ void vrFunctionSetCallback(vrFuncType type,...)
 		break;
 	}
 
+	/* NOTE: the stereo world callback is optional -- windows for which   */
+	/*   it is NULL (the default) render each eye with the VRFUNC_DISPLAY */
+	/*   callback.  See _VisrenRenderWindow() for when it is used.        */
+	case VRFUNC_ALL_DISPLAY_STEREO: {
+		callback = va_arg(ap, vrCallback *);
+
+		previous_cb = cblist->VisrenWorldStereo;
+		cblist->VisrenWorldStereo = callback;
+		break;
+	}
+
+	/* NOTE: the budget callback is also optional.  It is called (with */
+	/*   the vrRenderInfo) before the frame callback of each window    */
+	/*   whose frame is predicted to go over the window's budget.      */
+	case VRFUNC_DISPLAY_BUDGET: {
+		callback = va_arg(ap, vrCallback *);
+
+		previous_cb = cblist->VisrenBudget;
+		cblist->VisrenBudget = callback;
+		break;
+	}
+
 
 	/*******************************************************************/
 	/* These five set the function pointers for a particular window,   */
@@ -600,6 +635,14 @@ void vrFunctionSetCallback(vrFuncType type,...)
 		break;
 	}
 
+	case VRFUNC_ONE_DISPLAY_STEREO: {
+		window = va_arg(ap, vrWindowInfo *);
+		callback = va_arg(ap, vrCallback *);
+
+		window->VisrenWorldStereo = callback;
+		break;
+	}
+
 	/********************************************************/
 	/* this(ese) function(s) are for handling signal events */
 
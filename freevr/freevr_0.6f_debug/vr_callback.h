@@ -66,7 +66,14 @@ typedef enum vrFuncType_en {
 		VRFUNC_DISPLAY_EYE = VRFUNC_ALL_DISPLAY,
 		VRFUNC_DISPLAY_SIM = VRFUNC_ALL_DISPLAY_SIM,
 
-		VRFUNC_HANDLE_USR2
+		VRFUNC_HANDLE_USR2,
+
+		/* the single-pass stereo callbacks are added at the end, so */
+		/*   the values of the above types are left unchanged.       */
+		VRFUNC_ONE_DISPLAY_STEREO,
+		VRFUNC_ALL_DISPLAY_STEREO,
+		VRFUNC_DISPLAY_STEREO = VRFUNC_ALL_DISPLAY_STEREO,
+		VRFUNC_DISPLAY_BUDGET
 	} vrFuncType;
 
 
@@ -112,6 +119,8 @@ typedef struct vrCallbackList_st {
 		vrCallback	*VisrenFrame;	/* cb for the pre-rendering per-frame commands   */
 		vrCallback	*VisrenWorld;	/* cb to visually render the world.              */
 		vrCallback	*VisrenSim;	/* cb to visually render simulator controls      */
+		vrCallback	*VisrenWorldStereo;/* cb to render both eyes of the world at once (optional) */
+		vrCallback	*VisrenBudget;	/* cb for when a frame is predicted to go over budget (optional) */
 
 		vrCallback	*HandleUSR2;	/* cb for what to do upon receiving a USR2 signal */
 
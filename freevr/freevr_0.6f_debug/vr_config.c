@@ -247,6 +247,9 @@ static vrTokenInfo _ConfigTSMap[] = {
 		{ VRTOKEN_WINDOW_STATSPROCS,	"statsprocs" },
 		{ VRTOKEN_WINDOW_FRAMESHOW,	"showframe" },
 		{ VRTOKEN_WINDOW_SIMMASK,	"simmask" },
+		{ VRTOKEN_WINDOW_LATELATCH,	"latelatch" },
+		{ VRTOKEN_WINDOW_RENDERTHREAD,	"renderthread" },
+		{ VRTOKEN_WINDOW_FRAMEBUDGET,	"framebudget" },
 
 	   /** eyelist options **/
 		{ VRTOKEN_EYELIST_MONOFB,	"monofb" },		/* or "single" */
@@ -1158,6 +1161,24 @@ static vrTokenInfo _ConfigParseWindowOption(vrObjectInfo *object, vrTokenInfo to
 	case VRTOKEN_WINDOW_SIMMASK:	/* Format: "simMask" assignment-expr number [";"] */
 					/**************************************************/
 		token = vrParseSingleIntegerExpr(&(window->simulator_mask), "Window Simulator-Mask", parse);
+		break;
+
+					/****************************************************/
+	case VRTOKEN_WINDOW_LATELATCH:	/* Format: "lateLatch" assignment-expr number [";"] */
+					/****************************************************/
+		token = vrParseSingleIntegerExpr(&(window->late_latch), "Window Late-Latch", parse);
+		break;
+
+					/*******************************************************/
+	case VRTOKEN_WINDOW_RENDERTHREAD:/* Format: "renderThread" assignment-expr number [";"] */
+					/*******************************************************/
+		token = vrParseSingleIntegerExpr(&(window->render_thread), "Window Render-Thread", parse);
+		break;
+
+					/*******************************************************/
+	case VRTOKEN_WINDOW_FRAMEBUDGET:/* Format: "frameBudget" assignment-expr number [";"] */
+					/*******************************************************/
+		token = vrParseSingleFloatExpr(&(window->frame_budget), "Window Frame-Budget", parse);
 		break;
 
 					/************************************************************************/
@@ -53,6 +53,7 @@ extern "C" {
 #define PERFORMER_DBGLVL	  60
 #define PERFORMER_DETAIL_DBGLVL	  60 + 500
 #define GLX_DBGLVL		  60
+#define EGL_DBGLVL		  60
 #define	VARIABLE_DBGLVL		  65
 #define	PARSE_DBGLVL		  70
 #define PARSE_DETAIL_DBGLVL	 190
@@ -70,6 +71,7 @@ extern "C" {
 #define	SHMEMD_DBGLVL		 157
 #define	VRUIDD_DBGLVL		 158
 #define	VRPN_DBGLVL		 159
+#define	REPLAY_DBGLVL		 160
 #define	INPUT_DBGLVL		 180
 #define	CONFIG_DBGLVL		 185
 #define	CALLBACK_DBGLVL		 195
@@ -251,7 +251,7 @@ void vrUserClear(vrUserInfo *object)
 	object->color[2] = 0.0;
 	object->num_inputs = 0;
 	object->simdata_lock = vrLockCreateName(vrContext, "user object sim data");
-	object->visren_lock = vrLockCreateName(vrContext, "user object visren data"); /* this may now be redundant with the new app_lock */
+	object->visren_lock = vrLockCreateName(vrContext, "user object visren data"); /* no longer used -- the travel is now double-buffered */
 	object->app_lock = vrLockCreateName(vrContext, "user object travel data");
 
 	/* TODO: set a default value for the "head" field here? */
@@ -271,6 +271,12 @@ void vrUserClear(vrUserInfo *object)
 	if (object->visren_vw2rw == NULL)
 		object->visren_vw2rw = vrMatrixCreateIdentity();
 	else	vrMatrixSetIdentity(object->visren_vw2rw);
+	vrMatrixSetIdentity(&(object->pub_rw2vw[0]));
+	vrMatrixSetIdentity(&(object->pub_rw2vw[1]));
+	vrMatrixSetIdentity(&(object->pub_vw2rw[0]));
+	vrMatrixSetIdentity(&(object->pub_vw2rw[1]));
+	object->travel_held = 0;
+	object->travel_deferred = 0;
 
 	vrSettingsClear(&object->settings);
 }
@@ -813,6 +819,118 @@ vrMatrix *vrMatrixGetUserTravelInv(vrMatrix *mat, int usernum)
 }
 
 
+/*********************************************************************/
+/* The travel of the users is double-buffered between the simulation */
+/*   and the visual rendering.  The simulation changes its own copy   */
+/*   (rw2vw_xform & vw2rw_xform) under the user's locks, and once per */
+/*   frame vrFrame() publishes the travel of all the users (and the   */
+/*   application's frame data) into the older of two published        */
+/*   copies.  The freeze of the visual rendering copies the newer one  */
+/*   without any lock -- a count of the publishes tells it whether a  */
+/*   publish overwrote the copy while it was reading, in which case it */
+/*   reads again.  So a slow simulation step (or one holding the      */
+/*   travel lock) can no longer stall the rendering, which just gets   */
+/*   the travel of the last complete simulation frame.                 */
+/* NOTE: applications that don't call vrFrame() still get each change */
+/*   published as it's made (or when the travel lock is released).    */
+/* NOTE: the travel of a user whose travel lock the application holds */
+/*   (vrUserTravelLockSet()) is not published -- it may be part way   */
+/*   through a change.  The previous copy is carried forward instead, */
+/*   and the user's travel is published when the lock is released.    */
+/*********************************************************************/
+
+/************************************************************/
+/* _UserTravelPublish(): copy the travel of the given user (or of every */
+/*   user), and the frame data when "frame_data" is set, into the older  */
+/*   published copy, and make it the newer.  The other users (and those  */
+/*   whose travel is held), and the frame data when not set, keep what   */
+/*   was in the newer copy.                                              */
+static void _UserTravelPublish(vrContextInfo *context, int usernum, int frame_data)
+{
+	vrInputInfo	*inputs = context->input;
+	vrUserInfo	*user;
+	vrFrameData	*data;
+	unsigned long	seq;
+	int		slot;
+	int		count;
+
+	vrLockWriteSet(inputs->publish_lock);
+	seq = inputs->publish_seq + 1;
+	slot = (int)(seq & 1);
+
+	/* first tell the freeze that this copy is being overwritten */
+	inputs->publish_writing = seq;
+	__sync_synchronize();
+
+	for (count = 0; count < inputs->num_users; count++) {
+		user = inputs->users[count];
+		if (user == NULL)
+			continue;
+
+		/* NOTE: travel_held is checked under the data lock, as the held */
+		/*   changes can only be made after the flag is set -- so if it  */
+		/*   isn't, none of them have been made.                         */
+		vrLockReadSet(user->simdata_lock);
+		if ((usernum == VR_ALLUSERS || usernum == count) && !user->travel_held) {
+			user->pub_rw2vw[slot] = *(user->rw2vw_xform);
+			user->pub_vw2rw[slot] = *(user->vw2rw_xform);
+			user->travel_deferred = 0;
+		} else {
+			user->pub_rw2vw[slot] = user->pub_rw2vw[slot ^ 1];
+			user->pub_vw2rw[slot] = user->pub_vw2rw[slot ^ 1];
+			if (usernum == VR_ALLUSERS || usernum == count)
+				user->travel_deferred = 1;
+		}
+		vrLockReadRelease(user->simdata_lock);
+	}
+	for (data = inputs->frame_data; data != NULL; data = data->next)
+		memcpy(data->pub[slot], (frame_data ? data->back : data->pub[slot ^ 1]), data->size);
+
+	__sync_synchronize();
+	inputs->publish_seq = seq;
+	vrLockWriteRelease(inputs->publish_lock);
+}
+
+
+/************************************************************/
+/* _UserTravelChanged(): publish a change to the travel right away   */
+/*   (of only the users changed), unless vrFrame() is doing the       */
+/*   publishing, or the application is holding the travel lock (which */
+/*   publishes on its release).                                       */
+static void _UserTravelChanged(int usernum)
+{
+	int	count;
+
+	if (vrContext->input->publish_by_frame)
+		return;
+	for (count = 0; count < vrContext->input->num_users; count++) {
+		if ((usernum == VR_ALLUSERS || usernum == count) && vrContext->input->users[count]->travel_held)
+			return;
+	}
+	_UserTravelPublish(vrContext, usernum, 0);
+}
+
+
+/************************************************************/
+/* _UserTravelReleased(): publish the travel of the users whose lock */
+/*   was just released -- when vrFrame() does the publishing, only   */
+/*   if one of its publishes passed over their travel meanwhile.     */
+static void _UserTravelReleased(int usernum)
+{
+	int	count;
+
+	if (vrContext->input->publish_by_frame) {
+		for (count = 0; count < vrContext->input->num_users; count++) {
+			if ((usernum == VR_ALLUSERS || usernum == count) && vrContext->input->users[count]->travel_deferred)
+				break;
+		}
+		if (count == vrContext->input->num_users)
+			return;
+	}
+	_UserTravelPublish(vrContext, usernum, 0);
+}
+
+
 /************************************************************/
 /* NOTE: this function is to be called from the simulation process */
 int vrUserTravelReset(int usernum)
@@ -845,6 +963,8 @@ int vrUserTravelReset(int usernum)
 		vrLockWriteRelease(user_data->simdata_lock);
 	}
 
+	_UserTravelChanged(usernum);
+
 	return 0;
 }
 
@@ -875,13 +995,15 @@ int vrUserTravelTranslate3d(int usernum, double x, double y, double z)
 			usernum, vrContext->input->num_users);
 		return -1;
 	} else {
-		user_data = vrContext->input->users[count];
+		user_data = vrContext->input->users[usernum];
 		vrLockWriteSet(user_data->simdata_lock);
 		vrMatrixPostTranslate3d(user_data->vw2rw_xform,  x,  y,  z);
 		vrMatrixPreTranslate3d(user_data->rw2vw_xform,  -x, -y, -z);
 		vrLockWriteRelease(user_data->simdata_lock);
 	}
 
+	_UserTravelChanged(usernum);
+
 	return 0;
 }
 
@@ -934,7 +1056,7 @@ int vrUserTravelRotateId(int usernum, int axis, double theta)
 			usernum, vrContext->input->num_users);
 		return -1;
 	} else {
-		user_data = vrContext->input->users[count];
+		user_data = vrContext->input->users[usernum];
 		vrLockWriteSet(user_data->simdata_lock);
 		vrMatrixPreRotateId(user_data->rw2vw_xform, axis,  -theta);
 #if 0 /* 03/23/2007 (see above) */
@@ -945,6 +1067,8 @@ int vrUserTravelRotateId(int usernum, int axis, double theta)
 		vrLockWriteRelease(user_data->simdata_lock);
 	}
 
+	_UserTravelChanged(usernum);
+
 	return 0;
 }
 
@@ -989,18 +1113,20 @@ int vrUserTravelScale(int usernum, double scale)
 			usernum, vrContext->input->num_users);
 		return -1;
 	} else {
-		user_data = vrContext->input->users[count];
+		user_data = vrContext->input->users[usernum];
 		vrLockWriteSet(user_data->simdata_lock);
 #if 0 /* 03/23/2007 -- this should make this right (see above) */
 		vrMatrixPreScale3d(user_data->rw2vw_xform, scale, scale, scale);
 		vrMatrixInvertEuclidean(user_data->vw2rw_xform, user_data->rw2vw_xform);
 #else
 		vrMatrixPostScale3d(user_data->vw2rw_xform, scale, scale, scale);
-		vrMatrixPreScale3d(user_data->rw2vw_xform, scale, scale, scale);
+		vrMatrixPreScale3d(user_data->rw2vw_xform, scale_recip, scale_recip, scale_recip);
 #endif
 		vrLockWriteRelease(user_data->simdata_lock);
 	}
 
+	_UserTravelChanged(usernum);
+
 	return 0;
 }
 
@@ -1038,13 +1164,15 @@ int vrUserTravelTransformMatrix(int usernum, vrMatrix *mat)
 			usernum, vrContext->input->num_users);
 		return -1;
 	} else {
-		user_data = vrContext->input->users[count];
+		user_data = vrContext->input->users[usernum];
 		vrLockWriteSet(user_data->simdata_lock);
 		vrMatrixPreMult(user_data->rw2vw_xform, mat);
 		vrMatrixInvertEuclidean(user_data->vw2rw_xform, user_data->rw2vw_xform);
 		vrLockWriteRelease(user_data->simdata_lock);
 	}
 
+	_UserTravelChanged(usernum);
+
 	return 0;
 }
 
@@ -1062,6 +1190,7 @@ int vrUserTravelLockSet(int usernum)
 
 			user_data = vrContext->input->users[count];
 			vrLockWriteSet(user_data->app_lock);
+			user_data->travel_held = 1;
 		}
 	} else if (usernum < 0) {
 		vrErrPrintf(RED_TEXT "vrUserTravelLockSet(): invalid user number %d.\n" NORM_TEXT, usernum);
@@ -1071,8 +1200,9 @@ int vrUserTravelLockSet(int usernum)
 			usernum, vrContext->input->num_users);
 		return -1;
 	} else {
-		user_data = vrContext->input->users[count];
+		user_data = vrContext->input->users[usernum];
 		vrLockWriteSet(user_data->app_lock);
+		user_data->travel_held = 1;
 	}
 
 	return 0;
@@ -1091,6 +1221,7 @@ int vrUserTravelLockRelease(int usernum)
 			/* NOTE: we could just recursively call this function for each user */
 
 			user_data = vrContext->input->users[count];
+			user_data->travel_held = 0;
 			vrLockWriteRelease(user_data->app_lock);
 		}
 	} else if (usernum < 0) {
@@ -1101,14 +1232,266 @@ int vrUserTravelLockRelease(int usernum)
 			usernum, vrContext->input->num_users);
 		return -1;
 	} else {
-		user_data = vrContext->input->users[count];
+		user_data = vrContext->input->users[usernum];
+		user_data->travel_held = 0;
 		vrLockWriteRelease(user_data->app_lock);
 	}
 
+	_UserTravelReleased(usernum);
+
+	return 0;
+}
+
+
+/*********************************************************************/
+/* The travel batch functions do the same as the travel functions    */
+/*   above, but the operations are accumulated in the application's  */
+/*   own vrUserTravelBatch, and applied to the user's travel at once  */
+/*   by vrUserTravelBatchCommit() -- so navigation that makes several */
+/*   changes per frame takes the user's lock (and publishes, when not */
+/*   done by vrFrame()) once, rather than for each change.  Eg:       */
+/*                                                                   */
+/*	vrUserTravelBatch	batch;                                   */
+/*                                                                   */
+/*	vrUserTravelBatchBegin(&batch, VR_ALLUSERS);                     */
+/*	vrUserTravelBatchRotateId(&batch, VR_Y, yaw);                    */
+/*	vrUserTravelBatchTranslateAd(&batch, forward.v);                 */
+/*	vrUserTravelBatchCommit(&batch);                                 */
+/*                                                                   */
+/* As with a sequence of the travel functions, the operations are in */
+/*   the user's coordinate system, applied in the order given.        */
+/* NOTE: these functions are to be called from the simulation process */
+/*********************************************************************/
+
+/************************************************************/
+/* _UserTravelBatchClear(): empty the batch (for a new one, or after */
+/*   it's committed).                                                */
+static void _UserTravelBatchClear(vrUserTravelBatch *batch)
+{
+	batch->reset = 0;
+	batch->num_ops = 0;
+	vrMatrixSetIdentity(&(batch->post_vw2rw));
+	vrMatrixSetIdentity(&(batch->pre_rw2vw));
+}
+
+
+/************************************************************/
+int vrUserTravelBatchBegin(vrUserTravelBatch *batch, int usernum)
+{
+	_UserTravelBatchClear(batch);
+	batch->usernum = usernum;
+
+	if (usernum == VR_ALLUSERS) {
+		return 0;
+	} else if (usernum < 0) {
+		vrErrPrintf(RED_TEXT "vrUserTravelBatchBegin(): invalid user number %d.\n" NORM_TEXT, usernum);
+		batch->usernum = -1;
+		return -1;
+	} else if (usernum >= vrContext->input->num_users) {
+		vrErrPrintf(RED_TEXT "vrUserTravelBatchBegin(): invalid user number %d, only %d users.\n" NORM_TEXT,
+			usernum, vrContext->input->num_users);
+		batch->usernum = -1;
+		return -1;
+	}
+
+	return 0;
+}
+
+
+/************************************************************/
+int vrUserTravelBatchReset(vrUserTravelBatch *batch)
+{
+	_UserTravelBatchClear(batch);
+	batch->reset = 1;
+	batch->num_ops = 1;
+
+	return 0;
+}
+
+
+/************************************************************/
+/* _BatchPostMult3x3(): mat = mat * lin, where lin has only an upper-left */
+/*   3x3 part (a rotation or scale) -- only the first three columns of    */
+/*   mat change, so this skips most of a full matrix product.            */
+/* NOTE: the matrices are column-major (ala OpenGL): v[col*4 + row]      */
+static void _BatchPostMult3x3(vrMatrix *mat, vrMatrix *lin)
+{
+	double	col[12];
+	int	i, j, row;
+
+	memcpy(col, mat->v, sizeof(col));
+	for (i = 0; i < 3; i++) {
+		for (row = 0; row < 4; row++) {
+			mat->v[i*4 + row] = 0.0;
+			for (j = 0; j < 3; j++)
+				mat->v[i*4 + row] += col[j*4 + row] * lin->v[i*4 + j];
+		}
+	}
+}
+
+
+/************************************************************/
+/* _BatchPreMult3x3(): mat = lin * mat -- only the first three rows of */
+/*   mat change.                                                      */
+static void _BatchPreMult3x3(vrMatrix *mat, vrMatrix *lin)
+{
+	double	rows[3];
+	int	col, row, j;
+
+	for (col = 0; col < 4; col++) {
+		for (row = 0; row < 3; row++)
+			rows[row] = mat->v[col*4 + row];
+		for (row = 0; row < 3; row++) {
+			mat->v[col*4 + row] = 0.0;
+			for (j = 0; j < 3; j++)
+				mat->v[col*4 + row] += lin->v[j*4 + row] * rows[j];
+		}
+	}
+}
+
+
+/************************************************************/
+int vrUserTravelBatchTranslate3d(vrUserTravelBatch *batch, double x, double y, double z)
+{
+	vrMatrix	*post = &(batch->post_vw2rw);
+	vrMatrix	*pre = &(batch->pre_rw2vw);
+	int		row;
+	int		col;
+
+	/* post * T(x,y,z) -- only the translation column changes */
+	for (row = 0; row < 4; row++)
+		post->v[12 + row] += post->v[row] * x + post->v[4 + row] * y + post->v[8 + row] * z;
+
+	/* T(-x,-y,-z) * pre -- the bottom row is added into the others */
+	for (col = 0; col < 4; col++) {
+		pre->v[col*4 + VR_X] -= x * pre->v[col*4 + 3];
+		pre->v[col*4 + VR_Y] -= y * pre->v[col*4 + 3];
+		pre->v[col*4 + VR_Z] -= z * pre->v[col*4 + 3];
+	}
+	batch->num_ops++;
+
+	return 0;
+}
+
+
+/************************************************************/
+int vrUserTravelBatchTranslateAd(vrUserTravelBatch *batch, double *array)
+{
+	return vrUserTravelBatchTranslate3d(batch, array[VR_X], array[VR_Y], array[VR_Z]);
+}
+
+
+/************************************************************/
+int vrUserTravelBatchTranslateVec(vrUserTravelBatch *batch, vrVector *vec)
+{
+	return vrUserTravelBatchTranslate3d(batch, vec->v[VR_X], vec->v[VR_Y], vec->v[VR_Z]);
+}
+
+
+/************************************************************/
+int vrUserTravelBatchRotateId(vrUserTravelBatch *batch, int axis, double theta)
+{
+	vrMatrix	rotmat;
+
+	_BatchPreMult3x3(&(batch->pre_rw2vw), vrMatrixSetRotationId(&rotmat, axis, -theta));
+	_BatchPostMult3x3(&(batch->post_vw2rw), vrMatrixSetRotationId(&rotmat, axis,  theta));
+	batch->num_ops++;
+
 	return 0;
 }
 
 
+/************************************************************/
+/* NOTE: as with vrUserTravelScale(), only uniform scales are allowed. */
+int vrUserTravelBatchScale(vrUserTravelBatch *batch, double scale)
+{
+	double		scale_recip = 1.0 / scale;
+	int		count;
+
+	/* post * S -- the first three columns scale; S-1 * pre -- the first three rows */
+	for (count = 0; count < 12; count++)
+		batch->post_vw2rw.v[count] *= scale;
+	for (count = 0; count < 16; count++) {
+		if (count % 4 != 3)
+			batch->pre_rw2vw.v[count] *= scale_recip;
+	}
+	batch->num_ops++;
+
+	return 0;
+}
+
+
+/************************************************************/
+int vrUserTravelBatchTransformMatrix(vrUserTravelBatch *batch, vrMatrix *mat)
+{
+	vrMatrix	tmpmat;		/* for storing a modified version of the matrix if nece */
+	vrMatrix	invmat;
+
+	/* Test whether supplied matrix is Euclidean */
+	if (!vrMatrixIsEuclidean(mat)) {
+		vrErrPrintf("vrUserTravelBatchTransformMatrix(): " RED_TEXT "Matrix is not Euclidean!  Will be modified.\n" NORM_TEXT);
+		vrMatrixMakeEuclidean(&tmpmat, mat);
+		mat = &tmpmat;		/* Use the local copy of the matrix */
+	}
+
+	vrMatrixPreMult(&(batch->pre_rw2vw), mat);
+	vrMatrixPostMult(&(batch->post_vw2rw), vrMatrixInvertEuclidean(&invmat, mat));
+	batch->num_ops++;
+
+	return 0;
+}
+
+
+/************************************************************/
+/* vrUserTravelBatchCommit(): apply the batch to the user's travel (or */
+/*   that of all the users), and empty it for reuse.                   */
+int vrUserTravelBatchCommit(vrUserTravelBatch *batch)
+{
+	int		count;
+	vrUserInfo	*user_data;
+
+	if (batch->usernum < 0 && batch->usernum != VR_ALLUSERS) {
+		vrErrPrintf(RED_TEXT "vrUserTravelBatchCommit(): batch has no valid user.\n" NORM_TEXT);
+		return -1;
+	}
+	if (batch->num_ops == 0)
+		return 0;
+
+	for (count = 0; count < vrContext->input->num_users; count++) {
+		if (batch->usernum != VR_ALLUSERS && batch->usernum != count)
+			continue;
+
+		user_data = vrContext->input->users[count];
+		vrLockWriteSet(user_data->simdata_lock);
+		if (batch->reset) {
+			*(user_data->vw2rw_xform) = batch->post_vw2rw;
+			*(user_data->rw2vw_xform) = batch->pre_rw2vw;
+		} else {
+			vrMatrixPostMult(user_data->vw2rw_xform, &(batch->post_vw2rw));
+			vrMatrixPreMult(user_data->rw2vw_xform, &(batch->pre_rw2vw));
+		}
+		vrLockWriteRelease(user_data->simdata_lock);
+	}
+
+	_UserTravelChanged(batch->usernum);
+	_UserTravelBatchClear(batch);
+
+	return 0;
+}
+
+
+/************************************************************/
+/* vrUserTravelPublish(): publish the travel (and frame data) the  */
+/*   simulation made this frame -- from then on, the travel is only */
+/*   published here.                                                */
+/* NOTE: this function is called by vrFrame() in the simulation process */
+void vrUserTravelPublish(vrContextInfo *context)
+{
+	context->input->publish_by_frame = 1;
+	_UserTravelPublish(context, VR_ALLUSERS, 1);
+}
+
+
 /***************************************************************/
 /* NOTE: the user's copy of the head position matrix is copied */
 /*   from the "visren_position" field of the input because     */
@@ -1117,34 +1500,111 @@ int vrUserTravelLockRelease(int usernum)
 /*   head.  Also, there is no need to do a read-lock on this   */
 /*   field, since we know we're outside the area where that    */
 /*   field can be altered.                                     */
-/* NOTE: we could use vrMatrixCopy() instead of direct copies  */
-/*   from the "=" operator, but I don't know that that buys us */
-/*   anything.                                                 */
+/* NOTE: the travel is copied from the newer published copy, and */
+/*   no lock is needed for it either -- but if a publish began   */
+/*   writing over that copy while it was read (ie. two publishes */
+/*   happened during the copy), it's read again.                 */
 /* NOTE: this function is called by the library in the visual rendering */
 /*   process, but at a time when no visual rendering can occur.         */
 void vrUserTravelFreezeVisren(vrContextInfo *context)
 {
+	vrInputInfo	*inputs = context->input;
 	vrUserInfo	*user;
+	vrFrameData	*data;
+	unsigned long	seq;
+	int		slot;
 	int		count;
 
 	/***************************************************/
 	/* freeze all the user values for visual rendering */
-	for (count = 0; count < vrContext->input->num_users; count++) {
-		user = vrContext->input->users[count];
-		if (user != NULL) {
-			vrLockReadSet(user->app_lock);
-			vrLockReadSet(user->simdata_lock);
-			vrLockWriteSet(user->visren_lock);
+	for (count = 0; count < inputs->num_users; count++) {
+		user = inputs->users[count];
+		if (user != NULL)
 			*(user->visren_headpos) = *(user->head->visren_position);	/* NOTE: user->head is a 6-sensor input */
-			*(user->visren_rw2vw) = *(user->rw2vw_xform);
-			*(user->visren_vw2rw) = *(user->vw2rw_xform);
-			vrLockWriteRelease(user->visren_lock);
-			vrLockReadRelease(user->simdata_lock);
-			vrLockReadRelease(user->app_lock);
+	}
+
+	while (1) {
+		seq = inputs->publish_seq;
+		__sync_synchronize();
+		slot = (int)(seq & 1);
+
+		for (count = 0; count < inputs->num_users; count++) {
+			user = inputs->users[count];
+			if (user != NULL) {
+				*(user->visren_rw2vw) = user->pub_rw2vw[slot];
+				*(user->visren_vw2rw) = user->pub_vw2rw[slot];
+			}
 		}
+		for (data = inputs->frame_data; data != NULL; data = data->next)
+			memcpy(data->visren, data->pub[slot], data->size);
+
+		__sync_synchronize();
+		if (inputs->publish_writing <= seq + 1)
+			break;
+		inputs->freeze_rereads++;
 	}
 }
 
+
+/************************************************************/
+/* vrFrameDataCreate(): allocate a block of application data that is */
+/*   double-buffered like the travel: the simulation writes it via   */
+/*   vrFrameDataBack(), and the render callbacks read the copy       */
+/*   frozen for their frame via vrFrameDataVisren() -- no lock is    */
+/*   needed by either.  All copies begin zeroed.                     */
+/* NOTE: the data is published by each call to vrFrame(), so is only */
+/*   of use to applications that call it.                            */
+/* NOTE: this function is to be called after vrStart(), and the data */
+/*   is copied at every frame, so is best kept to what the rendering */
+/*   needs from the simulation.                                      */
+vrFrameData *vrFrameDataCreate(size_t size)
+{
+	vrInputInfo	*inputs;
+	vrFrameData	*data;
+	vrFrameData	**tail;
+
+	if (vrContext == NULL || vrContext->input == NULL) {
+		vrErrPrintf("vrFrameDataCreate(): " RED_TEXT "FreeVR must be started before creating frame data.\n" NORM_TEXT);
+		return NULL;
+	}
+	inputs = vrContext->input;
+
+	data = (vrFrameData *)vrShmemAlloc0(sizeof(vrFrameData));
+	data->size = size;
+	data->back = vrShmemAlloc0(size);
+	data->pub[0] = vrShmemAlloc0(size);
+	data->pub[1] = vrShmemAlloc0(size);
+	data->visren = vrShmemAlloc0(size);
+	data->next = NULL;
+
+	/* NOTE: the data is complete before it's put in the list, so the */
+	/*   freeze (which doesn't take the lock) can find it at any time. */
+	vrLockWriteSet(inputs->publish_lock);
+	for (tail = &(inputs->frame_data); *tail != NULL; tail = &((*tail)->next))
+		;
+	__sync_synchronize();
+	*tail = data;
+	vrLockWriteRelease(inputs->publish_lock);
+
+	return data;
+}
+
+
+/************************************************************/
+/* NOTE: this function is to be called from the simulation process */
+void *vrFrameDataBack(vrFrameData *data)
+{
+	return (data == NULL ? NULL : data->back);
+}
+
+
+/************************************************************/
+/* NOTE: this function is to be called from the render process */
+void *vrFrameDataVisren(vrFrameData *data)
+{
+	return (data == NULL ? NULL : data->visren);
+}
+
 	/**************************************************************/
 	/**************************************************************/
 
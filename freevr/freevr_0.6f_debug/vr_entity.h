@@ -58,8 +58,10 @@ typedef struct vrUserInfo_st {
 
 		/* Fields specific to Users */
 		vrLock		simdata_lock;	/* mutual exclusion lock for the user data */
-		vrLock		visren_lock;	/* lock for the visren sync'd copy of data -- this may now be redundant with app_lock */
+		vrLock		visren_lock;	/* lock for the visren sync'd copy of data -- no longer used, the copy is made from the published travel */
 		vrLock		app_lock;	/* lock for making application travel adjustments atomic */
+		int		travel_held;	/* flag set while the application holds app_lock (via vrUserTravelLockSet()) */
+		int		travel_deferred;/* flag set when a publish passed over the held travel -- it's then published on the lock's release */
 
 		/*************************************************************/
 		/* specific information necessary for visual/aural rendering */
@@ -95,6 +97,9 @@ typedef struct vrUserInfo_st {
 #endif
 		vrMatrix	*visren_vw2rw;	/* visren sync'd copy of vw2rw_xform */
 
+		vrMatrix	pub_rw2vw[2];	/* the two published copies of rw2vw_xform (see vrUserTravelPublish()) */
+		vrMatrix	pub_vw2rw[2];	/* the two published copies of vw2rw_xform */
+
 		/**************************************/
 		/* generic information about the user */
 		int		num_inputs;	/* CONFIG: The number of inputs associated with this user. */
@@ -134,6 +139,38 @@ typedef struct vrPropInfo_st {
 
 
 
+/**************************************************************/
+/* A block of application (simulation) data that is double-   */
+/*   buffered between the simulation and the visual rendering, */
+/*   like the users' travel: the simulation writes the "back"  */
+/*   copy, vrFrame() publishes it, and the freeze copies the   */
+/*   newest published copy to the "visren" copy, which the     */
+/*   render callbacks read (without a lock) for the frame.     */
+/**************************************************************/
+typedef struct vrFrameData_st {
+		size_t		size;		/* the size of each copy of the data */
+		void		*back;		/* the simulation's copy */
+		void		*pub[2];	/* the two published copies */
+		void		*visren;	/* the copy frozen for the visual rendering */
+	struct	vrFrameData_st	*next;		/* the next frame data in a linked list */
+	} vrFrameData;
+
+
+/**************************************************************/
+/* A batch of travel operations for a user (or all users),    */
+/*   accumulated by the application without any lock, and     */
+/*   then applied to the user's travel at once, with a single  */
+/*   lock of its data, by vrUserTravelBatchCommit().           */
+/**************************************************************/
+typedef struct {
+		int		usernum;	/* the user (or VR_ALLUSERS) the batch is for */
+		int		reset;		/* flag set when the batch replaces the travel, rather than adding to it */
+		int		num_ops;	/* the number of operations in the batch */
+		vrMatrix	post_vw2rw;	/* the user's vw2rw_xform is post-multiplied by this */
+		vrMatrix	pre_rw2vw;	/* the user's rw2vw_xform is pre-multiplied by this */
+	} vrUserTravelBatch;
+
+
 typedef struct vrEyeInfo_st {
 		/***************************/
 		/* Generic Object field(s) */
@@ -234,8 +271,22 @@ int		vrUserTravelScale(int usernum, double scale);
 int		vrUserTravelTransformMatrix(int usernum, vrMatrix *mat);
 int		vrUserTravelLockSet(int usernum);
 int		vrUserTravelLockRelease(int usernum);
+int		vrUserTravelBatchBegin(vrUserTravelBatch *batch, int usernum);
+int		vrUserTravelBatchReset(vrUserTravelBatch *batch);
+int		vrUserTravelBatchTranslate3d(vrUserTravelBatch *batch, double x, double y, double z);
+int		vrUserTravelBatchTranslateAd(vrUserTravelBatch *batch, double *array);
+int		vrUserTravelBatchTranslateVec(vrUserTravelBatch *batch, vrVector *vec);
+int		vrUserTravelBatchRotateId(vrUserTravelBatch *batch, int axis, double theta);
+int		vrUserTravelBatchScale(vrUserTravelBatch *batch, double scale);
+int		vrUserTravelBatchTransformMatrix(vrUserTravelBatch *batch, vrMatrix *mat);
+int		vrUserTravelBatchCommit(vrUserTravelBatch *batch);
+void		vrUserTravelPublish(vrContextInfo *context);
 void		vrUserTravelFreezeVisren(vrContextInfo *context);
 
+vrFrameData	*vrFrameDataCreate(size_t size);
+void		*vrFrameDataBack(vrFrameData *data);
+void		*vrFrameDataVisren(vrFrameData *data);
+
 #ifdef GFX_PERFORMER /* { */
 /***********************************************************************************/
 /* Utility functions that translate FreeVR coordinates in to Performer Z-up coords */
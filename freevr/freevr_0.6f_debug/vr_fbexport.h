@@ -0,0 +1,77 @@
+/* ======================================================================
+ *
+ * HH   HH         vr_fbexport.h
+ * HH   HH         Author(s): agent
+ * HHHHHHH         Created: October 19, 2026
+ * HH   HH         Last Modified: October 19, 2026
+ * HH   HH
+ *
+ * Header file describing the layout of the shared-memory framebuffer
+ *   export of a window (see the "export" window argument, and the telnet
+ *   "window[<num>] export" command).  This is the only FreeVR header a
+ *   program reading the exported frames (eg. a compositor or encoder)
+ *   needs -- see fbexportread.c for an example.
+ *
+ * The export is a POSIX shared-memory object (by default named
+ *   "/freevr-<window name>") holding a header, followed by a ring of
+ *   VR_FBEXPORT_SLOTS frames.  Each frame is the window's RGBA pixels,
+ *   bottom row first (as read by OpenGL).  The writer never waits for
+ *   a reader -- each new frame goes in the slot after the last, so a
+ *   reader that falls behind sees a gap in the sequence numbers.
+ *
+ * To read a frame in place (without copying it):
+ *	1. read "frame_seq" -- the sequence number of the newest frame
+ *	2. the frame is in slot (frame_seq % num_slots), if that slot's
+ *	   "seq" equals frame_seq
+ *	3. use the pixels
+ *	4. if the slot's "seq" no longer equals frame_seq, the writer has
+ *	   come around and overwritten the slot while it was in use
+ *	The "writer_alive" flag is cleared when the export is stopped, or
+ *	the window changes size -- then the object should be reopened.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#ifndef __VRFBEXPORT_H__
+#define __VRFBEXPORT_H__
+
+#include <stdint.h>
+
+
+#define	VR_FBEXPORT_MAGIC	0x46627646	/* "FvbF" */
+#define	VR_FBEXPORT_VERSION	1
+#define	VR_FBEXPORT_SLOTS	4		/* frames in the ring */
+
+
+/*******************************************************************/
+/* The state of one frame of the ring.                             */
+typedef struct {
+		volatile uint64_t seq;		/* the frame's sequence number (0 while it's being written) */
+		uint64_t	frame;		/* the frame number of the rendering process */
+		double		render_wtime;	/* wall time (secs since the epoch) the frame was read back */
+		double		publish_wtime;	/* wall time the frame was put in the slot */
+	} vrFBExportSlot;
+
+
+/*******************************************************************/
+/* The header at the beginning of the shared-memory object.        */
+typedef struct {
+		uint32_t	magic;		/* VR_FBEXPORT_MAGIC */
+		uint32_t	version;	/* VR_FBEXPORT_VERSION */
+		uint32_t	width;		/* the size of the frames (pixels) */
+		uint32_t	height;
+		uint32_t	bytes_per_pixel;/* 4 -- RGBA */
+		uint32_t	num_slots;	/* VR_FBEXPORT_SLOTS */
+		uint64_t	slot_size;	/* bytes of each frame */
+		uint64_t	slot_offset;	/* bytes from the start of the object to the first frame */
+		volatile uint32_t writer_alive;	/* 1 while frames are being written */
+		uint32_t	writer_pid;	/* the process writing the frames */
+		volatile uint64_t frame_seq;	/* sequence number of the newest complete frame (0 for none yet) */
+		vrFBExportSlot	slot[VR_FBEXPORT_SLOTS];
+	} vrFBExportHeader;
+
+
+/* the pixels of a slot */
+#define	VR_FBEXPORT_PIXELS(header, num)	((unsigned char *)(header) + (header)->slot_offset + (header)->slot_size * (num))
+
+#endif
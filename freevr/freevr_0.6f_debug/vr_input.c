@@ -18,6 +18,7 @@
 
 #include <string.h>   /* needed for string functions */
 #include <stdlib.h>   /* needed for atof(), and malloc, etc */
+#include <fcntl.h>    /* needed for open() of input recordings */
 #include "vr_input.h"
 #include "vr_callback.h"
 #include "vr_config.h"
@@ -39,6 +40,11 @@ static	vrProcessInfo	*proc_info = NULL;	/* NOTE: currently only used by the sign
 static	int		num_devices = 0;
 static	vrInputDevice	**devices = NULL;
 
+/* static (file-scope) globals for each process recording input assignments */
+static	int		record_fd = -1;		/* this process' descriptor of the recording file (-2 if unable to open) */
+static	int		record_num_named = 0;	/* size of the record_named array */
+static	char		*record_named = NULL;	/* flags of which input ids have been named in the recording by this process */
+
 
 /************************************************************************/
 /* function declarations of local-only functions called before defined. */
@@ -164,6 +170,13 @@ vrGenericInput *vrInputGetFromMapname(vrContextInfo *context, char *mapname)
 
 	/* TODO: should skip beginning whitespace */
 
+	/* most names will be found in the hash table */
+	return_value = vrInputLookupName(context->input, mapname);
+	if (return_value != NULL) {
+		vrDbgPrintfN(PARSE_DBGLVL, "vrInputGetFromMapname(%s) returning hashed %#p.\n", mapname, return_value);
+		return return_value;
+	}
+
 	if (!strncmp(mapname, "2-way[", 6)) {
 		index = vrAtoI(&mapname[6]);
 		if (index < 0 || index >= context->input->num_2ways)
@@ -436,6 +449,235 @@ vrGenericInput *vrInputGetFromTypeIndex(vrContextInfo *context, vrInputType type
 }
 
 
+	/************************************************************/
+	/************************************************************/
+	/****************** Hashed input name lookup *****************/
+
+
+/*****************************************************************/
+/* _InputHashString(): an FNV-1a hash of a name.  As with the    */
+/*   strncmp() tests of vrInputGetFromMapname(), case matters.    */
+/*   Zero is reserved to mark the empty slots of the table.       */
+static unsigned int _InputHashString(char *string)
+{
+	unsigned int	hash = 2166136261u;
+	unsigned char	c;
+
+	for (; *string != '\0'; string++) {
+		c = (unsigned char)*string;
+		hash ^= c;
+		hash *= 16777619u;
+	}
+
+	if (hash == 0)
+		hash = 1;
+
+	return hash;
+}
+
+
+/*****************************************************************/
+/* _InputHashInsert(): add a name to the table.  When the name is */
+/*   already there, the first entry stays -- so the order in      */
+/*   which names are inserted sets their priority.               */
+static void _InputHashInsert(vrInputHashTable *table, char *key, vrGenericInput *input)
+{
+	unsigned int	hash = _InputHashString(key);
+	int		mask = table->size - 1;
+	int		slot = hash & mask;
+
+	while (table->slots[slot].key != NULL) {
+		if (table->slots[slot].hash == hash && !strcmp(table->slots[slot].key, key)) {
+			vrDbgPrintfN(PARSE_DBGLVL, "_InputHashInsert(): name '%s' already refers to %#p, not %#p.\n",
+				key, table->slots[slot].input, input);
+			return;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	table->slots[slot].hash = hash;
+	table->slots[slot].key = vrShmemStrDup(key);
+	table->slots[slot].input = input;
+	table->num_keys++;
+}
+
+
+/*****************************************************************/
+/* _InputHashInsertType(): add one kind of name for all the inputs */
+/*   of one type.                                                  */
+static void _InputHashInsertType(vrInputHashTable *table, char *prefix, vrGenericInput **inputs, int num, int pass)
+{
+	char		key[512];
+	vrInput		*object;
+	int		count;
+
+	for (count = 0; count < num; count++) {
+		if (inputs[count] == NULL)
+			continue;
+
+		switch (pass) {
+		case 0:		/* the indexed names -- eg. "2switch[3]" */
+			sprintf(key, "%s[%d]", prefix, count);
+			_InputHashInsert(table, key, inputs[count]);
+			break;
+
+		case 1:		/* the input names from the configuration */
+			object = inputs[count]->my_object;
+			if (object != NULL && object->name != NULL)
+				_InputHashInsert(table, object->name, inputs[count]);
+			break;
+
+		case 2:		/* the "<device>:<input>" names */
+			object = inputs[count]->my_object;
+			if (object != NULL && object->name != NULL && inputs[count]->my_device != NULL
+					&& inputs[count]->my_device->name != NULL) {
+				snprintf(key, sizeof(key), "%s:%s", inputs[count]->my_device->name, object->name);
+				_InputHashInsert(table, key, inputs[count]);
+			}
+			break;
+		}
+	}
+}
+
+
+/*****************************************************************/
+/* vrInputHashNames(): (re)build the hash table of input names.    */
+/*   Every input of the input map is entered under three names:   */
+/*     - its indexed name (eg. "2switch[3]" or "6sensor[0]")      */
+/*     - its name from the configuration (eg. "6sensor[head]")    */
+/*     - its name qualified by its device (eg. "xwin:2switch[left]") */
+/*   The indexed names are entered first, so a configuration name */
+/*   that looks like an indexed name can't hide the indexed input. */
+/* NOTE: this is called by vrInputInitialize() once the input map */
+/*   is made, but should be called again if the map changes.      */
+void vrInputHashNames(vrInputInfo *vrInputs)
+{
+	vrInputHashTable	*table;
+	int			num_keys;
+	int			size;
+	int			pass;
+
+	num_keys = 3 * (vrInputs->num_2ways + vrInputs->num_Nways + vrInputs->num_valuators
+		+ vrInputs->num_6sensors + vrInputs->num_Nsensors + vrInputs->num_controls);
+
+	/* keep the table no more than half full, so the probes stay short */
+	for (size = 64; size < 2 * num_keys; size *= 2);
+
+	table = (vrInputHashTable *)vrShmemAlloc0(sizeof(vrInputHashTable) + size * sizeof(vrInputHashEntry));
+	table->size = size;
+	table->slots = (vrInputHashEntry *)(table + 1);
+
+	for (pass = 0; pass < 3; pass++) {
+		_InputHashInsertType(table, "2switch", (vrGenericInput **)vrInputs->switch2, vrInputs->num_2ways, pass);
+		_InputHashInsertType(table, "Nswitch", (vrGenericInput **)vrInputs->switchN, vrInputs->num_Nways, pass);
+		_InputHashInsertType(table, "valuator", (vrGenericInput **)vrInputs->valuator, vrInputs->num_valuators, pass);
+		_InputHashInsertType(table, "6sensor", (vrGenericInput **)vrInputs->sensor6, vrInputs->num_6sensors, pass);
+		_InputHashInsertType(table, "Nsensor", (vrGenericInput **)vrInputs->sensorN, vrInputs->num_Nsensors, pass);
+		_InputHashInsertType(table, "control", (vrGenericInput **)vrInputs->control, vrInputs->num_controls, pass);
+	}
+
+	/* publish the completed table */
+	/* NOTE: there's no telling whether another process is still */
+	/*   probing a previous table, so its memory is not reused.  */
+	vrMemoryBarrier();
+	vrInputs->name_hash = table;
+
+	vrDbgPrintfN(INPUT_DBGLVL, "vrInputHashNames(): %d input names hashed into %d slots.\n", table->num_keys, table->size);
+}
+
+
+/*****************************************************************/
+/* vrInputLookupName(): find an input by name in the hash table.  */
+/*   Returns NULL when the name is not in the table (or the table */
+/*   hasn't been made yet).                                       */
+vrGenericInput *vrInputLookupName(vrInputInfo *vrInputs, char *name)
+{
+	vrInputHashTable	*table;
+	vrInputHashEntry	*slots;
+	unsigned int		hash;
+	int			mask;
+	int			slot;
+
+	if (vrInputs == NULL || name == NULL)
+		return NULL;
+
+	table = vrInputs->name_hash;
+	if (table == NULL)
+		return NULL;
+	slots = table->slots;
+	mask = table->size - 1;
+
+	hash = _InputHashString(name);
+	for (slot = hash & mask; slots[slot].key != NULL; slot = (slot + 1) & mask) {
+		if (slots[slot].hash == hash && !strcmp(slots[slot].key, name))
+			return slots[slot].input;
+	}
+
+	return NULL;
+}
+
+
+/*****************************************************************/
+/* _InputGetHandle(): look up an input of the given type by name. */
+static vrGenericInput *_InputGetHandle(char *name, vrInputType type, char *function)
+{
+	vrGenericInput	*input;
+
+	if (name == NULL)
+		return NULL;
+
+	input = vrInputGetFromMapname(vrContext, name);
+	if (input == NULL) {
+		vrDbgPrintfN(CONFIG_WARN_DBGLVL, "%s(): no input named '%s'.\n", function, name);
+		return NULL;
+	}
+
+	if (input->input_type != type) {
+		vrDbgPrintfN(CONFIG_WARN_DBGLVL, "%s(): input '%s' is a %s, not a %s.\n",
+			function, name, vrInputTypeName(input->input_type), vrInputTypeName(type));
+		return NULL;
+	}
+
+	return input;
+}
+
+
+/*****************************************************************/
+/* The vrGet*Handle() functions resolve the name of an input once, */
+/*   so the frame loop can pass the returned handle to the         */
+/*   vrGet*Direct() and vrAssign*() functions instead of doing a   */
+/*   lookup for every access.  A handle remains valid for the life */
+/*   of the application.                                           */
+vr2switch *vrGet2switchHandle(char *name)
+{
+	return (vr2switch *)_InputGetHandle(name, VRINPUT_BINARY, "vrGet2switchHandle");
+}
+
+/*****************************************************************/
+vrNswitch *vrGetNswitchHandle(char *name)
+{
+	return (vrNswitch *)_InputGetHandle(name, VRINPUT_NWAY, "vrGetNswitchHandle");
+}
+
+/*****************************************************************/
+vrValuator *vrGetValuatorHandle(char *name)
+{
+	return (vrValuator *)_InputGetHandle(name, VRINPUT_VALUATOR, "vrGetValuatorHandle");
+}
+
+/*****************************************************************/
+vr6sensor *vrGet6sensorHandle(char *name)
+{
+	return (vr6sensor *)_InputGetHandle(name, VRINPUT_6SENSOR, "vrGet6sensorHandle");
+}
+
+/*****************************************************************/
+vrNsensor *vrGetNsensorHandle(char *name)
+{
+	return (vrNsensor *)_InputGetHandle(name, VRINPUT_NSENSOR, "vrGetNsensorHandle");
+}
+
+
 /*****************************************************************/
 void vrFprintInputObject(FILE *file, vrInput *inobj, vrPrintStyle style)
 {
@@ -1361,6 +1603,9 @@ void vrInputInitialize(vrContextInfo *context)
 	vrInputs->input_map_name = vrConfig->input_map_name;
 	vrCreateInputMap(vrInputs, vrInputs->input_map_name);
 
+	/* Make the table for looking up the inputs by name */
+	vrInputHashNames(vrInputs);
+
 	vrConfig->inputs_init = 1;
 
 	vrTrace("vrInputInitialize():", BOLD_TEXT "exiting." NORM_TEXT);
@@ -2600,6 +2845,123 @@ vrPrintf(RED_TEXT "LD_LIBRARYN32_PATH is '%s'\n", getenv("LD_LIBRARYN32_PATH"));
 }
 
 
+	/************************************************************/
+	/************************************************************/
+	/*************** Input assignment versioning ****************/
+
+
+/**************************************************************************/
+/* _InputCountAssignment(): bump the overall count of input assignments,  */
+/*   which serves as the version number of the input values for the       */
+/*   lock-free snapshots (see vrInputSnapshotTake()).  Inputs are         */
+/*   assigned from several processes, so the increment must be atomic.    */
+static void _InputCountAssignment()
+{
+	if (vrContext->input != NULL)
+		vrAtomicIncrement(&(vrContext->input->assign_count));
+}
+
+
+	/************************************************************/
+	/************************************************************/
+	/**************** Input assignment recording ****************/
+
+
+/**************************************************************************/
+/* vrInputRecordStart(): begin a recording of all input assignments to    */
+/*   the given file.  This must be called (by the main process) prior to  */
+/*   spawning the input processes, since it (re)creates the file and puts */
+/*   the header in place.  Each process then opens the file for itself    */
+/*   the first time it records an assignment.                             */
+void vrInputRecordStart(vrContextInfo *context, char *filename)
+{
+	vrInputRecordHeader	header;
+	FILE			*file;
+
+	if (filename == NULL || filename[0] == '\0')
+		return;
+
+	file = fopen(filename, "wb");
+	if (file == NULL) {
+		vrErrPrintf("vrInputRecordStart(): " RED_TEXT "Unable to open '%s' for recording inputs.\n" NORM_TEXT, filename);
+		return;
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, VRINPUT_RECORD_MAGIC, sizeof(header.magic));
+	header.version = VRINPUT_RECORD_VERSION;
+	header.start_wtime = vrCurrentWallTime();
+	fwrite(&header, sizeof(header), 1, file);
+	fclose(file);
+
+	context->input->record_wtime = header.start_wtime;
+	context->input->record_file = vrShmemStrDup(filename);
+
+	vrDbgPrintfN(ALWAYS_DBGLVL, "vrInputRecordStart(): Recording all input assignments to '%s'.\n", filename);
+}
+
+
+/**************************************************************************/
+/* _InputRecordAssignment(): append the newly assigned value of an input  */
+/*   to the recording.  Each record is sent with a single write() to a    */
+/*   file opened for appending, so records from several processes won't  */
+/*   be interleaved.                                                      */
+static void _InputRecordAssignment(vrGenericInput *input, void *data, int size)
+{
+	char		buffer[sizeof(vrInputRecord) + VRINPUT_RECORD_MAXDATA];
+	vrInputRecord	*record = (vrInputRecord *)buffer;
+	vrInput		*object = input->my_object;
+	int		name_len;
+
+	/* the common case: no recording */
+	if (vrContext->input == NULL || vrContext->input->record_file == NULL)
+		return;
+
+	if (object == NULL || size > VRINPUT_RECORD_MAXDATA)
+		return;
+
+	/* open the recording for this process */
+	if (record_fd == -1) {
+		record_fd = open(vrContext->input->record_file, O_WRONLY | O_APPEND);
+		if (record_fd < 0) {
+			vrErrPrintf("_InputRecordAssignment(): " RED_TEXT "Unable to open '%s' -- not recording inputs of this process.\n" NORM_TEXT,
+				vrContext->input->record_file);
+			record_fd = -2;
+		}
+	}
+	if (record_fd < 0)
+		return;
+
+	record->wtime = vrCurrentWallTime() - vrContext->input->record_wtime;
+	record->id = object->id;
+	record->type = (char)input->input_type;
+
+	/* name this input the first time it is recorded by this process */
+	if (object->id >= record_num_named) {
+		int	new_num = object->id + 64;
+
+		record_named = (char *)realloc(record_named, new_num);
+		memset(record_named + record_num_named, 0, new_num - record_num_named);
+		record_num_named = new_num;
+	}
+	if (!record_named[object->id]) {
+		name_len = strlen(object->name);
+		if (name_len > VRINPUT_RECORD_MAXDATA)
+			name_len = VRINPUT_RECORD_MAXDATA;
+		record->kind = VRINPUT_RECORD_NAME;
+		record->size = name_len;
+		memcpy(buffer + sizeof(vrInputRecord), object->name, name_len);
+		write(record_fd, buffer, sizeof(vrInputRecord) + name_len);
+		record_named[object->id] = 1;
+	}
+
+	record->kind = VRINPUT_RECORD_VALUE;
+	record->size = size;
+	memcpy(buffer + sizeof(vrInputRecord), data, size);
+	write(record_fd, buffer, sizeof(vrInputRecord) + size);
+}
+
+
 	/************************************************************/
 	/************************************************************/
 	/************ Generic input type access function ************/
@@ -2817,8 +3179,12 @@ vrPrintf("switch %p is getting new value %d\n", switch2, assign_value);
 		vrLockWriteSet(switch2->lock);
 		switch2->timestamp = 0.0;		/* TODO: assign timestamp */
 		switch2->value = assign_value;
+		switch2->visren_stale = 1;
+		_InputCountAssignment();
 		vrLockWriteRelease(switch2->lock);
 
+		_InputRecordAssignment((vrGenericInput *)switch2, &assign_value, sizeof(int));
+
 		if (switch2->queue_me) {
 			/* TODO: put me in the queue */
 		}
@@ -3009,8 +3375,12 @@ void vrAssignNswitchValue(vrNswitch *switchN, int newvalue /* , vrTime time */)
 		vrLockWriteSet(switchN->lock);
 		switchN->timestamp = 0.0;		/* TODO: assign timestamp */
 		switchN->value = newvalue;
+		switchN->visren_stale = 1;
+		_InputCountAssignment();
 		vrLockWriteRelease(switchN->lock);
 
+		_InputRecordAssignment((vrGenericInput *)switchN, &newvalue, sizeof(int));
+
 		if (switchN->queue_me) {
 			/* TODO: put me in the queue */
 		}
@@ -3106,9 +3476,45 @@ int vrGetNswitchDelta(int input_num)
 }
 
 /**********************************************************************/
-int vrGetNswitchValueDirect(vr2switch *input) { return -10; }
+int vrGetNswitchValueDirect(vrNswitch *input)
+{
+	int		value;
+
+	if (input == NULL) {
+		if (vrDbgDo(CONFIG_WARN_DBGLVL)) {
+			vrErrPrintf("vrGetNswitchValueDirect(): Invalid NULL N-way input.\n");
+		}
+		return 0;
+	}
+	vrLockReadSet(input->lock);
+	value = input->value;
+	vrLockReadToWrite(input->lock);
+	input->last_value = value;
+	vrLockWriteRelease(input->lock);
+
+	return value;
+}
+
+
 /**********************************************************************/
-int vrGetNswitchDeltaDirect(vr2switch *input) { return -10; }
+int vrGetNswitchDeltaDirect(vrNswitch *input)
+{
+	int		delta;
+
+	if (input == NULL) {
+		if (vrDbgDo(CONFIG_WARN_DBGLVL)) {
+			vrErrPrintf("vrGetNswitchDeltaDirect(): Invalid NULL N-way input.\n");
+		}
+		return 0;
+	}
+	vrLockReadSet(input->lock);
+	delta = input->value - input->last_value;
+	vrLockReadToWrite(input->lock);
+	input->last_value = input->value;
+	vrLockWriteRelease(input->lock);
+
+	return delta;
+}
 
 
 	/**************************************************************/
@@ -3135,8 +3541,12 @@ void vrAssignValuatorValue(vrValuator *valuator, float newvalue /* , vrTime time
 		vrLockWriteSet(valuator->lock);
 		valuator->timestamp = 0.0;		/* TODO: assign timestamp */
 		valuator->value = newvalue;
+		valuator->visren_stale = 1;
+		_InputCountAssignment();
 		vrLockWriteRelease(valuator->lock);
 
+		_InputRecordAssignment((vrGenericInput *)valuator, &newvalue, sizeof(float));
+
 		if (valuator->queue_me) {
 			/* TODO: put me in the queue */
 		}
@@ -3250,9 +3660,45 @@ float vrGetValuatorDelta(int input_num)
 
 
 /**********************************************************************/
-float vrGetValuatorValueDirect(vrValuator *input) { return -10.0; }
+float vrGetValuatorValueDirect(vrValuator *input)
+{
+	float		value;
+
+	if (input == NULL) {
+		if (vrDbgDo(CONFIG_WARN_DBGLVL)) {
+			vrErrPrintf("vrGetValuatorValueDirect(): Invalid NULL Valuator input.\n");
+		}
+		return 0.0;
+	}
+	vrLockReadSet(input->lock);
+	value = input->value;
+	vrLockReadToWrite(input->lock);
+	input->last_value = value;
+	vrLockWriteRelease(input->lock);
+
+	return value;
+}
+
+
 /**********************************************************************/
-float vrGetValuatorDeltaDirect(vrValuator *input) { return -10.0; }
+float vrGetValuatorDeltaDirect(vrValuator *input)
+{
+	float		delta;
+
+	if (input == NULL) {
+		if (vrDbgDo(CONFIG_WARN_DBGLVL)) {
+			vrErrPrintf("vrGetValuatorDeltaDirect(): Invalid NULL Valuator input.\n");
+		}
+		return 0.0;
+	}
+	vrLockReadSet(input->lock);
+	delta = input->value - input->last_value;
+	vrLockReadToWrite(input->lock);
+	input->last_value = input->value;
+	vrLockWriteRelease(input->lock);
+
+	return delta;
+}
 
 
 	/**************************************************************/
@@ -3310,6 +3756,8 @@ static	char		*skip_chars = " \t\n\r\b,";
 /*   flag.                                                               */
 void vrAssign6sensorValue(vr6sensor *sensor6, vrMatrix *new_mat, int oob /* , vrTime time */)
 {
+	char	record_data[sizeof(int) + sizeof(vrMatrix)];	/* the value as recorded (see below) */
+	int	recording;
 	if (sensor6->object_type != VROBJECT_INPUTDATA) {
 		vrDbgPrintf("Attempt to assign a position sensor value to a non-input object type %d at %#p\n", sensor6->object_type, sensor6);
 		return;
@@ -3338,9 +3786,15 @@ void vrAssign6sensorValue(vr6sensor *sensor6, vrMatrix *new_mat, int oob /* , vr
 
 		/* assume (for now) value has changed */
 		vrLockWriteSet(sensor6->lock);
+
+		/* bump the sequence counter to odd so lockless readers know */
+		/*   the data is in flux (see vrMatrixGet6sensorValuesLatched()). */
+		sensor6->sequence++;
+		vrMemoryBarrier();
+
 		if (oob >= 0)
 			sensor6->oob = oob;
-		sensor6->timestamp = 0.0;		/* TODO: assign timestamp */
+		sensor6->timestamp = vrCurrentWallTime();	/* TODO: use the device's own timestamp when available */
 		vrMatrixCopy(sensor6->raw_data, new_mat);
 
 #if 0
@@ -3377,8 +3831,28 @@ void vrAssign6sensorValue(vr6sensor *sensor6, vrMatrix *new_mat, int oob /* , vr
 		incoming_sensor6.frame_of_reference = 0;  /* TODO: set this to world space */
 #endif
 
+		/* back to even -- the new value is complete */
+		vrMemoryBarrier();
+		sensor6->sequence++;
+		sensor6->visren_stale = 1;
+		_InputCountAssignment();
+
+		/* NOTE: we record the real-world position, so a replay  */
+		/*   doesn't depend on the transforms of the original    */
+		/*   device -- ie. replayed sensors s/b identity xforms. */
+		/*   It's copied while still locked, so it's this value, */
+		/*   and the file is written after the release.          */
+		recording = (vrContext->input != NULL && vrContext->input->record_file != NULL);
+		if (recording) {
+			memcpy(record_data, &sensor6->oob, sizeof(int));
+			memcpy(record_data + sizeof(int), sensor6->position, sizeof(vrMatrix));
+		}
+
 		vrLockWriteRelease(sensor6->lock);
 
+		if (recording)
+			_InputRecordAssignment((vrGenericInput *)sensor6, record_data, sizeof(record_data));
+
 		if (sensor6->queue_me) {
 			/* TODO: put me in the queue */
 		}
@@ -3860,6 +4334,57 @@ vrErrPrintf("aborting until a better solution is determined\n"); abort();
 }
 
 
+/**********************************************************************/
+/* vrMatrixGet6sensorValuesLatched(): get the newest value of a        */
+/*   6-sensor without taking its lock.  This is intended for the       */
+/*   rendering processes to "late-latch" the head position just prior  */
+/*   to rendering, so the read must never block on the input process.  */
+/*   The sequence counter is odd while vrAssign6sensorValue() is       */
+/*   writing, and changes when a write completes, so the read is       */
+/*   retried until a consistent copy is made.  If the writer is just   */
+/*   too busy, we give up and wait for the lock like everyone else.    */
+/* The time at which the value was assigned is returned in timestamp  */
+/*   (when not NULL).                                                  */
+vrMatrix *vrMatrixGet6sensorValuesLatched(vrMatrix *mat, vr6sensor *input, vrTime *timestamp)
+{
+	unsigned int	sequence;
+	vrTime		time;
+	int		tries;
+
+	if (input == NULL) {
+		vrErrPrintf("vrMatrixGet6sensorValuesLatched(): Invalid NULL Position Sensor.\n");
+		vrMatrixSetIdentity(mat);
+		return mat;
+	}
+
+	for (tries = 0; tries < 16; tries++) {
+		sequence = input->sequence;
+		vrMemoryBarrier();
+		if (sequence & 0x01)
+			continue;		/* a write is in progress */
+
+		vrMatrixCopy(mat, input->position);
+		time = input->timestamp;
+
+		vrMemoryBarrier();
+		if (sequence == input->sequence) {
+			if (timestamp != NULL)
+				*timestamp = time;
+			return mat;
+		}
+	}
+
+	/* couldn't get a clean read, so fall back to the locked read */
+	vrLockReadSet(input->lock);
+	vrMatrixCopy(mat, input->position);
+	if (timestamp != NULL)
+		*timestamp = input->timestamp;
+	vrLockReadRelease(input->lock);
+
+	return mat;
+}
+
+
 /**********************************************************************/
 vrMatrix *vrMatrixGet6sensorRawValuesDirect(vrMatrix *mat, vr6sensor *input)
 {
@@ -4084,6 +4609,11 @@ void vrAssignNsensorArray(vrNsensor *sensorN, float *new_data /* , vrTime time *
 
 		/* assume (for now) value has changed */
 		vrLockWriteSet(sensorN->lock);
+
+		/* odd sequence while the values are in flux (see vrInputSnapshotTake()) */
+		sensorN->sequence++;
+		vrMemoryBarrier();
+
 		sensorN->timestamp = 0.0;		/* TODO: assign timestamp */
 		memcpy(sensorN->values, new_data, sensorN->dof * sizeof(float));
 
@@ -4099,8 +4629,14 @@ void vrAssignNsensorArray(vrNsensor *sensorN, float *new_data /* , vrTime time *
 		sensorN.frame_of_reference = 0;  /* ?? TODO: set this to world space */
 #endif
 
+		vrMemoryBarrier();
+		sensorN->sequence++;
+		sensorN->visren_stale = 1;
+		_InputCountAssignment();
 		vrLockWriteRelease(sensorN->lock);
 
+		_InputRecordAssignment((vrGenericInput *)sensorN, new_data, sensorN->dof * sizeof(float));
+
 		if (sensorN->queue_me) {
 			/* TODO: put me in the queue */
 		}
@@ -4506,6 +5042,229 @@ static	vrMatrix	mat_pos90x = { 1.0,0.0,0.0,0.0,  0.0,0.0,1.0,0.0,  0.0,-1.0,0.0,
 #endif /* GFX_PERFORMER } */
 
 
+	/**************************************************************/
+	/**************************************************************/
+	/***************** Whole-frame input snapshots ****************/
+
+
+/**********************************************************************/
+/* _InputSnapshotResize(): make sure the snapshot arrays have room for */
+/*   all the current inputs (the number of inputs can grow when dummy  */
+/*   inputs are added to the input map).                               */
+static void _InputSnapshotResize(vrInputSnapshot *snapshot, vrInputInfo *vrInputs)
+{
+	if (snapshot->num_2ways != vrInputs->num_2ways) {
+		snapshot->num_2ways = vrInputs->num_2ways;
+		snapshot->switch2 = (int *)realloc(snapshot->switch2, snapshot->num_2ways * sizeof(int));
+		snapshot->switch2_last = (int *)realloc(snapshot->switch2_last, snapshot->num_2ways * sizeof(int));
+		memset(snapshot->switch2, 0, snapshot->num_2ways * sizeof(int));
+		memset(snapshot->switch2_last, 0, snapshot->num_2ways * sizeof(int));
+	}
+
+	if (snapshot->num_Nways != vrInputs->num_Nways) {
+		snapshot->num_Nways = vrInputs->num_Nways;
+		snapshot->switchN = (int *)realloc(snapshot->switchN, snapshot->num_Nways * sizeof(int));
+		snapshot->switchN_last = (int *)realloc(snapshot->switchN_last, snapshot->num_Nways * sizeof(int));
+		memset(snapshot->switchN, 0, snapshot->num_Nways * sizeof(int));
+		memset(snapshot->switchN_last, 0, snapshot->num_Nways * sizeof(int));
+	}
+
+	if (snapshot->num_valuators != vrInputs->num_valuators) {
+		snapshot->num_valuators = vrInputs->num_valuators;
+		snapshot->valuator = (float *)realloc(snapshot->valuator, snapshot->num_valuators * sizeof(float));
+		snapshot->valuator_last = (float *)realloc(snapshot->valuator_last, snapshot->num_valuators * sizeof(float));
+		memset(snapshot->valuator, 0, snapshot->num_valuators * sizeof(float));
+		memset(snapshot->valuator_last, 0, snapshot->num_valuators * sizeof(float));
+	}
+
+	if (snapshot->num_6sensors != vrInputs->num_6sensors) {
+		snapshot->num_6sensors = vrInputs->num_6sensors;
+		snapshot->sensor6 = (vrMatrix *)realloc(snapshot->sensor6, snapshot->num_6sensors * sizeof(vrMatrix));
+		snapshot->sensor6_oob = (int *)realloc(snapshot->sensor6_oob, snapshot->num_6sensors * sizeof(int));
+	}
+
+	if (snapshot->num_Nsensors != vrInputs->num_Nsensors) {
+		snapshot->num_Nsensors = vrInputs->num_Nsensors;
+		snapshot->sensorN = (float *)realloc(snapshot->sensorN, snapshot->num_Nsensors * MAX_NSENSOR_VALUES * sizeof(float));
+		memset(snapshot->sensorN, 0, snapshot->num_Nsensors * MAX_NSENSOR_VALUES * sizeof(float));
+	}
+
+	/* the contents no longer match the version, so force a capture */
+	snapshot->consistent = 0;
+}
+
+
+/**********************************************************************/
+/* _InputSnapshotCopy(): copy every input value into the snapshot.     */
+/*   The scalar inputs are single words, and are simply read.  The     */
+/*   6-sensors and N-sensors use their sequence counters to get a      */
+/*   clean copy, falling back to their lock should a writer be too     */
+/*   busy for that.                                                    */
+static void _InputSnapshotCopy(vrInputSnapshot *snapshot, vrInputInfo *vrInputs)
+{
+	vr6sensor	*sensor6;
+	vrNsensor	*sensorN;
+	float		*values;
+	unsigned int	sequence;
+	int		count;
+	int		tries;
+
+	for (count = 0; count < snapshot->num_2ways; count++) {
+		if (vrInputs->switch2[count] != NULL)
+			snapshot->switch2[count] = vrInputs->switch2[count]->value;
+	}
+
+	for (count = 0; count < snapshot->num_Nways; count++) {
+		if (vrInputs->switchN[count] != NULL)
+			snapshot->switchN[count] = vrInputs->switchN[count]->value;
+	}
+
+	for (count = 0; count < snapshot->num_valuators; count++) {
+		if (vrInputs->valuator[count] != NULL)
+			snapshot->valuator[count] = vrInputs->valuator[count]->value;
+	}
+
+	for (count = 0; count < snapshot->num_6sensors; count++) {
+		sensor6 = vrInputs->sensor6[count];
+		if (sensor6 == NULL) {
+			vrMatrixSetIdentity(&(snapshot->sensor6[count]));
+			snapshot->sensor6_oob[count] = 1;
+			continue;
+		}
+		vrMatrixGet6sensorValuesLatched(&(snapshot->sensor6[count]), sensor6, NULL);
+		snapshot->sensor6_oob[count] = sensor6->oob;
+	}
+
+	for (count = 0; count < snapshot->num_Nsensors; count++) {
+		sensorN = vrInputs->sensorN[count];
+		if (sensorN == NULL)
+			continue;
+		values = &(snapshot->sensorN[count * MAX_NSENSOR_VALUES]);
+
+		for (tries = 0; tries < 16; tries++) {
+			sequence = sensorN->sequence;
+			vrMemoryBarrier();
+			if (sequence & 0x01)
+				continue;		/* a write is in progress */
+
+			memcpy(values, sensorN->values, sensorN->dof * sizeof(float));
+
+			vrMemoryBarrier();
+			if (sequence == sensorN->sequence)
+				break;
+		}
+		if (tries == 16) {
+			vrLockReadSet(sensorN->lock);
+			memcpy(values, sensorN->values, sensorN->dof * sizeof(float));
+			vrLockReadRelease(sensorN->lock);
+		}
+	}
+}
+
+
+/**********************************************************************/
+/* vrInputSnapshotCreate(): allocate a snapshot for the calling process. */
+/*   The snapshot is in regular (not shared) memory, since it is only  */
+/*   meant for the process that takes it.                              */
+vrInputSnapshot *vrInputSnapshotCreate()
+{
+	vrInputSnapshot	*snapshot;
+
+	snapshot = (vrInputSnapshot *)calloc(1, sizeof(vrInputSnapshot));
+	if (snapshot == NULL) {
+		vrErrPrintf("vrInputSnapshotCreate(): " RED_TEXT "Unable to allocate an input snapshot.\n" NORM_TEXT);
+		return NULL;
+	}
+
+	vrInputSnapshotTake(snapshot);
+
+	return snapshot;
+}
+
+
+/**********************************************************************/
+/* vrInputSnapshotTake(): capture all the current input values into    */
+/*   the snapshot, without taking any of the input locks.  The count   */
+/*   of input assignments is checked before and after the copy -- if   */
+/*   they match, no assignment completed in between, and the snapshot  */
+/*   is consistent.  Otherwise the copy is retried a few times before  */
+/*   settling for a snapshot that is merely current.                   */
+/* Returns 1 when any input has been assigned since the previous       */
+/*   snapshot, and 0 when nothing has changed (in which case the       */
+/*   values are not copied at all, and all the deltas become zero).    */
+int vrInputSnapshotTake(vrInputSnapshot *snapshot)
+{
+	vrInputInfo	*vrInputs;
+	unsigned int	version;
+	int		tries;
+
+	if (snapshot == NULL)
+		return 0;
+
+	vrInputs = vrContext->input;
+	if (vrInputs == NULL)
+		return 0;
+
+	/* the current values become the previous values */
+	memcpy(snapshot->switch2_last, snapshot->switch2, snapshot->num_2ways * sizeof(int));
+	memcpy(snapshot->switchN_last, snapshot->switchN, snapshot->num_Nways * sizeof(int));
+	memcpy(snapshot->valuator_last, snapshot->valuator, snapshot->num_valuators * sizeof(float));
+
+	if (snapshot->num_2ways != vrInputs->num_2ways || snapshot->num_Nways != vrInputs->num_Nways
+			|| snapshot->num_valuators != vrInputs->num_valuators
+			|| snapshot->num_6sensors != vrInputs->num_6sensors
+			|| snapshot->num_Nsensors != vrInputs->num_Nsensors) {
+		_InputSnapshotResize(snapshot, vrInputs);
+	}
+
+	snapshot->wtime = vrCurrentWallTime();
+
+	version = vrInputs->assign_count;
+	vrMemoryBarrier();
+	if (version == snapshot->version && snapshot->consistent)
+		return 0;
+
+	for (tries = 0; tries < 4; tries++) {
+		_InputSnapshotCopy(snapshot, vrInputs);
+
+		vrMemoryBarrier();
+		if (version == vrInputs->assign_count) {
+			snapshot->version = version;
+			snapshot->consistent = 1;
+			return 1;
+		}
+		version = vrInputs->assign_count;
+		vrMemoryBarrier();
+	}
+
+	/* the inputs are too busy for a consistent copy, so go with what we have */
+	snapshot->version = version;
+	snapshot->consistent = 0;
+	vrDbgPrintfN(INPUT_DBGLVL, "vrInputSnapshotTake(): unable to make a consistent snapshot after %d tries.\n", tries);
+
+	return 1;
+}
+
+
+/**********************************************************************/
+void vrInputSnapshotFree(vrInputSnapshot *snapshot)
+{
+	if (snapshot == NULL)
+		return;
+
+	free(snapshot->switch2);
+	free(snapshot->switch2_last);
+	free(snapshot->switchN);
+	free(snapshot->switchN_last);
+	free(snapshot->valuator);
+	free(snapshot->valuator_last);
+	free(snapshot->sensor6);
+	free(snapshot->sensor6_oob);
+	free(snapshot->sensorN);
+	free(snapshot);
+}
+
+
 	/**************************************************************/
 	/**************************************************************/
 
@@ -4520,14 +5279,28 @@ void vrInputFreezeVisren(vrContextInfo *context)
 {
 	vrInputInfo	*vrInputs = context->input;
 	int		count;
+	int		copied = 0;
+	int		skipped = 0;
+
+	/* NOTE: each of the vrAssign*() functions flags its input as     */
+	/*   "visren_stale", so only inputs assigned since the previous   */
+	/*   freeze need to be locked and copied.  The flag is checked    */
+	/*   without the lock -- if an assignment is just now being made, */
+	/*   it will simply be caught by the next freeze.                 */
 
 	/*************************/
 	/* freeze all the 2-ways */
 	for (count = 0; count < vrInputs->num_2ways; count++) {
 		if (vrInputs->switch2[count] != NULL) {
+			if (!vrInputs->switch2[count]->visren_stale) {
+				skipped++;
+				continue;
+			}
 			vrLockWriteSet(vrInputs->switch2[count]->lock);
 			vrInputs->switch2[count]->visren_value = vrInputs->switch2[count]->value;
+			vrInputs->switch2[count]->visren_stale = 0;
 			vrLockWriteRelease(vrInputs->switch2[count]->lock);
+			copied++;
 		}
 	}
 
@@ -4535,9 +5308,15 @@ void vrInputFreezeVisren(vrContextInfo *context)
 	/* freeze all the N-ways */
 	for (count = 0; count < vrInputs->num_Nways; count++) {
 		if (vrInputs->switchN[count] != NULL) {
+			if (!vrInputs->switchN[count]->visren_stale) {
+				skipped++;
+				continue;
+			}
 			vrLockWriteSet(vrInputs->switchN[count]->lock);
 			vrInputs->switchN[count]->visren_value = vrInputs->switchN[count]->value;
+			vrInputs->switchN[count]->visren_stale = 0;
 			vrLockWriteRelease(vrInputs->switchN[count]->lock);
+			copied++;
 		}
 	}
 
@@ -4545,9 +5324,15 @@ void vrInputFreezeVisren(vrContextInfo *context)
 	/* freeze all the valuators */
 	for (count = 0; count < vrInputs->num_valuators; count++) {
 		if (vrInputs->valuator[count] != NULL) {
+			if (!vrInputs->valuator[count]->visren_stale) {
+				skipped++;
+				continue;
+			}
 			vrLockWriteSet(vrInputs->valuator[count]->lock);
 			vrInputs->valuator[count]->visren_value = vrInputs->valuator[count]->value;
+			vrInputs->valuator[count]->visren_stale = 0;
 			vrLockWriteRelease(vrInputs->valuator[count]->lock);
+			copied++;
 		}
 	}
 
@@ -4555,9 +5340,16 @@ void vrInputFreezeVisren(vrContextInfo *context)
 	/* freeze all the 6-sensors */
 	for (count = 0; count < vrInputs->num_6sensors; count++) {
 		if (vrInputs->sensor6[count] != NULL) {
+			if (!vrInputs->sensor6[count]->visren_stale) {
+				skipped++;
+				continue;
+			}
 			vrLockWriteSet(vrInputs->sensor6[count]->lock);
 			*(vrInputs->sensor6[count]->visren_position) = *(vrInputs->sensor6[count]->position);
+			vrInputs->sensor6[count]->visren_timestamp = vrInputs->sensor6[count]->timestamp;
+			vrInputs->sensor6[count]->visren_stale = 0;
 			vrLockWriteRelease(vrInputs->sensor6[count]->lock);
+			copied++;
 		}
 	}
 
@@ -4565,11 +5357,20 @@ void vrInputFreezeVisren(vrContextInfo *context)
 	/* freeze all the N-sensors */
 	for (count = 0; count < vrInputs->num_Nsensors; count++) {
 		if (vrInputs->sensorN[count] != NULL) {
+			if (!vrInputs->sensorN[count]->visren_stale) {
+				skipped++;
+				continue;
+			}
 			vrLockWriteSet(vrInputs->sensorN[count]->lock);
-			*(vrInputs->sensorN[count]->visren_values) = *(vrInputs->sensorN[count]->values);
+			memcpy(vrInputs->sensorN[count]->visren_values, vrInputs->sensorN[count]->values, vrInputs->sensorN[count]->dof * sizeof(float));
+			vrInputs->sensorN[count]->visren_stale = 0;
 			vrLockWriteRelease(vrInputs->sensorN[count]->lock);
+			copied++;
 		}
 	}
+
+	vrInputs->freeze_copied = copied;
+	vrInputs->freeze_skipped = skipped;
 }
 
 
@@ -4636,6 +5437,8 @@ void vrFprintInput(FILE *file, vrInputInfo *vrInputs, vrPrintStyle style)
 #endif
 		vrFprintf(file, "%d input devices\n", vrInputs->num_input_devices);
 		vrFprintf(file, "%d users\n", vrInputs->num_users);
+		vrFprintf(file, "travel published %lu times (by %s), freezes reread %ld times\n",
+			vrInputs->publish_seq, (vrInputs->publish_by_frame ? "vrFrame()" : "each change"), vrInputs->freeze_rereads);
 		vrFprintf(file, "%d props\n", vrInputs->num_props);
 		vrFprintf(file, "%d 2-way switches\n", vrInputs->num_2ways);
 		vrFprintf(file, "%d N-way switches\n", vrInputs->num_Nways);
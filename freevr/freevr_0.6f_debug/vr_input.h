@@ -111,6 +111,7 @@ typedef struct {
 		int		value;		/* the current value of the input */
 		int		last_value;	/* the previous value of the input */
 		int		visren_value;	/* the value from a visren frame sync -- TODO: handle multiple sync-groups */
+		int		visren_stale;	/* value assigned since the last visren freeze */
 
 		int		num_measures;	/* the number of measurements to store in the "measures" array (if 0 or less, do no recording for this input) */
 		int		current_measure;/* the most recent location in the "measures" array into which a value was placed */
@@ -145,6 +146,7 @@ typedef struct {
 		int		value;		/* the current value of the input */
 		int		last_value;	/* the previous value of the input */
 		int		visren_value;	/* the value from a visren frame sync -- TODO: handle multiple sync-groups */
+		int		visren_stale;	/* value assigned since the last visren freeze */
 	} vrNswitch;
 
 
@@ -175,6 +177,7 @@ typedef struct {
 		float		value;		/* the current value of the input */
 		float		last_value;	/* the previous value of the input */
 		float		visren_value;	/* the value from a visren frame sync -- TODO: handle multiple sync-groups */
+		int		visren_stale;	/* value assigned since the last visren freeze */
 		int		num_measures;	/* the number of measurements to store in the "measures" array (if 0 or less, do no recording for this input) */
 		int		current_measure;/* the most recent location in the "measures" array into which a value was placed */
 		float		*measures;	/* array of values for last <N> frames */
@@ -219,6 +222,9 @@ typedef struct vr6sensor_st {
 		vrMatrix	*r2e_xform;	/* transform from receiver to entity (eg. nose) */
 		vrMatrix	*w_initxform;	/* initial transform in world coordinates */
 		vrMatrix	*visren_position;/* the value from a visren frame sync -- TODO: handle multiple sync-groups */
+		vrTime		visren_timestamp;/* the timestamp of the visren_position value */
+		int		visren_stale;	/* position assigned since the last visren freeze */
+	volatile unsigned int	sequence;	/* sequence counter for lockless reads -- odd while a write is in progress */
 	} vr6sensor;
 
 
@@ -256,6 +262,8 @@ typedef struct {
 		int		calibrated;
 #endif
 		float		visren_values[MAX_NSENSOR_VALUES];/* the values from a visren frame sync -- TODO: handle multiple sync-groups */
+		int		visren_stale;	/* values assigned since the last visren freeze */
+	volatile unsigned int	sequence;	/* sequence counter for lockless reads -- odd while a write is in progress */
 	} vrNsensor;
 
 
@@ -496,6 +504,24 @@ typedef struct {
 	} vr6sensorConv;
 
 
+/************************************************************************/
+/* vrInputHashEntry: one slot of the (open-addressed) hash table that   */
+/*   maps input names to the input data containers.  See the comment of */
+/*   vrInputHashNames() for the names that are put in the table.        */
+/************************************************************************/
+typedef struct {
+		unsigned int	hash;		/* full hash value of the key (0 for an empty slot) */
+		char		*key;		/* the name of the input (NULL for an empty slot) */
+		vrGenericInput	*input;		/* the input data container of that name */
+	} vrInputHashEntry;
+
+typedef struct {
+		int		size;		/* number of slots in the table (a power of 2) */
+		int		num_keys;	/* number of slots in use */
+		vrInputHashEntry *slots;	/* the slots (allocated along with the table) */
+	} vrInputHashTable;
+
+
 /******************************************************************/
 /* vrInput: Overall input structure used by the app-dev to access */
 /*   input data.                                                  */
@@ -557,9 +583,125 @@ typedef struct vrInputInfo_st {
 
 		/* TODO: ... text, positions/pointers, planes, {keys|keyboard} */
 
+		/*************************************************/
+		/* Recording of all input assignments (optional) */
+		char		*record_file;	/* name of the file inputs are recorded to (NULL when not recording) */
+		vrTime		record_wtime;	/* wall-time at which the recording began */
+
+		/**************************************************/
+		/* Tallies of the most recent vrInputFreezeVisren */
+		int		freeze_copied;	/* number of inputs copied to their visren value */
+		int		freeze_skipped;	/* number of inputs unchanged since the previous freeze */
+
+		/*****************************************************************/
+		/* The double buffer of the simulation's travel (and frame data) */
+		/*   (see vrUserTravelPublish() & vrUserTravelFreezeVisren())    */
+		vrLock		publish_lock;	/* keeps two publishes from writing at once */
+	volatile unsigned long	publish_seq;	/* count of the publishes done -- the newest is in copy [publish_seq & 1] */
+	volatile unsigned long	publish_writing;/* the publish being written (or the last written) */
+		int		publish_by_frame;/* flag set once the application calls vrFrame() -- until then, each travel change is published */
+		long		freeze_rereads;	/* count of freezes that had to read again because of a publish */
+	struct vrFrameData_st	*frame_data;	/* list of the application's frame data */
+
+		/*************************************************/
+		/* Hash table for looking up inputs by name      */
+		vrInputHashTable *name_hash;	/* the table (NULL until the input map is made) */
+
+		/**************************************************/
+		/* Count of all input assignments -- the version  */
+		/*   of the inputs used by vrInputSnapshotTake()  */
+	volatile unsigned int	assign_count;
+
 	} vrInputInfo;
 
 
+/***************************************************************************/
+/* vrInputSnapshot: a copy of all the inputs, captured in one pass without */
+/*   taking any of the input locks.  A snapshot is owned by the caller and */
+/*   is private to the calling process -- use vrInputSnapshotCreate() to   */
+/*   get one, and vrInputSnapshotTake() once per frame to refresh it.  The */
+/*   values are then read with the vrSnapshot*() macros below, using the   */
+/*   same input numbers as the vrGet*() functions.                         */
+/* NOTE: the macros do no bounds checking, so the input numbers should be  */
+/*   checked against the "num_*" fields once, outside the frame loop.     */
+/* NOTE: taking a snapshot does not update any input's "last" value, so   */
+/*   the deltas are relative to the previous snapshot, and don't disrupt  */
+/*   the vrGet*Delta() calculations.                                      */
+/***************************************************************************/
+typedef struct vrInputSnapshot_st {
+		unsigned int	version;	/* count of input assignments at the time of capture */
+		int		consistent;	/* flag that no assignment completed during the capture */
+		vrTime		wtime;		/* wall-time of the capture */
+
+		int		num_2ways;
+		int		*switch2;	/* current values of the 2-switches */
+		int		*switch2_last;	/* values from the previous snapshot */
+
+		int		num_Nways;
+		int		*switchN;
+		int		*switchN_last;
+
+		int		num_valuators;
+		float		*valuator;
+		float		*valuator_last;
+
+		int		num_6sensors;
+		vrMatrix	*sensor6;	/* real-world position of the 6-sensors */
+		int		*sensor6_oob;
+
+		int		num_Nsensors;
+		float		*sensorN;	/* MAX_NSENSOR_VALUES values for each N-sensor */
+	} vrInputSnapshot;
+
+#define vrSnapshot2switchValue(snap, num)	((snap)->switch2[(num)])
+#define vrSnapshot2switchDelta(snap, num)	((snap)->switch2[(num)] - (snap)->switch2_last[(num)])
+#define vrSnapshotNswitchValue(snap, num)	((snap)->switchN[(num)])
+#define vrSnapshotNswitchDelta(snap, num)	((snap)->switchN[(num)] - (snap)->switchN_last[(num)])
+#define vrSnapshotValuatorValue(snap, num)	((snap)->valuator[(num)])
+#define vrSnapshotValuatorDelta(snap, num)	((snap)->valuator[(num)] - (snap)->valuator_last[(num)])
+#define vrSnapshot6sensorMatrix(snap, num)	(&((snap)->sensor6[(num)]))
+#define vrSnapshot6sensorOob(snap, num)		((snap)->sensor6_oob[(num)])
+#define vrSnapshotNsensorValue(snap, num, datum)	((snap)->sensorN[(num) * MAX_NSENSOR_VALUES + (datum)])
+
+
+/***************************************************************************/
+/* Input recordings: when the FREEVR_INPUT_RECORD environment variable     */
+/*   names a file, every assignment of a new input value is appended to    */
+/*   that file.  The file begins with a vrInputRecordHeader, followed by a */
+/*   stream of vrInputRecord entries, each followed by "size" bytes of     */
+/*   data.  Name records (kind 'N') associate an input object id with the  */
+/*   name of the input -- the data is the name string (no terminator).     */
+/*   Value records (kind 'V') contain the newly assigned value:            */
+/*     - 2switch & N-switch: one int                                       */
+/*     - valuator: one float                                               */
+/*     - 6sensor: one int (the oob flag) followed by the real-world matrix */
+/*     - N-sensor: "dof" floats                                            */
+/*   The "replay" input device (vr_input.replay.c) reads these files.      */
+/*   NOTE: the data is written in the native byte order of the recorder.   */
+/***************************************************************************/
+#define VRINPUT_RECORD_MAGIC	"FVRINREC"
+#define VRINPUT_RECORD_VERSION	1
+#define VRINPUT_RECORD_NAME	'N'
+#define VRINPUT_RECORD_VALUE	'V'
+#define VRINPUT_RECORD_MAXDATA	(sizeof(int) + sizeof(vrMatrix) > MAX_NSENSOR_VALUES * sizeof(float) ? \
+				 sizeof(int) + sizeof(vrMatrix) : MAX_NSENSOR_VALUES * sizeof(float))
+
+typedef struct {
+		char		magic[8];	/* always VRINPUT_RECORD_MAGIC */
+		int		version;	/* the version of the recording format */
+		int		pad;		/* (unused) */
+		vrTime		start_wtime;	/* wall-time at which the recording began */
+	} vrInputRecordHeader;
+
+typedef struct {
+		vrTime		wtime;		/* time of the assignment, relative to the start of the recording */
+		int		id;		/* id of the vrInput object assigned to */
+		char		kind;		/* VRINPUT_RECORD_NAME or VRINPUT_RECORD_VALUE */
+		char		type;		/* the vrInputType of the input */
+		short		size;		/* number of data bytes following this record */
+	} vrInputRecord;
+
+
 /********************************************************/
 /*** Function declarations for internal-use functions ***/
 
@@ -583,6 +725,7 @@ void		 vrInputWaitForAllInputDevicesToBeOpen();
 void		 vrInputWaitForAllInputsToBeCreated(vrContextInfo *context);
 void		 vrGetDefaultInputDeviceInfo(vrInputDevice *info);
 void		 vrGetInputDeviceInfo(vrInputDevice *);
+void		 vrInputRecordStart(vrContextInfo *context, char *filename);
 
 void		 vrAssignGenericInput(vrGenericInput *input, char *value);
 void		 vrAssign2switchValue(vr2switch *switch2, int newvalue /* , vrTime time */);
@@ -610,11 +753,15 @@ int		 vrInputSetNswitchDescription(int input_num, char *input_desc);
 int		 vrGetNswitchValue(int input_num);
 int		 vrGetNswitchDelta(int input_num);
 int		 vrGetNswitchValueNoLastUpdate(int input_num);
+int		 vrGetNswitchValueDirect(vrNswitch *input);
+int		 vrGetNswitchDeltaDirect(vrNswitch *input);
 
 int		 vrInputSetValuatorDescription(int input_num, char *input_desc);
 float		 vrGetValuatorValue(int input_num);
 float		 vrGetValuatorDelta(int input_num);
 float		 vrGetValuatorValueNoLastUpdate(int input_num);
+float		 vrGetValuatorValueDirect(vrValuator *input);
+float		 vrGetValuatorDeltaDirect(vrValuator *input);
 
 int		 vrInputSet6sensorDescription(int input_num, char *input_desc);
 int		 vrGet6sensorActiveValue(int input_num);
@@ -626,6 +773,7 @@ vrMatrix	*vrMatrixGet6sensorValues(vrMatrix *mat, int input_num);
 vrMatrix	*vrMatrixGet6sensorValuesNoLastUpdate(vrMatrix *mat, int input_num);
 vrMatrix	*vrMatrixGet6sensorValuesDirect(vrMatrix *mat, vr6sensor *input);
 vrMatrix	*vrMatrixGet6sensorValuesDirectNoLastUpdate(vrMatrix *mat, vr6sensor *input);
+vrMatrix	*vrMatrixGet6sensorValuesLatched(vrMatrix *mat, vr6sensor *input, vrTime *timestamp);
 vrMatrix	*vrMatrixGet6sensorRawValuesDirect(vrMatrix *mat, vr6sensor *input);
 float		 vrGet6sensorValueF(int input_num, int datum_num);
 float		 vrGet6sensorValueDirectF(vr6sensor *input, int datum_num);
@@ -647,6 +795,16 @@ float		 vrGetNsensorValueDirect(vrNsensor *input, int datum_num);
 float		*vrGetNsensorArrayDirect(vrNsensor *input, float *array);
 float		 vrGetNsensorValueNoLastUpdate(int input_num, int datum_num);
 
+vr2switch	*vrGet2switchHandle(char *name);
+vrNswitch	*vrGetNswitchHandle(char *name);
+vrValuator	*vrGetValuatorHandle(char *name);
+vr6sensor	*vrGet6sensorHandle(char *name);
+vrNsensor	*vrGetNsensorHandle(char *name);
+
+vrInputSnapshot	*vrInputSnapshotCreate(void);
+int		 vrInputSnapshotTake(vrInputSnapshot *snapshot);
+void		 vrInputSnapshotFree(vrInputSnapshot *snapshot);
+
 #ifdef GFX_PERFORMER /* { */
 /***********************************************************************************/
 /* Utility functions that translate FreeVR coordinates in to Performer Z-up coords */
@@ -676,6 +834,8 @@ char		*vrSprintInputUI(char *str, vrInputInfo *vrInputs, int str_size, vrPrintSt
 void		 vrInputObjectClear(vrInput *object);
 void		 vrInputObjectCopy(vrInput *dest_object, vrInput *src_object);
 char		*vrInputTypeName(vrInputType type);
+void		 vrInputHashNames(vrInputInfo *vrInputs);
+vrGenericInput	*vrInputLookupName(vrInputInfo *vrInputs, char *name);
 vrGenericInput	*vrInputGetFromMapname(vrContextInfo *context, char *mapname);
 vrGenericInput	*vrInputGetFromTypeIndex(vrContextInfo *context, vrInputType type, int input_num);
 void		 vrFprintInputObject(FILE *file, vrInput *inobj, vrPrintStyle style);
@@ -32,6 +32,7 @@
 #include "vr_input.h"
 
 void vrStaticInitInfo(vrInputDevice *info);
+void vrReplayInitInfo(vrInputDevice *info);
 void vrShmemdInitInfo(vrInputDevice *info);
 void vrShmemdOutInitInfo(vrInputDevice *info);
 void vrFobInitInfo(vrInputDevice *info);
@@ -61,6 +62,7 @@ void vrWin32InitInfo(vrInputDevice *info);
 #ifdef VRINPUT_ONLY /* { */
 vrInputOptsType vrInputOpts[] = {
 		{ "static",	vrStaticInitInfo },
+		{ "replay",	vrReplayInitInfo },
 		{ "shmemd",	vrShmemdInitInfo },
 		{ "shmemdout",	vrShmemdOutInitInfo },		/* NOTE: a special tracking "output" device */
 		{ "asc_fob",	vrFobInitInfo },
@@ -0,0 +1,634 @@
+/* ======================================================================
+ *
+ *  CCCCC          vr_input.replay.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for FreeVR inputs replayed from an input recording.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+/*************************************************************************
+
+USAGE:
+	Input recordings are made by setting the FREEVR_INPUT_RECORD
+	environment variable to the name of a file prior to running any
+	FreeVR application.  Every assignment of a new input value is then
+	written to that file (see vr_input.h for the format).
+
+	The "replay" device feeds such a recording back into FreeVR, so
+	the same session can be run again without the original devices.
+	Each input of the replay device refers to the name of an input
+	in the recording -- when no name is given, the name of the input
+	being declared is used.  So the simplest configuration is to
+	rename each input's device to the replay device:
+
+		input "<name>" = "2switch(recorded[{ | <recorded name> }])";
+		input "<name>" = "Nswitch(recorded[{ | <recorded name> }])";
+		input "<name>" = "valuator(recorded[{ | <recorded name> }])";
+		input "<name>" = "6sensor(recorded[{ | <recorded name> }])";
+		input "<name>" = "Nsensor(recorded[{ | <recorded name> }])";
+
+	NOTE: 6-sensors are recorded in real-world coordinates, so the
+		replay device should not be given t2rw or r2e transforms.
+
+	Controls are specified with the "control" option:
+		control "<control option>" = "2switch(...)";
+
+	Here is the available control options for FreeVR:
+		"print_help" -- print info on how to use the input device
+		"system_pause_toggle" -- toggle the system pause flag
+		"print_context" -- print the overall FreeVR context data structure (for debugging)
+		"print_config" -- print the overall FreeVR config data structure (for debugging)
+		"print_input" -- print the overall FreeVR input data structure (for debugging)
+		"print_struct" -- print the internal Replay data structure (for debugging)
+		"restart" -- begin the replay again from the start of the recording
+
+
+	Here are the FreeVR configuration options for the Replay Device:
+		"file" - the name of the recording to replay
+		"speed" - the rate of the replay relative to the recording
+			(eg. 2.0 is twice as fast).  A value of zero (or less)
+			means to replay as fast as possible -- each poll of
+			the device advances one recorded time step.
+		"loop" - whether to start over at the end of the recording
+
+HISTORY:
+	19 October 2026 -- wrote the initial version, for reproducing
+		input sessions when evaluating performance.
+
+TODO:
+	- Consider a control for pausing the replay.
+
+	- Consider byte-swapping recordings made on a machine of
+		different endianness.
+
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vr_parse.h"
+#include "vr_input.h"
+#include "vr_input.opts.h"
+#include "vr_shmem.h"
+#include "vr_debug.h"
+
+
+/*** local defines ***/
+#define	MAX_REPLAY_INPUTS	256
+
+
+/****************************************************************/
+/*** auxiliary structure of the current data from the Replay. ***/
+typedef struct {
+		/* configuration settings */
+		char		*file_name;		/* name of the recording file */
+		float		speed;			/* rate of replay (<= 0.0 for as-fast-as-possible) */
+		int		loop;			/* flag for restarting at end of the recording */
+
+		/* the inputs fed by this device */
+		int		num_inputs;
+		vrGenericInput	*inputs[MAX_REPLAY_INPUTS];
+		char		*input_names[MAX_REPLAY_INPUTS];
+
+		/* the state of the replay -- NOTE: only valid in the input process */
+		FILE		*file;			/* the open recording */
+		long		data_start;		/* file location of the first record */
+		vrTime		start_wtime;		/* wall-time at which the replay began */
+		int		num_ids;		/* size of the "targets" array */
+		vrGenericInput	**targets;		/* inputs to be fed, indexed by recorded id */
+		int		have_record;		/* whether "record" holds an unapplied entry */
+		vrInputRecord	record;			/* the next record to apply */
+		char		data[VRINPUT_RECORD_MAXDATA];	/* data of the next record */
+		int		finished;		/* reached the end of the recording */
+
+		/* tallies of what has been replayed */
+		int		num_applied;		/* number of values assigned */
+		int		num_skipped;		/* number of values not assigned to anything */
+		int		num_loops;		/* number of times the recording was started */
+
+	} _ReplayPrivateInfo;
+
+
+
+	/***********************************/
+	/*** General NON public routines ***/
+	/***********************************/
+
+/**************************************************************************/
+static void _ReplayPrintStruct(FILE *file, _ReplayPrivateInfo *aux, vrPrintStyle style)
+{
+	int	count;
+
+	vrFprintf(file, "Replay device internal structure (%#p):\n", aux);
+	vrFprintf(file, "\r\tfile = '%s' (%#p)\n", aux->file_name, aux->file);
+	vrFprintf(file, "\r\tspeed = %.2f\n", aux->speed);
+	vrFprintf(file, "\r\tloop = %d\n", aux->loop);
+	vrFprintf(file, "\r\tfinished = %d\n", aux->finished);
+	vrFprintf(file, "\r\tvalues applied = %d, skipped = %d, loops = %d\n",
+		aux->num_applied,
+		aux->num_skipped,
+		aux->num_loops);
+
+	vrFprintf(file, "\r\t%d Inputs:\n", aux->num_inputs);
+	for (count = 0; count < aux->num_inputs; count++) {
+		vrFprintf(file, "\r\t\tinput %d: '%s' (%s)\n",
+			count,
+			aux->input_names[count],
+			vrInputTypeName(aux->inputs[count]->input_type));
+	}
+}
+
+
+/**************************************************************************/
+static void _ReplayPrintHelp(FILE *file, _ReplayPrivateInfo *aux)
+{
+	int	count;		/* looping variable */
+
+	vrFprintf(file, BOLD_TEXT "Replay device - inputs (from '%s'):" NORM_TEXT "\n", aux->file_name);
+	for (count = 0; count < aux->num_inputs; count++) {
+		vrFprintf(file, "\t%s -- %s%s\n",
+			aux->inputs[count]->my_object->desc_str,
+			(aux->inputs[count]->input_type == VRINPUT_CONTROL ? "control:" : ""),
+			aux->inputs[count]->my_object->name);
+	}
+}
+
+
+
+	/**********************************/
+	/*** FreeVR NON public routines ***/
+	/**********************************/
+
+
+/**************************************************************/
+static void _ReplayParseArgs(_ReplayPrivateInfo *aux, char *args)
+{
+	/* assign default values */
+	aux->speed = 1.0;
+	aux->loop = 0;
+
+	/*****************************************/
+	/** Argument format: "file" "=" string  **/
+	/*****************************************/
+	vrArgParseString(args, "file", &(aux->file_name));
+
+	/*****************************************/
+	/** Argument format: "speed" "=" number **/
+	/*****************************************/
+	vrArgParseFloat(args, "speed", &(aux->speed));
+
+	/***********************************************************/
+	/** Argument format: "loop" "=" { "on" | "off" | number } **/
+	/***********************************************************/
+	vrArgParseBool(args, "loop", &(aux->loop));
+}
+
+
+/**************************************************************/
+/* _ReplayRewind(): move back to the first record, and reset  */
+/*   the clock of the replay.                                 */
+static void _ReplayRewind(_ReplayPrivateInfo *aux)
+{
+	fseek(aux->file, aux->data_start, SEEK_SET);
+	aux->start_wtime = vrCurrentWallTime();
+	aux->have_record = 0;
+	aux->finished = 0;
+	aux->num_loops++;
+}
+
+
+/**************************************************************/
+/* _ReplayReadRecord(): read the next record of the recording */
+/*   into the auxiliary data.  Name records are handled here, */
+/*   so this only returns (1) for value records, and returns  */
+/*   (0) at the end of the recording.                         */
+static int _ReplayReadRecord(_ReplayPrivateInfo *aux)
+{
+	vrInputRecord	*record = &(aux->record);
+	char		name[VRINPUT_RECORD_MAXDATA + 1];
+	int		count;
+
+	while (fread(record, sizeof(vrInputRecord), 1, aux->file) == 1) {
+		if (record->size < 0 || record->size > VRINPUT_RECORD_MAXDATA) {
+			vrErrPrintf("_ReplayReadRecord(): " RED_TEXT "Corrupt record in '%s'.\n" NORM_TEXT, aux->file_name);
+			return 0;
+		}
+		if (fread(aux->data, 1, record->size, aux->file) != record->size)
+			return 0;
+
+		if (record->kind == VRINPUT_RECORD_VALUE)
+			return 1;
+
+		if (record->kind != VRINPUT_RECORD_NAME || record->id < 0)
+			continue;
+
+		/***********************************************************/
+		/* A name record -- find the input of this device (if any) */
+		/*   that is fed by the recorded id.                       */
+		memcpy(name, aux->data, record->size);
+		name[record->size] = '\0';
+
+		if (record->id >= aux->num_ids) {
+			int	new_num = record->id + 64;
+
+			aux->targets = (vrGenericInput **)realloc(aux->targets, new_num * sizeof(vrGenericInput *));
+			memset(aux->targets + aux->num_ids, 0, (new_num - aux->num_ids) * sizeof(vrGenericInput *));
+			aux->num_ids = new_num;
+		}
+
+		for (count = 0; count < aux->num_inputs; count++) {
+			if (!strcmp(aux->input_names[count], name) && aux->inputs[count]->input_type == record->type) {
+				aux->targets[record->id] = aux->inputs[count];
+				vrDbgPrintfN(REPLAY_DBGLVL, "_ReplayReadRecord(): recorded id %d ('%s') feeds input %d.\n",
+					record->id, name, count);
+				break;
+			}
+		}
+	}
+
+	return 0;
+}
+
+
+/**************************************************************/
+/* _ReplayApplyRecord(): assign the value of the current      */
+/*   record to the input it feeds.                            */
+static void _ReplayApplyRecord(_ReplayPrivateInfo *aux)
+{
+	vrInputRecord	*record = &(aux->record);
+	vrGenericInput	*input = NULL;
+	int		int_value;
+	float		float_value;
+	vrMatrix	mat;
+
+	aux->have_record = 0;
+
+	if (record->id >= 0 && record->id < aux->num_ids)
+		input = aux->targets[record->id];
+
+	if (input == NULL) {
+		aux->num_skipped++;
+		return;
+	}
+
+	switch (input->input_type) {
+	case VRINPUT_BINARY:
+		memcpy(&int_value, aux->data, sizeof(int));
+		vrAssign2switchValue((vr2switch *)input, int_value);
+		break;
+
+	case VRINPUT_NWAY:
+		memcpy(&int_value, aux->data, sizeof(int));
+		vrAssignNswitchValue((vrNswitch *)input, int_value);
+		break;
+
+	case VRINPUT_VALUATOR:
+		memcpy(&float_value, aux->data, sizeof(float));
+		vrAssignValuatorValue((vrValuator *)input, float_value);
+		break;
+
+	case VRINPUT_6SENSOR:
+		memcpy(&int_value, aux->data, sizeof(int));
+		memcpy(&mat, aux->data + sizeof(int), sizeof(vrMatrix));
+		vrAssign6sensorValue((vr6sensor *)input, &mat, int_value);
+		break;
+
+	case VRINPUT_NSENSOR:
+		if (record->size < ((vrNsensor *)input)->dof * sizeof(float)) {
+			aux->num_skipped++;
+			return;
+		}
+		vrAssignNsensorArray((vrNsensor *)input, (float *)aux->data);
+		break;
+
+	default:
+		aux->num_skipped++;
+		return;
+	}
+
+	aux->num_applied++;
+}
+
+
+/**************************************************************/
+static void _ReplayGetData(vrInputDevice *devinfo)
+{
+	_ReplayPrivateInfo	*aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+	vrTime			replay_time;	/* position in the recording to replay up to */
+
+	if (aux->finished) {
+		if (!aux->loop)
+			return;
+		_ReplayRewind(aux);
+	}
+
+	/* get the first record waiting to be applied */
+	if (!aux->have_record) {
+		if (!_ReplayReadRecord(aux)) {
+			aux->finished = 1;
+			vrDbgPrintfN(AALWAYS_DBGLVL, "_ReplayGetData(): End of recording '%s' (%d values applied, %d skipped).\n",
+				aux->file_name, aux->num_applied, aux->num_skipped);
+			return;
+		}
+		aux->have_record = 1;
+	}
+
+	/* as fast as possible: just go through to the next time step */
+	if (aux->speed <= 0.0)
+		replay_time = aux->record.wtime;
+	else	replay_time = (vrCurrentWallTime() - aux->start_wtime) * aux->speed;
+
+	/* apply all records up to the current time */
+	while (aux->have_record && aux->record.wtime <= replay_time) {
+		_ReplayApplyRecord(aux);
+
+		if (!_ReplayReadRecord(aux)) {
+			aux->finished = 1;
+			vrDbgPrintfN(AALWAYS_DBGLVL, "_ReplayGetData(): End of recording '%s' (%d values applied, %d skipped).\n",
+				aux->file_name, aux->num_applied, aux->num_skipped);
+			return;
+		}
+		aux->have_record = 1;
+	}
+}
+
+
+	/***************************************************************/
+	/*    Function(s) for parsing Replay "input" declarations.     */
+	/*                                                             */
+	/*  These _Replay<type>Input() functions are called during the */
+	/*  CREATE phase of the input interface.                       */
+
+/**************************************************************************/
+static vrInputMatch _ReplayRecordedInput(vrInputDevice *devinfo, vrGenericInput *input, vrInputDTI *dti)
+{
+	_ReplayPrivateInfo	*aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+
+	if (aux->num_inputs == MAX_REPLAY_INPUTS) {
+		/* no room at the input */
+		vrDbgPrintfN(CONFIG_WARN_DBGLVL, "_ReplayRecordedInput: "
+			"Warning, too many ""recorded"" inputs, ignoring recorded['%s'].\n",
+			dti->instance);
+
+		return VRINPUT_MATCH_UNABLE;	/* input declaration match, but unable to create */
+	}
+
+	aux->inputs[aux->num_inputs] = input;
+	if (strlen(dti->instance) > 0)
+		aux->input_names[aux->num_inputs] = vrShmemStrDup(dti->instance);
+	else	aux->input_names[aux->num_inputs] = vrShmemStrDup(input->my_object->name);
+	aux->num_inputs++;
+
+	vrDbgPrintfN(REPLAY_DBGLVL, "_ReplayRecordedInput: "
+		"assigned recorded input '%s' to replay input #%d (type %d)\n",
+		aux->input_names[aux->num_inputs-1], aux->num_inputs-1, input->input_type);
+
+	return VRINPUT_MATCH_ABLE;	/* input declaration match */
+}
+
+
+	/************************************************************/
+	/***************** FreeVR Callback routines *****************/
+	/************************************************************/
+
+	/********************************************************/
+	/*    Callbacks for controlling the Replay features.    */
+	/*                                                      */
+
+/************************************************************/
+static void _ReplaySystemPauseToggleCallback(vrInputDevice *devinfo, int value)
+{
+	if (value == 0)
+		return;
+
+	devinfo->context->paused ^= 1;
+	vrDbgPrintfN(SELFCTRL_DBGLVL, "Replay Control: system_pause = %d.\n",
+		devinfo->context->paused);
+}
+
+/************************************************************/
+static void _ReplayRestartCallback(vrInputDevice *devinfo, int value)
+{
+	_ReplayPrivateInfo  *aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+
+	if (value == 0)
+		return;
+
+	if (aux->file != NULL)
+		_ReplayRewind(aux);
+	vrDbgPrintfN(SELFCTRL_DBGLVL, "Replay Control: restart.\n");
+}
+
+/************************************************************/
+static void _ReplayPrintContextStructCallback(vrInputDevice *devinfo, int value)
+{
+	if (value == 0)
+		return;
+
+	vrFprintContext(stdout, devinfo->context, verbose);
+}
+
+/************************************************************/
+static void _ReplayPrintConfigStructCallback(vrInputDevice *devinfo, int value)
+{
+	if (value == 0)
+		return;
+
+	vrFprintConfig(stdout, devinfo->context->config, verbose);
+}
+
+/************************************************************/
+static void _ReplayPrintInputStructCallback(vrInputDevice *devinfo, int value)
+{
+	if (value == 0)
+		return;
+
+	vrFprintInput(stdout, devinfo->context->input, verbose);
+}
+
+/************************************************************/
+static void _ReplayPrintStructCallback(vrInputDevice *devinfo, int value)
+{
+	_ReplayPrivateInfo  *aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+
+	if (value == 0)
+		return;
+
+	_ReplayPrintStruct(stdout, aux, verbose);
+}
+
+/************************************************************/
+static void _ReplayPrintHelpCallback(vrInputDevice *devinfo, int value)
+{
+	_ReplayPrivateInfo  *aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+
+	if (value == 0)
+		return;
+
+	_ReplayPrintHelp(stdout, aux);
+}
+
+
+
+	/********************************************************/
+	/*   Callbacks for interfacing with the Replay device.  */
+	/*                                                      */
+
+/**************************************************************************/
+static void _ReplayCreateFunction(vrInputDevice *devinfo)
+{
+	/*** List of possible inputs ***/
+static	vrInputFunction	_ReplayInputs[] = {
+				{ "recorded", VRINPUT_2WAY, _ReplayRecordedInput },
+				{ "recorded", VRINPUT_NWAY, _ReplayRecordedInput },
+				{ "recorded", VRINPUT_VALUATOR, _ReplayRecordedInput },
+				{ "recorded", VRINPUT_6SENSOR, _ReplayRecordedInput },
+				{ "recorded", VRINPUT_NSENSOR, _ReplayRecordedInput },
+				{ NULL, VRINPUT_UNKNOWN, NULL } };
+	/*** List of control functions ***/
+static	vrControlFunc	_ReplayControlList[] = {
+				/* overall system controls */
+				{ "system_pause_toggle", _ReplaySystemPauseToggleCallback },
+
+				/* informational output controls */
+				{ "print_context", _ReplayPrintContextStructCallback },
+				{ "print_config", _ReplayPrintConfigStructCallback },
+				{ "print_input", _ReplayPrintInputStructCallback },
+				{ "print_struct", _ReplayPrintStructCallback },
+				{ "print_help", _ReplayPrintHelpCallback },
+
+				/* replay controls */
+				{ "restart", _ReplayRestartCallback },
+
+				/* end of the list */
+				{ NULL, NULL } };
+
+	_ReplayPrivateInfo	*aux = NULL;
+
+	/******************************************/
+	/* allocate and initialize auxiliary data */
+	devinfo->aux_data = (void *)vrShmemAlloc0(sizeof(_ReplayPrivateInfo));
+	aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+
+	/******************/
+	/* handle options */
+	_ReplayParseArgs(aux, devinfo->args);
+
+	/***************************************/
+	/* create the inputs and self-controls */
+	vrInputCreateDataContainers(devinfo, _ReplayInputs);
+	vrInputCreateSelfControlContainers(devinfo, _ReplayInputs, _ReplayControlList);
+
+	vrDbgPrintf("_ReplayCreateFunction(): Done creating Replay inputs for '%s'\n", devinfo->name);
+	devinfo->created = 1;
+
+	return;
+}
+
+
+/**************************************************************************/
+static void _ReplayOpenFunction(vrInputDevice *devinfo)
+{
+	_ReplayPrivateInfo	*aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+	vrInputRecordHeader	header;
+
+	vrTrace("_ReplayOpenFunction", devinfo->name);
+
+	/*******************/
+	/* open the device */
+	if (aux->file_name == NULL) {
+		vrErrPrintf("_ReplayOpenFunction(): " RED_TEXT "No recording 'file' given for device '%s'.\n" NORM_TEXT, devinfo->name);
+		devinfo->operating = 0;
+		return;
+	}
+
+	aux->file = fopen(aux->file_name, "rb");
+	if (aux->file == NULL) {
+		vrErrPrintf("_ReplayOpenFunction(): " RED_TEXT "Unable to open recording '%s'.\n" NORM_TEXT, aux->file_name);
+		devinfo->operating = 0;
+		return;
+	}
+
+	if (fread(&header, sizeof(header), 1, aux->file) != 1
+			|| memcmp(header.magic, VRINPUT_RECORD_MAGIC, sizeof(header.magic))
+			|| header.version != VRINPUT_RECORD_VERSION) {
+		vrErrPrintf("_ReplayOpenFunction(): " RED_TEXT "'%s' is not a (version %d) FreeVR input recording.\n" NORM_TEXT,
+			aux->file_name, VRINPUT_RECORD_VERSION);
+		fclose(aux->file);
+		aux->file = NULL;
+		devinfo->operating = 0;
+		return;
+	}
+
+	aux->data_start = ftell(aux->file);
+	aux->num_loops = 0;
+	_ReplayRewind(aux);
+
+	vrDbgPrintf("_ReplayOpenFunction(): Done opening Replay of '%s' for input device '%s'\n", aux->file_name, devinfo->name);
+	devinfo->operating = 1;
+
+	return;
+}
+
+
+/**************************************************************************/
+static void _ReplayCloseFunction(vrInputDevice *devinfo)
+{
+	_ReplayPrivateInfo	*aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+
+	if (aux != NULL && aux->file != NULL) {
+		fclose(aux->file);
+		aux->file = NULL;
+	}
+
+	return;
+}
+
+
+/**************************************************************************/
+static void _ReplayResetFunction(vrInputDevice *devinfo)
+{
+	_ReplayPrivateInfo	*aux = (_ReplayPrivateInfo *)devinfo->aux_data;
+
+	_ReplayParseArgs(aux, devinfo->args);
+	if (aux->file != NULL)
+		_ReplayRewind(aux);
+
+	return;
+}
+
+
+/**************************************************************************/
+static void _ReplayPollFunction(vrInputDevice *devinfo)
+{
+	if (devinfo->operating) {
+		_ReplayGetData(devinfo);
+	}
+
+	return;
+}
+
+
+	/**********************************************************/
+	/***************** FreeVR public routines *****************/
+	/**********************************************************/
+
+
+/**************************************************************************/
+void vrReplayInitInfo(vrInputDevice *devinfo)
+{
+	devinfo->version = (char *)vrShmemStrDup("The Replay input device, version 0.1");
+	devinfo->Create = vrCallbackCreateNamed("ReplayInput:Create-Def", _ReplayCreateFunction, 1, devinfo);
+	devinfo->Open = vrCallbackCreateNamed("ReplayInput:Open-Def", _ReplayOpenFunction, 1, devinfo);
+	devinfo->Close = vrCallbackCreateNamed("ReplayInput:Close-Def", _ReplayCloseFunction, 1, devinfo);
+	devinfo->Reset = vrCallbackCreateNamed("ReplayInput:Reset-Def", _ReplayResetFunction, 1, devinfo);
+	devinfo->PollData = vrCallbackCreateNamed("ReplayInput:PollData-Def", _ReplayPollFunction, 1, devinfo);
+	devinfo->PrintAux = vrCallbackCreateNamed("ReplayInput:PrintAux-Def", _ReplayPrintStruct, 0);
+
+	vrDbgPrintfN(REPLAY_DBGLVL, "vrReplayInitInfo: callbacks created.\n");
+}
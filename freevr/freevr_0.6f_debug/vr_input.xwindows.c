@@ -3472,6 +3472,18 @@ static	char			*whitespace = " \t\r\b";
 				aux->found_req_window[aux->window_count] = 1;	/* TODO: this makes less sense now that we can have multiple windows */
 			}
 
+			/* only GLX windows have X resources to take input from -- */
+			/*   eg. not those made headless (see FREEVR_HEADLESS).     */
+			if (aux->window[aux->window_count]->graphics == NULL || strcmp(aux->window[aux->window_count]->graphics, "glx")) {
+				vrMsgPrintf("FreeVR: X11 input device %s can't take input from window '%s', which is not a GLX window (graphicsType '%s') -- skipping it.\n",
+					devinfo->name, aux->window[aux->window_count]->name,
+					(aux->window[aux->window_count]->graphics == NULL ? "(none)" : aux->window[aux->window_count]->graphics));
+				aux->window[aux->window_count] = NULL;
+				aux->found_req_window[aux->window_count] = 0;
+				window_name = next;
+				continue;
+			}
+
 			/* get a pointer to the window's auxiliary data */
 			glx_aux = (vrGlxPrivateInfo *)aux->window[aux->window_count]->aux_data;
 			if (glx_aux == NULL) {
@@ -3539,6 +3551,13 @@ static	char			*whitespace = " \t\r\b";
 		aux->window_count++;
 	} while (end_name != NULL);
 
+	/* without any window, there's nothing to read -- the device is */
+	/*   left not operating.                                        */
+	if (aux->window_count == 0) {
+		vrMsgPrintf("FreeVR: X11 input device %s has no X windows to take input from -- its inputs won't be read.\n", devinfo->name);
+		return;
+	}
+
 
 	/* TODO: check whether this is true -- NOTE: only need to handle the X-extension devices once, not for each window */
 
@@ -3683,6 +3702,10 @@ static void _XwindowsCloseFunction(vrInputDevice *devinfo)
 	_XwindowsPrivateInfo	*aux = (_XwindowsPrivateInfo *)devinfo->aux_data;
 	int	count;
 
+	/* nothing was opened when there were no windows to take input from */
+	if (aux->display == NULL)
+		return;
+
 	/* close all the extended devices that were opened */
 	for (count = 0; count < aux->num_exdevices; count++) {
 		if (aux->exdevice[count] != NULL)
@@ -235,6 +235,9 @@ typedef enum {
 	VRTOKEN_WINDOW_STATSPROCS,
 	VRTOKEN_WINDOW_FRAMESHOW,
 	VRTOKEN_WINDOW_SIMMASK,
+	VRTOKEN_WINDOW_LATELATCH,
+	VRTOKEN_WINDOW_RENDERTHREAD,
+	VRTOKEN_WINDOW_FRAMEBUDGET,
 
 	/*** eyelist options ***/
 	/* VRTOKEN_MALLEABLE, */
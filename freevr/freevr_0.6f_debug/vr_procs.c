@@ -908,6 +908,12 @@ static		char		string[128];
 #endif
 		vrDbgPrintfN(AALWAYS_DBGLVL, "FreeVR: Visren Main Loop has ended -- " RED_TEXT "exiting process \"%s\".\n" NORM_TEXT, proc_info->name);
 		vrVisrenTermProc(proc_info);
+
+		/* close the windows -- eg. to finish their captures & exports */
+		for (count = 0; count < proc_info->num_things; count++) {
+			if (proc_info->things[count])
+				vrCallbackInvoke(((vrWindowInfo *)proc_info->things[count])->Close);
+		}
 #endif /* MP_NONE */
 		break;
 
@@ -1056,6 +1062,12 @@ void vrProcessSync(vrProcessInfo *proc_info, int stats_sync, int stats_freeze)
 		vrInputFreezeVisren(context);
 		vrUserTravelFreezeVisren(context);
 		vrPropFreezeVisren(context);
+
+		/* record how much of the input data the freeze had to copy */
+		if (proc_info->type == VRPROC_VISREN) {
+			vrProcessStatsValue(proc_info->stats, VR_VALUE_FREEZECOPIED, context->input->freeze_copied, 0);
+			vrProcessStatsValue(proc_info->stats, VR_VALUE_FREEZESKIPPED, context->input->freeze_skipped, 0);
+		}
 		vrTrace("vrProcessSync", "after freeze, now sync-2");
 	} else {
 		/* NOTE: we really shouldn't get here when paused, so if any actual */
@@ -1167,10 +1179,12 @@ static void _FprintProcessStats(FILE *file, vrProcessStats *stats, vrPrintStyle
 		for (count = 0; count < stats->elements; count++)
 			vrFprintf(file, "\"%s\" ", stats->elem_labels[count]);
 		vrFprintf(file, "\n\r"
-			"\tcalc_flag = %d\n\tshow_flag = %d\n\tshow_mask = 0x%x\n",
+			"\tcalc_flag = %d\n\tshow_flag = %d\n\tshow_mask = 0x%x\n"
+			"\twindow_name = \"%s\"\n",
 			stats->calc_flag,
 			stats->show_flag,
-			stats->show_mask);
+			stats->show_mask,
+			(stats->window_name == NULL ? "(all)" : stats->window_name));
 		vrFprintf(file, "\r"
 			"\txloc = %f\n\twidth = %f\n"
 			"\tyloc = %f\n\ttop_time = %fms\n"
@@ -1189,6 +1203,30 @@ static void _FprintProcessStats(FILE *file, vrProcessStats *stats, vrPrintStyle
 			stats->time_frame,
 			stats->mark_wtime,
 			stats->measures);
+		for (count = 0; count < VR_MAXSTATSVALUES; count++) {
+			double	last;
+			double	sum = 0.0;
+			double	max = 0.0;
+			int	frame;
+
+			if (stats->value_labels[count] == NULL)
+				continue;
+
+			/* report the last complete frame, and the mean & max of all frames */
+			last = stats->values[VR_MAXSTATSVALUES * ((stats->time_frame + stats->frames - 1) % stats->frames) + count];
+			for (frame = 0; frame < stats->frames; frame++) {
+				sum += stats->values[VR_MAXSTATSVALUES * frame + count];
+				if (frame == 0 || stats->values[VR_MAXSTATSVALUES * frame + count] > max)
+					max = stats->values[VR_MAXSTATSVALUES * frame + count];
+			}
+			vrFprintf(file, "\r"
+				"\tvalue[%d] \"%s\" = %g (mean = %g, max = %g)\n",
+				count,
+				stats->value_labels[count],
+				last,
+				sum / stats->frames,
+				max);
+		}
 		vrFprintf(file, "\r}\n");
 		break;
 	}
@@ -1253,6 +1291,22 @@ static void _ProcStatsParseArgs(vrProcessStats *stats, char *args)
 	/*****************************************************************/
 	vrArgParseFloatList(args, "bg", &(stats->back_color), 4);
 
+	/*******************************************/
+	/** Argument format: "window" "=" string **/
+	/*******************************************/
+	/* NOTE: the chart is then only drawn in the named window -- so */
+	/*   drawing it doesn't slow down every other window (and eye).  */
+	vrArgParseString(args, "window", &(stats->window_name));
+
+	/******************************************/
+	/** Argument format: "frames" "=" number **/
+	/******************************************/
+	/* NOTE: only used when the stats are created -- it sets the size of */
+	/*   the rings of measures, so a longer history can be gathered.     */
+	vrArgParseInteger(args, "frames", &(stats->frames));
+	if (stats->frames < 2)
+		stats->frames = 2;
+
 }
 
 
@@ -1354,6 +1408,7 @@ vrProcessStats *vrProcessStatsCreate(char *label, int elements, char *args)
 	/************************************/
 	/* allocate storage of measurements */
 	stats->measures = (vrTime *)vrShmemAlloc0(elements * stats->frames * sizeof(vrTime));
+	stats->values = (double *)vrShmemAlloc0(VR_MAXSTATSVALUES * stats->frames * sizeof(double));
 
 	/*********************************/
 	/* initialize the timer settings */
@@ -1404,6 +1459,30 @@ vrTime vrProcessStatsMark(vrProcessStats *stats, int element, unsigned int sum_f
 }
 
 
+/******************************************************************/
+/* vrProcessStatsValue(): store a (non-time) value for the current */
+/*   frame.  As with vrProcessStatsMark(), when "sum_flag" is set  */
+/*   the amount is added to what has already been stored for this */
+/*   frame -- eg. for counts accumulated over several windows.     */
+void vrProcessStatsValue(vrProcessStats *stats, int value, double amount, unsigned int sum_flag)
+{
+	/* If no statistics data then return immediately */
+	if (stats == NULL)
+		return;
+
+	/* When the calculation flag is off, do nothing */
+	if (!stats->calc_flag)
+		return;
+
+	if (value < 0 || value >= VR_MAXSTATSVALUES)
+		return;
+
+	if (sum_flag)
+		stats->values[VR_MAXSTATSVALUES * stats->time_frame + value] += amount;
+	else	stats->values[VR_MAXSTATSVALUES * stats->time_frame + value] = amount;
+}
+
+
 /******************************************************************/
 void vrProcessStatsNextFrame(vrProcessStats *stats)
 {
@@ -1426,5 +1505,9 @@ void vrProcessStatsNextFrame(vrProcessStats *stats)
 	/* clear all the times for this frame -- needed for summation elements */
 	for (count = 0; count < stats->elements; count++)
 		stats->measures[frame_start + count] = 0.0;
+
+	/* likewise for the values */
+	for (count = 0; count < VR_MAXSTATSVALUES; count++)
+		stats->values[VR_MAXSTATSVALUES * stats->time_frame + count] = 0.0;
 }
 
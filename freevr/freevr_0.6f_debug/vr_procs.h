@@ -69,7 +69,14 @@ typedef	enum vrProcessType_en {
 /************************************************************/
 /* vrProcessStats: A structure containing time measurements */
 /*   for a process.                                         */
+/*   In addition to the stacked time measurements, each     */
+/*   stats structure can hold a handful of "values" per     */
+/*   frame -- counts, latencies and other measures that     */
+/*   aren't part of the frame's time line.  Only values     */
+/*   with a label are reported.                             */
 /************************************************************/
+#define VR_MAXSTATSVALUES	24
+
 /* TODO: method of specifying additional horizontal lines (eg. possible monitor syncs) */
 /* DONE: consider adding colors for the bars, and color settings for the background */
 /* DONE: consider adding a label for the entire statistics */
@@ -89,6 +96,7 @@ typedef struct vrProcessStats_st {
 
 		char		*label;		/* overall label of this statistics display  */
 		char		**elem_labels;	/* label for each of the elements            */
+		char		*window_name;	/* the only window to show these in (NULL for all) */
     /* TODO: */	float		xloc;		/* left edge of stats display (0.0 to 1.0)   */
     /* TODO: */	float		width;		/* width of stats display                    */
 		float		yloc;		/* lower edge of stats display (0.0 to 1.0)  */
@@ -100,6 +108,8 @@ typedef struct vrProcessStats_st {
 		int		time_frame;	/* current incoming measures element         */
 		vrTime		mark_wtime;	/* last wall-time we were here               */
 		vrTime		*measures;	/* array of times for all frames             */
+		char		*value_labels[VR_MAXSTATSVALUES];/* label for each of the values (NULL if unused) */
+		double		*values;	/* array of values for all frames            */
 	} vrProcessStats;
 
 
@@ -187,6 +197,7 @@ void		vrSetSignalHandler(void (*)(int));
 
 vrProcessStats	*vrProcessStatsCreate(char *label, int elements, char *args);
 vrTime		vrProcessStatsMark(vrProcessStats *stats, int element, unsigned int sum_flag);
+void		vrProcessStatsValue(vrProcessStats *stats, int value, double amount, unsigned int sum_flag);
 void		vrProcessStatsNextFrame(vrProcessStats *stats);
 
 /*****************************************************************************/
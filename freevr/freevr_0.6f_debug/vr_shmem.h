@@ -171,6 +171,24 @@ void	vrFprintLockList(FILE *file, vrLock lock, vrPrintStyle style);
 int	vrCountLockList(vrLock lock);
 
 
+/*********************************************************************/
+/* A memory barrier is needed for the few places where data is read  */
+/*   without a lock (eg. the sequence-counter reads of 6-sensors).   */
+/*   It keeps both the compiler and the CPU from reordering memory   */
+/*   accesses across the barrier.                                    */
+/*                                                                   */
+/* Similarly, an atomic increment allows a counter to be shared by   */
+/*   several writing processes without a lock.                       */
+/*********************************************************************/
+#if defined(__GNUC__)
+#  define vrMemoryBarrier()	__sync_synchronize()
+#  define vrAtomicIncrement(ptr)	__sync_fetch_and_add((ptr), 1)
+#else
+#  define vrMemoryBarrier()	/* TODO: need a barrier for this compiler */
+#  define vrAtomicIncrement(ptr)	((*(ptr))++)	/* TODO: this is not atomic */
+#endif
+
+
 
 		/*********************************************/
 		/*** Code Barriers structure and functions ***/
@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <signal.h>
 #include <string.h>
+#include <stdlib.h>		/* used by getenv() */
 #include "vr_system.h"
 #include "vr_debug.h"
 #include "vr_config.h"
@@ -840,6 +841,7 @@ vrLockTrace(context->barrier_lock, 1);
 	}
 	context->input->context = context;
 	context->input->object_type = VROBJECT_INPUTINFO;	/* NOTE: don't wait for call to vrInputInitialize() */
+	context->input->publish_lock = vrLockCreateName(context, "travel publish");
 
 
 	/****************************/
@@ -1004,6 +1006,10 @@ void vrStart()
 	/*   (of course, this is after vrConfigure because we don't   */
 	/*   know the system call for locking the process before that.*/
 
+	/* If requested, begin recording all the input assignments -- this */
+	/*   must happen before the input processes are spawned.           */
+	vrInputRecordStart(context, getenv("FREEVR_INPUT_RECORD"));
+
 	/*************************/
 	/** Spawn the processes **/
 	/*************************/
@@ -1410,6 +1416,9 @@ static	vrTime		loop_wtime = -1;			/* time of the beginning of each loop */
 	/* measure: time spent in simulation */
 	vrProcessStatsMark(this_proc->stats, VR_TIME_SIM, 1);
 
+	/* publish the simulation's travel (and frame data) made this frame */
+	vrUserTravelPublish(vrContext);
+
 #ifdef MP_NONE
 	/* NOTE: when multiprocessing is disabled, all the other processes */
 	/*   become virtual processes and are executed here in vrFrame().  */
@@ -114,6 +114,12 @@ USAGE:
 			- "window[<num>] stats" {0,1} -- turn off/on a window's stats display.
 			- "window[<num>] frame" {0,1} -- turn off/on a window's frame display in all windows.
 			- "window[<num>] world" {0,1} -- turn off/on a window's virtual world display.
+			- "window[<num>] latch" {0,1} -- turn off/on late-latching of the head position.
+			- "window[<num>] budget" <ms> -- set the target time of a frame.
+			- "window[<num>] gputimer" {0,1} -- turn off/on measuring the GPU time of a window's eyes & swap.
+			- "window[<num>] swaptiming" {0,1} -- turn off/on measuring a window's motion-to-photon latency & missed vblanks.
+			- "window[<num>] capture" {start [<file>],stop} -- start/stop recording a window's frames.
+			- "window[<num>] export" {start [<name>],stop} -- start/stop exporting a window's frames to shared memory.
 			- "window[<num>] frm" <value> -- set the front rendering mode -- currently s/b {0,0x1B00,0x1B01,0x1B02}
 			- "window[<num>] brm" <value> -- set the back rendering mode -- currently s/b {0,0x1B00,0x1B01,0x1B02}
 			- "window[<num>] sim" <move cmd> -- move the simulator view of a window
@@ -146,6 +152,7 @@ USAGE:
 			- "proc[<num>] stats_scale" <v1> -- set the vertical scale of the stats display\n"
 			- "proc[<num>] stats_color" <v1>,<v2>,<v3> -- set the background color of the stats display\n"
 			- "proc[<num>] stats_opac" <v1> -- set the background opacity of the stats display\n"
+			- "proc[<num>] stats_window" <name> -- only show the stats display in the named window ("*" for all)\n"
 		"lock" | "l" <command> -- send a command to a FreeVR lock
 			... (see help message)
 		"barrier" | "b" <command> -- send a command to a FreeVR barrier
@@ -818,6 +825,12 @@ static	char	*help_msg = "Available settables:\n"
 			TAB "window[<num>] brm <value> -- set the back rendering mode\n"
 			TAB "window[<num>] stats {0,1} -- turn off/on a window's stats display.\n"
 			TAB "window[<num>] world {0,1} -- turn off/on a window's virtual world display.\n"
+			TAB "window[<num>] latch {0,1} -- turn off/on late-latching of the head position.\n"
+			TAB "window[<num>] budget <ms> -- set the target time of a frame.\n"
+			TAB "window[<num>] gputimer {0,1} -- turn off/on measuring the GPU time of a window's eyes & swap.\n"
+			TAB "window[<num>] swaptiming {0,1} -- turn off/on measuring a window's motion-to-photon latency & missed vblanks.\n"
+			TAB "window[<num>] capture {start [<file>],stop} -- start/stop recording a window's frames (.y4m, .png or raw RGB).\n"
+			TAB "window[<num>] export {start [<name>],stop} -- start/stop exporting a window's frames to shared memory.\n"
 			TAB "window[<num>] nudgex <value> -- shift the window along the X-axis\n"
 			TAB "window[<num>] nudgey <value> -- shift the window along the Y-axis\n"
 			TAB "window[<num>] nudgez <value> -- shift the window along the Z-axis\n"
@@ -840,6 +853,7 @@ static	char	*help_msg = "Available settables:\n"
 			TAB "proc[<num>] stats_scale -- set the vertical scale of the stats display (aka time_scale)\n"
 			TAB "proc[<num>] stats_color -- set the background color of the stats display\n"
 			TAB "proc[<num>] stats_opac -- set the background opacity of the stats display\n"
+			TAB "proc[<num>] stats_window -- only show the stats display in the named window (\"*\" for all)\n"
 		"";
 	vrConfigInfo	*config = context->config;
 	char		*parse;
@@ -987,8 +1001,8 @@ static	char	*help_msg = "Available settables:\n"
 	} else
 
 	/******************************************************/
-	/* window[<n>] {ui,ui_loc,ui_color,fps,fps_loc,fps_color,nudge[xyz],stats,sim} <value(s)> */
-	/* or object window[<name>] {ui,ui_loc,ui_color,fps,fps_loc,fps_color,nudge[xyz],stats,sim} <value(s)> */
+	/* window[<n>] {ui,ui_loc,ui_color,fps,fps_loc,fps_color,nudge[xyz],stats,latch,budget,gputimer,swaptiming,capture,export,sim} <value(s)> */
+	/* or object window[<name>] {ui,ui_loc,ui_color,fps,fps_loc,fps_color,nudge[xyz],stats,latch,budget,gputimer,swaptiming,capture,export,sim} <value(s)> */
 	/* TODO: I'd like to also have the ability to give an object window number as another option. */
 	if ((!strncmp(request, "window[", 7)) || (!strncmp(request, "object window[", 14))) {
 		vrWindowInfo	*window = NULL;
@@ -1111,6 +1125,78 @@ static	char	*help_msg = "Available settables:\n"
 				window->world_show = value1i;
 				if (style == verbose)
 					vrFprintf(file, "set window[%d] world to %d.\n", obj_num, value1i);
+			} else if (!strncmp(parse, "latch ", 6)) {
+				parse += 6;				/* skip "latch " */
+				value1i = vrAtoI(parse);
+				window->late_latch = value1i;
+				if (style == verbose)
+					vrFprintf(file, "set window[%d] latch to %d.\n", obj_num, value1i);
+			} else if (!strncmp(parse, "budget ", 7)) {
+				parse += 7;				/* skip "budget " */
+				value1f = atof(parse);
+				window->frame_budget = value1f;
+				if (style == verbose)
+					vrFprintf(file, "set window[%d] budget to %.2f ms.\n", obj_num, value1f);
+			} else if (!strncmp(parse, "gputimer ", 9)) {
+				/* NOTE: the window's process picks up the change at its next swap */
+				parse += 9;				/* skip "gputimer " */
+				value1i = vrAtoI(parse);
+				window->gpu_timer = value1i;
+				if (style == verbose)
+					vrFprintf(file, "set window[%d] gputimer to %d.\n", obj_num, value1i);
+			} else if (!strncmp(parse, "swaptiming ", 11)) {
+				/* NOTE: the window's process picks up the change at its next swap */
+				parse += 11;				/* skip "swaptiming " */
+				value1i = vrAtoI(parse);
+				window->swap_timing = value1i;
+				if (style == verbose)
+					vrFprintf(file, "set window[%d] swaptiming to %d.\n", obj_num, value1i);
+			} else if (!strncmp(parse, "capture ", 8)) {
+				parse += 8;				/* skip "capture " */
+				parse += strspn(parse, whitespace);	/* skip extra whitespace */
+				if (!strncmp(parse, "start", 5)) {
+					/* NOTE: the window's process picks up the request at its next swap */
+					parse += 5;			/* skip "start" */
+					parse += strspn(parse, whitespace);
+					value1i = strcspn(parse, whitespace);
+					if (value1i >= sizeof(window->capture_file))
+						value1i = sizeof(window->capture_file) - 1;
+					strncpy(window->capture_file, parse, value1i);
+					window->capture_file[value1i] = '\0';
+					window->capture_request = 1;
+					if (style == verbose)
+						vrFprintf(file, "started capture of window[%s] to \"%s\".\n", window->name,
+							(window->capture_file[0] == '\0' ? "capture-<window>.y4m" : window->capture_file));
+				} else if (!strncmp(parse, "stop", 4)) {
+					window->capture_request = 0;
+					if (style == verbose)
+						vrFprintf(file, "stopped capture of window[%s].\n", window->name);
+				} else {
+					vrFprintf(file, "Unknown capture request: '%s' -- use 'start [<file>]' or 'stop'.\n", parse);
+				}
+			} else if (!strncmp(parse, "export ", 7)) {
+				parse += 7;				/* skip "export " */
+				parse += strspn(parse, whitespace);	/* skip extra whitespace */
+				if (!strncmp(parse, "start", 5)) {
+					/* NOTE: the window's process picks up the request at its next swap */
+					parse += 5;			/* skip "start" */
+					parse += strspn(parse, whitespace);
+					value1i = strcspn(parse, whitespace);
+					if (value1i >= sizeof(window->export_name))
+						value1i = sizeof(window->export_name) - 1;
+					strncpy(window->export_name, parse, value1i);
+					window->export_name[value1i] = '\0';
+					window->export_request = 1;
+					if (style == verbose)
+						vrFprintf(file, "started export of window[%s] to shared memory \"%s\".\n", window->name,
+							(window->export_name[0] == '\0' ? "/freevr-<window>" : window->export_name));
+				} else if (!strncmp(parse, "stop", 4)) {
+					window->export_request = 0;
+					if (style == verbose)
+						vrFprintf(file, "stopped export of window[%s].\n", window->name);
+				} else {
+					vrFprintf(file, "Unknown export request: '%s' -- use 'start [<name>]' or 'stop'.\n", parse);
+				}
 			} else if (!strncmp(parse, "sim ", 4)) {
 				parse += 4;				/* skip "sim " */
 				parse += strspn(parse, whitespace);	/* skip extra whitespace */
@@ -1189,7 +1275,7 @@ static	char	*help_msg = "Available settables:\n"
 	} else
 
 	/**************************************************/
-	/* proc[<n>] {end,done,printcolor,usec,stats_calc,stats_show,stats_mask,stats_xloc,stats_yloc,stats_width,stats_top,stats_interval,stats_scale,stats_color,stats_opac} <value(s)> */
+	/* proc[<n>] {end,done,printcolor,usec,stats_calc,stats_show,stats_mask,stats_xloc,stats_yloc,stats_width,stats_top,stats_interval,stats_scale,stats_color,stats_opac,stats_window} <value(s)> */
 	if (!strncmp(request, "proc[", 5)) {
 		obj_num = vrAtoI(&request[5]);
 		if (obj_num >= config->num_procs) {
@@ -1326,6 +1412,22 @@ static	char	*help_msg = "Available settables:\n"
 					if (style == verbose)
 						vrFprintf(file, "set proc[%d] stats->back_color[3] to %f.\n", obj_num, value1f);
 				}
+			} else if (!strncmp(parse, "stats_window ", 13)) {
+				parse += 13;
+				parse += strspn(parse, whitespace);		/* skip white */
+				value1i = strcspn(parse, whitespace);		/* the length of the name */
+				if (config->procs[obj_num]->stats != NULL) {
+					/* NOTE: "*" (or nothing) puts the stats back in every window */
+					if (value1i == 0 || !strncmp(parse, "*", value1i))
+						config->procs[obj_num]->stats->window_name = NULL;
+					else {
+						config->procs[obj_num]->stats->window_name = vrShmemStrDup(parse);
+						config->procs[obj_num]->stats->window_name[value1i] = '\0';
+					}
+					if (style == verbose)
+						vrFprintf(file, "set proc[%d] stats->window_name to \"%s\".\n", obj_num,
+							(config->procs[obj_num]->stats->window_name == NULL ? "*" : config->procs[obj_num]->stats->window_name));
+				}
 			} else {
 				vrFprintf(file, "Unknown proc request: '%s'.\n", request);
 			}
@@ -15,7 +15,10 @@
 
 FreeVR USAGE:
 	Here are the FreeVR configuration options for visual rendering windows:
-		"GraphicsType" =  { "glx" }
+		"GraphicsType" =  { "glx", "egl", "txt" }
+			- "egl" renders offscreen (headless) -- setting the environment
+			  variable FREEVR_HEADLESS also renders all "glx" windows this way
+			  (the "xwindows" inputs then skip them, and read nothing)
 
 		"mount" = { "fixed", "head", "hand", "simulator" }
 		"visrenMode" =  { "default", "mono", "right", "left", "dualvp", "dualfb", "anaglyphic", "checkerboard", "vibrate" }
@@ -45,6 +48,11 @@ FreeVR USAGE:
 		"placeFps" = x, y   					[0.0 to 1.0 scale]
 		"colorFps" = red, green, blue				[0 to 255 scale]
 		"showFrame" = { 0 | 1 }
+		"lateLatch" = { 0 | 1 }
+			- re-sample the head position just before rendering each window
+		"renderThread" = { 0 | 1 }
+			- render (and swap) this window in a thread of its own, in
+			  parallel with the other windows of the same visren process
 
 		"args" = <string>
 			- string is a semicolon-separated list of renderer-specific arguments
@@ -86,6 +94,7 @@ TODO:
 #include <unistd.h>
 #include <string.h>
 #include <math.h>		/* for acos in vrRenderGetBillboardAngles...() */
+#include <pthread.h>		/* for the per-window render threads */
 
 #include "vr_visren.opts.h"
 
@@ -98,6 +107,36 @@ static vrProcessInfo	*proc_info = NULL;	/* TODO: is this nece since we also have
 
 
 
+/*********************************************************************/
+/** A structure of information for a window that is rendered by a   **/
+/**   thread of its own (ie. the "renderThread" window option).     **/
+/**   Each such thread has its own vrRenderInfo, since the one of   **/
+/**   the process is in use by the process' own windows.            **/
+typedef struct {
+		vrProcessInfo	*proc;		/* the visren process this thread belongs to */
+		vrWindowInfo	*window;	/* the window rendered by this thread */
+		vrRenderInfo	*renderinfo;	/* the RenderInfo data of this thread */
+		int		stats_value;	/* stats value for the render time of this window (-1 for none) */
+		vrTime		render_time;	/* wall-time spent rendering the window in the last frame */
+		pthread_t	tid;		/* the thread rendering the window */
+	} _VisrenThreadInfo;
+
+
+/*********************************************************************/
+/** A barrier between a visren process and its render threads.  The **/
+/**   vrBarrier (made of two locks) is meant for processes, and its  **/
+/**   last client can set it again for the next pass before the      **/
+/**   others have been let through -- which threads that sync every  **/
+/**   frame do hit.  This one counts its passes instead.             **/
+typedef struct {
+		pthread_mutex_t	lock;		/* lock on the counts */
+		pthread_cond_t	cond;		/* signalled at each pass of the barrier */
+		int		num_clients;	/* the number of threads (incl. the process) that meet here */
+		int		num_waiting;	/* the number of them waiting for this pass */
+		unsigned long	passes;		/* the number of passes so far */
+	} _VisrenThreadBarrier;
+
+
 /**********************************************************************/
 /** A structure of private information for a particular *PROCESS*.   **/
 /**   Note that each window also has private information based on    **/
@@ -111,6 +150,16 @@ typedef struct {
 		vrUserInfo	*curr_user;
 		vrEyeInfo	*curr_eye;
 		vrRenderInfo	*renderinfo;	/* Used for maintaining the RenderInfo data on a per-process basis */
+
+		int		num_threads;	/* number of windows rendered by threads of their own */
+		_VisrenThreadInfo *threads;	/* the information of each render thread */
+		_VisrenThreadBarrier thread_start;/* barrier at which the render threads wait for a new frame */
+		_VisrenThreadBarrier thread_done;/* barrier at which the process waits for the render threads */
+		pid_t		thread_pid;	/* the (Unix) process in which the render threads run */
+		int		threads_end;	/* flag to indicate that the render threads should exit */
+
+		vrTime		budget_cost;	/* smoothed render time of the recent frames (secs) */
+		vrTime		budget_dev;	/* smoothed deviation of those render times (secs) */
 	} _VisrenPrivate;
 
 
@@ -309,6 +358,26 @@ void vrWindowClear(vrWindowInfo *object)
 	object->fps_color[2] = 1.0;
 	object->stats_show = 0;
 	object->inputs_show = 0;
+	object->late_latch = 0;
+	object->render_thread = 0;
+	object->frame_budget = VR_DEFAULT_FRAMEBUDGET;
+	object->res_scale = 1.0;
+	object->capture_request = 0;
+	object->capture_file[0] = '\0';	/* ie. the default name */
+	object->export_request = 0;
+	object->export_name[0] = '\0';	/* ie. the default name */
+	object->gpu_timer = 0;
+	object->gpu_render_time = 0.0;
+	object->gpu_swap_time = 0.0;
+	object->swap_timing = 0;
+	object->input_wtime = 0.0;
+	object->photon_latency = 0.0;
+	object->missed_vblanks = 0;
+	object->persp_cache = NULL;
+	object->single_pass_stereo = 0;		/* ie. until the graphics type says it can */
+	object->eye_persp = NULL;
+	object->eye_frustum = NULL;
+	object->eye_corners = NULL;
 	object->show_in_simulator = 0;
 	object->geometry.origX = -1;
 	object->geometry.origY = -1;
@@ -425,6 +494,11 @@ void vrFprintWindowInfo(FILE *file, vrWindowInfo *windowinfo, vrPrintStyle style
 			"\tfps_show = %d\n\tfps_loc[2] = [%.2f %.2f]\n"
 			"\tfps_color = [%.3f %.3f %.3f]\n"
 			"\tframe_show = %d\n"
+			"\tlate_latch = %d\n"
+			"\trender_thread = %d\n"
+			"\tframe_budget = %.2f\n"
+			"\tgpu_timer = %d (render %.3fms, swap %.3fms)\n"
+			"\tswap_timing = %d (motion-to-photon %.2fms, missed vblanks %ld)\n"
 			"\tstats_show = %d\n\tstats_procs = '%s'\n"
 			"\tstats = [",
 			windowinfo->proc,
@@ -448,6 +522,15 @@ void vrFprintWindowInfo(FILE *file, vrWindowInfo *windowinfo, vrPrintStyle style
 			windowinfo->fps_color[1],
 			windowinfo->fps_color[2],
 			windowinfo->show_in_simulator,
+			windowinfo->late_latch,
+			windowinfo->render_thread,
+			windowinfo->frame_budget,
+			windowinfo->gpu_timer,
+			windowinfo->gpu_render_time,
+			windowinfo->gpu_swap_time,
+			windowinfo->swap_timing,
+			windowinfo->photon_latency,
+			windowinfo->missed_vblanks,
 			windowinfo->stats_show,
 			windowinfo->stats_procs);
 		for (num = 0; num < VR_MAXSTATS; num++)
@@ -504,10 +587,11 @@ void vrFprintWindowInfo(FILE *file, vrWindowInfo *windowinfo, vrPrintStyle style
 			"\tcall_visreninit = %d\n"
 			"\tVisrenInit = %#p (%s)\n\tVisrenFrame = %#p (%s)\n"
 			"\tVisrenWorld = %#p (%s)\n\tVisrenSim = %#p (%s)\n"
+			"\tVisrenWorldStereo = %#p (%s) [single-pass %s]\n"
 			"\tVisrenExit = %#p (%s)\n"
 			"\tOpen = %#p (%s)\n\tRender = %#p (%s)\n\tRender Text = %#p (%s)\n"
 			"\tRender NullWorld = %#p (%s)\n\tRender Default Simulator = %#p (%s)\n"
-			"\tRender Transform = %#p (%s)\n\tSwap = %#p (%s)\n\tClose = %#p (%s)\n"
+			"\tRender Transform = %#p (%s)\n\tSwap = %#p (%s)\n\tSwap Wait = %#p (%s)\n\tClose = %#p (%s)\n"
 			"\tPrintAux = %#p (%s)\n"
 			"\taux_data = %#p\n}\n",
 
@@ -547,6 +631,8 @@ void vrFprintWindowInfo(FILE *file, vrWindowInfo *windowinfo, vrPrintStyle style
 			windowinfo->VisrenFrame,	(windowinfo->VisrenFrame !=NULL ? windowinfo->VisrenFrame->name : "-"),
 			windowinfo->VisrenWorld,	(windowinfo->VisrenWorld !=NULL ? windowinfo->VisrenWorld->name : "-"),
 			windowinfo->VisrenSim,		(windowinfo->VisrenSim !=NULL ? windowinfo->VisrenSim->name : "-"),
+			windowinfo->VisrenWorldStereo,	(windowinfo->VisrenWorldStereo !=NULL ? windowinfo->VisrenWorldStereo->name : "-"),
+			(windowinfo->single_pass_stereo ? "possible" : "unavailable"),
 			windowinfo->VisrenExit,		(windowinfo->VisrenExit !=NULL ? windowinfo->VisrenExit->name : "-"),
 			windowinfo->Open,		(windowinfo->Open !=NULL ? windowinfo->Open->name : "-"),
 			windowinfo->Render,		(windowinfo->Render !=NULL ? windowinfo->Render->name : "-"),
@@ -555,6 +641,7 @@ void vrFprintWindowInfo(FILE *file, vrWindowInfo *windowinfo, vrPrintStyle style
 			windowinfo->RenderSimulator,	(windowinfo->RenderSimulator !=NULL ? windowinfo->RenderSimulator->name : "-"),
 			windowinfo->RenderTransform,	(windowinfo->RenderTransform !=NULL ? windowinfo->RenderTransform->name : "-"),
 			windowinfo->Swap,		(windowinfo->Swap !=NULL ? windowinfo->Swap->name : "-"),
+			windowinfo->SwapWait,		(windowinfo->SwapWait !=NULL ? windowinfo->SwapWait->name : "-"),
 			windowinfo->Close,		(windowinfo->Close !=NULL ? windowinfo->Close->name : "-"),
 			windowinfo->PrintAux,		(windowinfo->PrintAux !=NULL ? windowinfo->PrintAux->name : "-"),
 			windowinfo->aux_data);
@@ -626,6 +713,15 @@ void vrFprintWindowInfo(FILE *file, vrWindowInfo *windowinfo, vrPrintStyle style
 		if (windowinfo->show_in_simulator != 0)
 			vrFprintf(file, "\tshowFrame = %d;\n", windowinfo->show_in_simulator);
 
+		if (windowinfo->late_latch != 0)
+			vrFprintf(file, "\tlateLatch = %d;\n", windowinfo->late_latch);
+
+		if (windowinfo->render_thread != 0)
+			vrFprintf(file, "\trenderThread = %d;\n", windowinfo->render_thread);
+
+		if (windowinfo->frame_budget != (float)VR_DEFAULT_FRAMEBUDGET)
+			vrFprintf(file, "\tframeBudget = %.2f;\n", windowinfo->frame_budget);
+
 		/* TODO: rw2w_translate, rw2w_rotate */
 		vrFprintf(file, "\t# TODO: print rw2w_translate, rw2w_rotate\n");
 
@@ -823,6 +919,332 @@ printf("vrRenderTransform: current window = %p mat = %p transform = %p\n", vrCur
 }
 
 
+/*****************************************************************/
+/* _VisrenProjectionMatrix(): put the projection matrix of the   */
+/*   given perspective data into "mat".  This is the same matrix */
+/*   the graphics type puts on the (OpenGL) projection stack.    */
+static vrMatrix *_VisrenProjectionMatrix(vrPerspData *pd, vrMatrix *mat)
+{
+#ifdef USE_FRUSTUMEYE
+	double	left, right, bottom, top, near_clip, far_clip;
+
+	if (pd->frustum.n.left != -HUGE_VAL) {
+		left = pd->frustum.n.left;
+		right = pd->frustum.n.right;
+		bottom = pd->frustum.n.bottom;
+		top = pd->frustum.n.top;
+		near_clip = pd->frustum.n.near_clip;
+		far_clip = pd->frustum.n.far_clip;
+	} else {
+		/* NOTE: this is of course wrong, but matches what the GLX rendering does */
+		left = -1.0; right = 1.0; bottom = -1.0; top = 1.0; near_clip = 0.1; far_clip = 10.0;
+	}
+
+	/* the same matrix as glFrustum() creates */
+	memset(mat->v, 0, sizeof(mat->v));
+	VRMAT_ROWCOL(mat, 0, 0) = 2.0 * near_clip / (right - left);
+	VRMAT_ROWCOL(mat, 0, 2) = (right + left) / (right - left);
+	VRMAT_ROWCOL(mat, 1, 1) = 2.0 * near_clip / (top - bottom);
+	VRMAT_ROWCOL(mat, 1, 2) = (top + bottom) / (top - bottom);
+	VRMAT_ROWCOL(mat, 2, 2) = -(far_clip + near_clip) / (far_clip - near_clip);
+	VRMAT_ROWCOL(mat, 2, 3) = -2.0 * far_clip * near_clip / (far_clip - near_clip);
+	VRMAT_ROWCOL(mat, 3, 2) = -1.0;
+#else
+	vrMatrixCopy(mat, &(pd->mat));
+#endif
+
+	return mat;
+}
+
+
+/*****************************************************************/
+/* _VisrenViewMatrix(): put the viewing matrix of the given      */
+/*   perspective data into "mat" -- ie. the matrix the graphics  */
+/*   type puts on the (OpenGL) ModelView stack before the world  */
+/*   callback is invoked.                                        */
+static vrMatrix *_VisrenViewMatrix(vrPerspData *pd, vrMatrix *mat)
+{
+#ifdef USE_FRUSTUMEYE
+	vrMatrixSetTranslation3d(mat, -pd->eye[VR_X], -pd->eye[VR_Y], -pd->eye[VR_Z]);
+	vrMatrixPostMult(mat, &(pd->rw2w_xform));
+#else
+	vrMatrixCopy(mat, &(pd->rw2w_xform));
+#endif
+
+	return mat;
+}
+
+
+/*****************************************************************/
+/* vrRenderGetStereoProjection(): put the projection matrix of one */
+/*   eye (VR_STEREO_LEFT or VR_STEREO_RIGHT) of a single-pass      */
+/*   stereo rendering into "mat".                                  */
+/*   Returns NULL when not rendering a single-pass stereo frame.   */
+vrMatrix *vrRenderGetStereoProjection(vrRenderInfo *renderinfo, int which_eye, vrMatrix *mat)
+{
+	if (renderinfo->stereo == NULL || which_eye < 0 || which_eye > 1)
+		return NULL;
+
+	return _VisrenProjectionMatrix(&(renderinfo->stereo->persp[which_eye]), mat);
+}
+
+
+/*****************************************************************/
+/* vrRenderGetStereoView(): put the viewing matrix of one eye of a */
+/*   single-pass stereo rendering into "mat".                      */
+/*   Returns NULL when not rendering a single-pass stereo frame.   */
+vrMatrix *vrRenderGetStereoView(vrRenderInfo *renderinfo, int which_eye, vrMatrix *mat)
+{
+	if (renderinfo->stereo == NULL || which_eye < 0 || which_eye > 1)
+		return NULL;
+
+	return _VisrenViewMatrix(&(renderinfo->stereo->persp[which_eye]), mat);
+}
+
+
+/*****************************************************************/
+/* _VisrenFrustumNormalize(): scale a plane equation such that */
+/*   its normal is a unit vector.                              */
+static void _VisrenFrustumNormalize(double *plane)
+{
+	double	length = sqrt(plane[0]*plane[0] + plane[1]*plane[1] + plane[2]*plane[2]);
+
+	if (length > 0.0) {
+		plane[0] /= length;
+		plane[1] /= length;
+		plane[2] /= length;
+		plane[3] /= length;
+	}
+}
+
+
+/*****************************************************************/
+/* _VisrenFrustumFromMatrix(): extract the six frustum planes of */
+/*   a (projection * view) matrix -- in the coordinates to which */
+/*   the view matrix is applied.                                 */
+static void _VisrenFrustumFromMatrix(vrFrustumPlanes *frustum, vrMatrix *clip)
+{
+	int	plane;
+	int	col;
+
+	/* left/right come from row 0, bottom/top from row 1, near/far from row 2 */
+	for (plane = 0; plane < 6; plane++) {
+		for (col = 0; col < 4; col++) {
+			if (plane & 0x01)
+				frustum->plane[plane][col] = VRMAT_ROWCOL(clip, 3, col) - VRMAT_ROWCOL(clip, plane/2, col);
+			else	frustum->plane[plane][col] = VRMAT_ROWCOL(clip, 3, col) + VRMAT_ROWCOL(clip, plane/2, col);
+		}
+		_VisrenFrustumNormalize(frustum->plane[plane]);
+	}
+}
+
+
+/*****************************************************************/
+/* _VisrenFrustumTransform(): express the planes of a frustum in */
+/*   another coordinate system, where "mat" maps the coordinates */
+/*   of that system into the current ones.                       */
+static void _VisrenFrustumTransform(vrFrustumPlanes *dst, vrFrustumPlanes *src, vrMatrix *mat)
+{
+	int	plane;
+	int	col;
+
+	for (plane = 0; plane < 6; plane++) {
+		for (col = 0; col < 4; col++) {
+			dst->plane[plane][col] =
+				  src->plane[plane][0] * VRMAT_ROWCOL(mat, 0, col)
+				+ src->plane[plane][1] * VRMAT_ROWCOL(mat, 1, col)
+				+ src->plane[plane][2] * VRMAT_ROWCOL(mat, 2, col)
+				+ src->plane[plane][3] * VRMAT_ROWCOL(mat, 3, col);
+		}
+		_VisrenFrustumNormalize(dst->plane[plane]);
+	}
+}
+
+
+/*****************************************************************/
+/* _VisrenFrustumEye(): calculate the real-world frustum planes  */
+/*   of the given perspective data, and the real-world locations */
+/*   of the eight corners of the frustum.                        */
+static void _VisrenFrustumEye(vrFrustumPlanes *frustum, vrPoint *corners, vrPerspData *pd)
+{
+	vrMatrix	proj;
+	vrMatrix	view;
+	vrMatrix	clip;
+	int		corner;
+
+	_VisrenProjectionMatrix(pd, &proj);
+	_VisrenViewMatrix(pd, &view);
+	vrMatrixProduct(&clip, &proj, &view);
+	_VisrenFrustumFromMatrix(frustum, &clip);
+
+#ifdef USE_FRUSTUMEYE
+    {
+	vrFrustum	*fr = &(pd->frustum.n);
+	vrMatrix	w2rw_xform;
+	vrPoint		wcorner;
+
+	/* NOTE: the window transform is a rigid motion (plus perhaps a */
+	/*   uniform scale) for all the mount types.                    */
+	vrMatrixInvertEuclidean(&w2rw_xform, &(pd->rw2w_xform));
+	for (corner = 0; corner < 8; corner++) {
+		double	scale = (corner & 0x04 ? fr->far_clip / fr->near_clip : 1.0);
+
+		wcorner.v[VR_X] = pd->eye[VR_X] + scale * (corner & 0x01 ? fr->right : fr->left);
+		wcorner.v[VR_Y] = pd->eye[VR_Y] + scale * (corner & 0x02 ? fr->top : fr->bottom);
+		wcorner.v[VR_Z] = pd->eye[VR_Z] - scale * fr->near_clip;
+		vrPointTransformByMatrix(&corners[corner], &wcorner, &w2rw_xform);
+	}
+    }
+#else
+	/* TODO: without the frustum values, the corners aren't known -- */
+	/*   marking them as infinite makes the window frustum unbounded. */
+	for (corner = 0; corner < 8; corner++)
+		corners[corner].v[VR_X] = corners[corner].v[VR_Y] = corners[corner].v[VR_Z] = HUGE_VAL;
+#endif
+}
+
+
+/*****************************************************************/
+/* _VisrenFrustumWindow(): calculate a frustum that contains the  */
+/*   frustums of all the eyes of a window.  Each side is the plane */
+/*   of one of the eyes, moved out just far enough to contain the  */
+/*   corners of all the frustums -- using the eye that needs the   */
+/*   least moving.  The result is conservative, and, since eyes    */
+/*   share the window's edges, rarely much larger than needed.     */
+static void _VisrenFrustumWindow(vrFrustumPlanes *frustum, vrFrustumPlanes *eye_frustum, vrPoint *eye_corners, int num_eyes)
+{
+	double		*plane;
+	double		best_shift;
+	int		side;
+	int		count_eye;
+	int		corner;
+
+	if (num_eyes == 1) {
+		*frustum = eye_frustum[0];
+		return;
+	}
+
+	for (side = 0; side < 6; side++) {
+		best_shift = HUGE_VAL;
+		for (count_eye = 0; count_eye < num_eyes; count_eye++) {
+			double	*eplane = eye_frustum[count_eye].plane[side];
+			double	d = eplane[3];
+
+			for (corner = 0; corner < 8 * num_eyes; corner++) {
+				double	*pnt = eye_corners[corner].v;
+				double	corner_d;
+
+				if (pnt[VR_X] == HUGE_VAL) {
+					d = HUGE_VAL;		/* (unknown corners) */
+					break;
+				}
+				corner_d = -(eplane[0]*pnt[VR_X] + eplane[1]*pnt[VR_Y] + eplane[2]*pnt[VR_Z]);
+				if (corner_d > d)
+					d = corner_d;
+			}
+
+			if (d - eplane[3] < best_shift) {
+				best_shift = d - eplane[3];
+				plane = frustum->plane[side];
+				plane[0] = eplane[0];
+				plane[1] = eplane[1];
+				plane[2] = eplane[2];
+				plane[3] = d;
+			}
+		}
+
+		/* a side that can't be bounded is left open */
+		if (best_shift == HUGE_VAL) {
+			plane = frustum->plane[side];
+			plane[0] = plane[1] = plane[2] = 0.0;
+			plane[3] = 1.0;
+		}
+	}
+}
+
+
+/*****************************************************************/
+/* vrFrustumCullSphere(): test a sphere against the planes of a  */
+/*   frustum.  Returns VR_CULL_OUTSIDE when the sphere can't be   */
+/*   seen, VR_CULL_INSIDE when it is entirely within the frustum, */
+/*   and otherwise VR_CULL_PARTIAL.                               */
+int vrFrustumCullSphere(vrFrustumPlanes *frustum, double *center, double radius)
+{
+	int	result = VR_CULL_INSIDE;
+	int	plane;
+	double	dist;
+
+	for (plane = 0; plane < 6; plane++) {
+		dist = frustum->plane[plane][0] * center[VR_X]
+			+ frustum->plane[plane][1] * center[VR_Y]
+			+ frustum->plane[plane][2] * center[VR_Z]
+			+ frustum->plane[plane][3];
+		if (dist < -radius)
+			return VR_CULL_OUTSIDE;
+		if (dist < radius)
+			result = VR_CULL_PARTIAL;
+	}
+
+	return result;
+}
+
+
+/*****************************************************************/
+/* vrFrustumCullBox(): test an axis-aligned box (given by its    */
+/*   minimum and maximum corners) against the planes of a         */
+/*   frustum.  Returns the same values as vrFrustumCullSphere().  */
+/* NOTE: a box near a corner of the frustum, but outside of it,   */
+/*   may be reported as VR_CULL_PARTIAL (ie. it is conservative). */
+int vrFrustumCullBox(vrFrustumPlanes *frustum, double *min, double *max)
+{
+	int	result = VR_CULL_INSIDE;
+	int	plane;
+	double	*p;
+
+	for (plane = 0; plane < 6; plane++) {
+		p = frustum->plane[plane];
+
+		/* the corner farthest along the normal must be inside ... */
+		if (p[0] * (p[0] >= 0.0 ? max[VR_X] : min[VR_X])
+		  + p[1] * (p[1] >= 0.0 ? max[VR_Y] : min[VR_Y])
+		  + p[2] * (p[2] >= 0.0 ? max[VR_Z] : min[VR_Z]) + p[3] < 0.0)
+			return VR_CULL_OUTSIDE;
+
+		/* ... and when the nearest corner is too, it's all inside */
+		if (p[0] * (p[0] >= 0.0 ? min[VR_X] : max[VR_X])
+		  + p[1] * (p[1] >= 0.0 ? min[VR_Y] : max[VR_Y])
+		  + p[2] * (p[2] >= 0.0 ? min[VR_Z] : max[VR_Z]) + p[3] < 0.0)
+			result = VR_CULL_PARTIAL;
+	}
+
+	return result;
+}
+
+
+/*****************************************************************/
+/* vrRenderCullSphere(): test a sphere (in virtual-world coords, */
+/*   ie. after vrRenderTransformUserTravel()) against the view    */
+/*   frustum of what is being rendered -- the current eye, or    */
+/*   both eyes of a single-pass stereo rendering.                */
+int vrRenderCullSphere(vrRenderInfo *renderinfo, double *center, double radius)
+{
+	if (renderinfo->stereo != NULL)
+		return vrFrustumCullSphere(&(renderinfo->vw_frustum_window), center, radius);
+	return vrFrustumCullSphere(&(renderinfo->vw_frustum), center, radius);
+}
+
+
+/*****************************************************************/
+/* vrRenderCullBox(): test an axis-aligned box (in virtual-world */
+/*   coords) against the view frustum of what is being rendered. */
+int vrRenderCullBox(vrRenderInfo *renderinfo, double *min, double *max)
+{
+	if (renderinfo->stereo != NULL)
+		return vrFrustumCullBox(&(renderinfo->vw_frustum_window), min, max);
+	return vrFrustumCullBox(&(renderinfo->vw_frustum), min, max);
+}
+
+
 /******************************************************************/
 int vrRenderPushPerspFrom6sensor(vrRenderInfo *renderinfo, int sensor6_num)
 {
@@ -988,6 +1410,11 @@ vrEuler *vrRenderGetBillboardAnglesAd(vrRenderInfo *renderinfo, vrEuler *eulers,
 /******************************************************************/
 void vrRenderCategory(vrRenderInfo *renderinfo, int tag)
 {
+	/* the time marks can only be made by the process itself, */
+	/*   not by the render thread of a window.                 */
+	if (renderinfo->window->render_thread)
+		return;
+
 	switch (tag) {
 	case 1:
 		vrProcessStatsMark(renderinfo->window->proc->stats, VR_TIME_RENDER1, 1);
@@ -1003,6 +1430,39 @@ void vrRenderCategory(vrRenderInfo *renderinfo, int tag)
 	return;
 }
 
+
+/******************************************************************/
+/* vrWindowStatsValue(): add an amount to a stats value of the    */
+/*   current frame on behalf of a window.  The render thread of a */
+/*   window can't add to the values of the process (the threads   */
+/*   would step on each other's sums), so it sums into the window */
+/*   instead, and the process adds that in once the threads are   */
+/*   done with the frame (see _VisrenThreadValues()).             */
+void vrWindowStatsValue(vrWindowInfo *window, int value, double amount)
+{
+	if (value < 0 || value >= VR_MAXSTATSVALUES)
+		return;
+
+	if (window->render_thread)
+		window->thread_values[value] += amount;
+	else	vrProcessStatsValue(window->proc->stats, value, amount, 1);
+}
+
+
+/******************************************************************/
+/* vrWindowStatsValueSet(): as vrWindowStatsValue(), but the value */
+/*   of the frame is set to the amount rather than summed.         */
+void vrWindowStatsValueSet(vrWindowInfo *window, int value, double amount)
+{
+	if (value < 0 || value >= VR_MAXSTATSVALUES)
+		return;
+
+	if (window->render_thread) {
+		window->thread_values[value] = amount;
+		window->thread_values_set |= (1U << value);
+	} else	vrProcessStatsValue(window->proc->stats, value, amount, 0);
+}
+
 #ifdef NOT_CURRENTLY_USED /* { */
 /******************************************************************/
 /* vrVisrenSignalHandler(): on a SIGINT signal, this process will */
@@ -1051,6 +1511,618 @@ static void vrVisrenSignalHandler(int which)
 #endif /* } */
 
 
+/*****************************************************************************/
+/* _VisrenPerspCacheMatch(): compare the values from which the perspective   */
+/*   of an eye is calculated with those of its cached perspective.  Returns  */
+/*   1 when the cached perspective can be reused, otherwise the new values   */
+/*   are stored (for the perspective to be calculated and then cached) and   */
+/*   0 is returned.                                                          */
+static int _VisrenPerspCacheMatch(vrPerspCache *cache, vrWindowInfo *window, vrMatrix *eye_rwpos)
+{
+	vrConfigInfo	*config = window->context->config;
+	vrPoint		eye;
+
+	/* NOTE: the simulator view doesn't depend on the eye location */
+	if (window->mount == VRWINDOW_SIMULATOR) {
+		vrPointSet3d(&eye, 0.0, 0.0, 0.0);
+	} else {
+		vrPointGetTransFromMatrix(&eye, eye_rwpos);
+	}
+
+	if (cache->valid
+		&& cache->eye[VR_X] == eye.v[VR_X]
+		&& cache->eye[VR_Y] == eye.v[VR_Y]
+		&& cache->eye[VR_Z] == eye.v[VR_Z]
+		&& !memcmp(&(cache->rw2w_xform), window->rw2w_xform, sizeof(vrMatrix))
+		&& !memcmp(&(cache->Lpoint), &(window->Lpoint), sizeof(vrPoint))
+		&& !memcmp(&(cache->Hpoint), &(window->Hpoint), sizeof(vrPoint))
+		&& cache->near_clip[0] == window->settings.near_clip
+		&& cache->near_clip[1] == config->system->settings.near_clip
+		&& cache->near_clip[2] == config->defaults.near_clip
+		&& cache->far_clip[0] == window->settings.far_clip
+		&& cache->far_clip[1] == config->system->settings.far_clip
+		&& cache->far_clip[2] == config->defaults.far_clip) {
+		return 1;
+	}
+
+	cache->eye[VR_X] = eye.v[VR_X];
+	cache->eye[VR_Y] = eye.v[VR_Y];
+	cache->eye[VR_Z] = eye.v[VR_Z];
+	cache->rw2w_xform = *(window->rw2w_xform);
+	cache->Lpoint = window->Lpoint;
+	cache->Hpoint = window->Hpoint;
+	cache->near_clip[0] = window->settings.near_clip;
+	cache->near_clip[1] = config->system->settings.near_clip;
+	cache->near_clip[2] = config->defaults.near_clip;
+	cache->far_clip[0] = window->settings.far_clip;
+	cache->far_clip[1] = config->system->settings.far_clip;
+	cache->far_clip[2] = config->defaults.far_clip;
+	cache->valid = 1;
+
+	return 0;
+}
+
+
+/*****************************************************************************/
+/* _VisrenRenderEye(): set the current eye of the render info to the given   */
+/*   eye of the window, along with its user's travel transform, and its      */
+/*   perspective and view frustums (calculated by _VisrenRenderWindow()).    */
+static void _VisrenRenderEye(vrRenderInfo *renderinfo, vrWindowInfo *window, int count_eye)
+{
+	vrEyeInfo	*eye = window->eyes[count_eye];
+	vrUserInfo	*user = eye->user;
+
+	renderinfo->eye = eye;
+
+	/* NOTE: no lock is needed -- the travel was frozen with the inputs, */
+	/*   from the copy published by the simulation's vrFrame().         */
+	renderinfo->rw2vw_xform = user->visren_rw2vw;
+	renderinfo->vw2rw_xform = user->visren_vw2rw;
+
+	*(renderinfo->persp) = window->eye_persp[count_eye];
+
+	/* NOTE: the transform of a head-mounted window depends on the eye */
+	if (window->mount == VRWINDOW_HEADMOUNT)
+		*(window->rw2w_xform) = renderinfo->persp->rw2w_xform;
+
+	/* NOTE: the application draws in virtual-world coordinates, which */
+	/*   the travel transform maps into the real world.                */
+	renderinfo->rw_frustum = window->eye_frustum[count_eye];
+	renderinfo->rw_frustum_window = window->frustum;
+	_VisrenFrustumTransform(&(renderinfo->vw_frustum), &(renderinfo->rw_frustum), renderinfo->rw2vw_xform);
+	_VisrenFrustumTransform(&(renderinfo->vw_frustum_window), &(renderinfo->rw_frustum_window), renderinfo->rw2vw_xform);
+}
+
+
+/*****************************************************************************/
+/* _VisrenBudgetUpdate(): fold the render time of the frame just rendered   */
+/*   into the smoothed cost (and deviation) of this process' frames.  These  */
+/*   are the same running averages that TCP uses for its round-trip time,    */
+/*   so a few slow frames raise the prediction quickly, and it then settles  */
+/*   back down over a dozen or so frames.                                    */
+/* NOTE: this is the time the CPU spends on the frame.  Any GPU time beyond  */
+/*   that shows up in the swap, which also includes the wait for the vsync. */
+static void _VisrenBudgetUpdate(_VisrenPrivate *visren_aux, vrTime cost)
+{
+	vrTime	error;
+
+	if (visren_aux->budget_cost == 0.0) {
+		/* the first frame */
+		visren_aux->budget_cost = cost;
+		visren_aux->budget_dev = cost * 0.5;
+		return;
+	}
+
+	error = cost - visren_aux->budget_cost;
+	visren_aux->budget_cost += error * 0.125;
+	visren_aux->budget_dev += (fabs(error) - visren_aux->budget_dev) * 0.25;
+}
+
+
+/*****************************************************************************/
+/* _VisrenBudgetPredict(): the expected render time of the next frame of the */
+/*   process, allowing for two deviations of jitter.                         */
+static vrTime _VisrenBudgetPredict(_VisrenPrivate *visren_aux)
+{
+	return visren_aux->budget_cost + 2.0 * visren_aux->budget_dev;
+}
+
+
+/*****************************************************************************/
+/* _VisrenStereoPassPossible(): determine whether both eyes of the window    */
+/*   can be rendered with a single invocation of the application's world     */
+/*   callback.  This requires that the application has opted in (by setting  */
+/*   a VRFUNC_DISPLAY_STEREO callback), that the graphics type can do it,    */
+/*   and that the window has exactly one left and one right eye of the same  */
+/*   user, rendered in full color to viewports of the same framebuffer.     */
+/*   All other windows render each eye in a pass of its own.                 */
+static int _VisrenStereoPassPossible(vrWindowInfo *window)
+{
+	vrEyeInfo	*left_eye;
+	vrEyeInfo	*right_eye;
+
+	if (window->VisrenWorldStereo == NULL || !window->single_pass_stereo)
+		return 0;
+
+	/* NOTE: the simulator view has its own callback for the simulated hardware */
+	if (window->num_eyes != 2 || window->mount == VRWINDOW_SIMULATOR)
+		return 0;
+
+	left_eye = window->eyes[0];
+	right_eye = window->eyes[1];
+	if (left_eye->type == VREYE_RIGHT) {
+		left_eye = window->eyes[1];
+		right_eye = window->eyes[0];
+	}
+	if (left_eye->type != VREYE_LEFT || right_eye->type != VREYE_RIGHT)
+		return 0;
+
+	/* a user-specific world callback takes precedence, and it is per-eye */
+	if (left_eye->user != right_eye->user || left_eye->user->VisrenWorld != NULL)
+		return 0;
+
+	if (left_eye->color != VRANAGLYPH_ALL || right_eye->color != VRANAGLYPH_ALL)
+		return 0;
+
+	/* NOTE: eyes in separate (quad-buffered) framebuffers can't share a pass */
+	if (left_eye->render_framebuffer != VRFB_FULL_LEFTEYE && left_eye->render_framebuffer != VRFB_SPLIT_LEFTEYE)
+		return 0;
+	if (right_eye->render_framebuffer != VRFB_FULL_RIGHTEYE && right_eye->render_framebuffer != VRFB_SPLIT_RIGHTEYE)
+		return 0;
+
+	return 1;
+}
+
+
+/*****************************************************************************/
+/* _VisrenRenderWindow(): call the frame callback, and then render each eye  */
+/*   of the given window.  This is phase (3) of vrVisrenOneFrame(), and it is */
+/*   done either by the visren process itself, or by the window's own render */
+/*   thread (in which case the time marks are skipped by passing a NULL     */
+/*   "stats", since the marks of a process can only be made by one thread). */
+static void _VisrenRenderWindow(vrProcessInfo *myproc_info, vrWindowInfo *window, vrRenderInfo *renderinfo, vrProcessStats *stats)
+{
+	char		trace_msg[256];
+	vrUserInfo	*user;
+	vrEyeInfo	*eye;
+	int		count_eye;
+	int		num_eyes;		/* for counting through the eyes */
+	vrUserInfo	*latch_user = NULL;	/* the user whose head was late-latched for this window */
+	vrMatrix	latch_headpos;		/* the late-latched head position of latch_user */
+	vrTime		latch_time;		/* the time at which latch_headpos was assigned */
+	vrStereoInfo	stereo;			/* both eyes, when rendered in a single pass */
+	int		stereo_pass;		/* whether both eyes are rendered in a single pass */
+	_VisrenPrivate	*visren_aux;
+
+	sprintf(trace_msg, "beginning window render loop for window '%s'", window->name);
+	vrTrace("_VisrenRenderWindow", trace_msg);
+
+	renderinfo->window = window;
+	renderinfo->eye = NULL;		/* the init and frame callbacks are not done on a per-eye basis */
+
+#define GFXINIT_TOP 2	/* set to 1 to do here, 0 to do after rendering, and 2 to do not at all -- or in rendering */
+#if GFXINIT_TOP == 1 /* test of moving until after rendering -- ie. after the proper GLXcontext is set */
+	/******************************************/
+	/*** (3a) call initialization functions ***/
+	/******************************************/
+
+	/* The initialization functions are only called once per window  */
+	/*   per setting of the initialization function, so this is only */
+	/*   done when a new VisrenInit callback was assigned.           */
+	if (window->call_visreninit == 1) {
+vrPrintf("_VisrenRenderWindow()-A: Calling VisrenInit callback for window '%s' -- call_visreninit was set to 1.\n", window->name);
+		/* TODO: consider whether a per-user initialization routine */
+		/*   is important.  This implementation does not refer to a */
+		/*   per-user init callback -- because we don't know the    */
+		/*   user until we get down to phase (3c).                  */
+		vrTrace("_VisrenRenderWindow", "prep: initialization callback");
+		callback = window->VisrenInit;
+		vrCallbackInvokeDynamic(callback, 1, renderinfo);
+		window->call_visreninit = 0;
+		vrTrace("_VisrenRenderWindow", "done: initialization callback");
+	}
+
+	/* measure: time spent in init function */
+	vrProcessStatsMark(stats, VR_TIME_INIT, 1);
+#endif
+
+	/************************************/
+	/*** (3a) check the frame budget ***/
+	/************************************/
+
+	/* NOTE: the frame budget lets the application lower its level-of-  */
+	/*   detail before a frame misses the vsync, rather than after.  A  */
+	/*   window with a frameBudget of 0 (or less) has no budget.        */
+	visren_aux = myproc_info->aux_data;
+	renderinfo->frame_cost = visren_aux->budget_cost;
+	if (window->frame_budget > 0.0) {
+		renderinfo->frame_budget = window->frame_budget * 0.001;
+		renderinfo->frame_headroom = renderinfo->frame_budget - _VisrenBudgetPredict(visren_aux);
+	} else {
+		renderinfo->frame_budget = 0.0;
+		renderinfo->frame_headroom = 0.0;
+	}
+
+	if (renderinfo->frame_headroom < 0.0 && vrContext->callbacks->VisrenBudget != NULL) {
+		vrCallbackInvokeDynamic(vrContext->callbacks->VisrenBudget, 1, renderinfo);
+		vrTrace("_VisrenRenderWindow", "after visrenbudget callback");
+	}
+
+	/*********************************/
+	/*** (3b) call frame functions ***/
+	/*********************************/
+
+	/* NOTE: frame functions are called once per frame, per window */
+
+
+	/* call global frame function (same for all windows) */
+	vrCallbackInvokeDynamic(vrContext->callbacks->VisrenFrame, 1, renderinfo);
+	vrTrace("_VisrenRenderWindow", "after GENERAL visrenframe callback");
+
+	/* TODO: add window-specific frame callback (VR_ONE_DISPLAY_FRAME) */
+
+#if 0 /* TODO: determine if we can to call user-specific frame functions here  */
+/* Hmmm, here is probably bad since we don't know which user we are    */
+/* until we know what eye we're rendering for.  Perhaps it should just */
+/* be a generic user-specific rendering supplement.                    */
+	/* invoke this user's frame function ... */
+	vrCallbackInvokeDynamic(user->VisrenFrame, 1, renderinfo);
+	vrTrace("_VisrenRenderWindow", "after USER visrenframe callback");
+#endif
+	/* measure: time spent in frame function */
+	vrProcessStatsMark(stats, VR_TIME_FRAME, 1);
+
+
+	/****************************/
+	/*** (3c) foreach eye ... ***/
+	/****************************/
+	num_eyes = window->num_eyes;
+	if (num_eyes == 0) {
+		/* There's no reason to continue with no eyes.  Is there?*/
+		return;
+	}
+
+	/* NOTE: the perspective (and frustum) of every eye is calculated */
+	/*   before any is rendered, so that the frustum containing all   */
+	/*   the eyes can be given to the rendering of each of them.      */
+	for (count_eye = 0; count_eye < num_eyes; count_eye++) {
+		vrMatrix	head_rwpos;
+		vrMatrix	eye_rwpos;
+		vrPerspCache	*persp_cache;
+		vrPerspData	*pd = &(window->eye_persp[count_eye]);
+
+		eye = window->eyes[count_eye];
+		user = eye->user;
+
+		/***********************************************************/
+		/* now compute the current eye position based on the world */
+		/*   position information from the tracker for this user.  */
+		sprintf(trace_msg, "about to calculate the eye position for eye %d", count_eye);
+		vrTrace("_VisrenRenderWindow", trace_msg);
+
+#if 0 /* 1 = the unsynced version, 0 = the new frozen-data-storage version */
+		vrMatrixGet6sensorValuesDirectNoLastUpdate(&head_rwpos, user->head);
+#else
+		if (window->late_latch && user->head != NULL) {
+			/* Late-latch: rather than the head position frozen at the */
+			/*   frame sync, use the newest value from the tracker.     */
+			/*   This is sampled once per user per window, so that all */
+			/*   the eyes of a window are rendered from the same pose.  */
+			if (latch_user != user) {
+				latch_user = user;
+				vrMatrixGet6sensorValuesLatched(&latch_headpos, latch_user->head, &latch_time);
+
+				/* measure: how much fresher the latched pose is */
+				/*   (by way of the window, as "stats" is NULL  */
+				/*   in the window's render thread)             */
+				vrWindowStatsValueSet(window, VR_VALUE_LATCHAGE,
+					(latch_time - latch_user->head->visren_timestamp) * 1000.0);
+			}
+			vrMatrixCopy(&head_rwpos, &latch_headpos);
+			if (count_eye == 0)
+				window->input_wtime = latch_time;
+		} else {
+			/* NOTE: no need for a read-lock, since this value can */
+			/*   only be written in phase 3 of this loop.          */
+			vrMatrixCopy(&head_rwpos, user->visren_headpos);
+			if (count_eye == 0 && user->head != NULL)
+				window->input_wtime = user->head->visren_timestamp;
+		}
+#endif
+		vrMatrixCopy(&eye_rwpos, &head_rwpos);
+
+		switch (eye->type) {
+		case VREYE_DEFAULT:
+		case VREYE_CYCLOPS:
+			/* NOP: leave the eye at the generic head position */
+#ifndef VIBRATE_TEST	/* when testing vibrate mode have the cyclops renderings fall into the vibrate code */
+			break;
+#endif
+		case VREYE_VIBRATE:
+			if ((renderinfo->frame_count / 20) % 2) {
+				vrMatrixPostTranslate3d(&eye_rwpos, /*-user->iod */-.3 * 0.5, 0.0, 0.0);
+			} else {
+				vrMatrixPostTranslate3d(&eye_rwpos, /* user->iod */.3 * 0.5, 0.0, 0.0);
+			}
+			break;
+		case VREYE_LEFT:
+			/* TODO: the sign seems backward on these, need to figure */
+			/*  out why the left eye is translated in positive-X, etc.*/
+			/*  3/5/3 -- that was yesterday, today, it appears that   */
+			/*  yesterday's change was backward, so I went back to the*/
+			/*  way it was.                                           */
+			vrMatrixPostTranslate3d(&eye_rwpos, -user->iod * 0.5, 0.0, 0.0);
+			break;
+		case VREYE_RIGHT:
+			vrMatrixPostTranslate3d(&eye_rwpos,  user->iod * 0.5, 0.0, 0.0);
+			break;
+
+
+		default:
+			/* TODO: error */
+			break;
+		}
+
+		/**********************************************************/
+		/* now compute the perspective matrix for this window/eye */
+		vrTrace("_VisrenRenderWindow", "about to calculate the perspective matrix");
+
+		/* TODO: for hand-based displays, we'll need to give information  */
+		/*   on where the window is located to vrCalcPerspMatrix().       */
+		/*   This could be done either by putting that info in the        */
+		/*   renderinfo->window structure, or by passing another argument.*/
+		/*   I prefer the former [BS: 9/13/2000].                         */
+		/* NOTE: head-mounted windows aren't cached, since their     */
+		/*   calculation also sets the window's rw2w_xform matrix.   */
+		if (window->persp_cache != NULL && (window->mount == VRWINDOW_FIXED || window->mount == VRWINDOW_SIMULATOR))
+			persp_cache = &(window->persp_cache[count_eye]);
+		else	persp_cache = NULL;
+
+		if (persp_cache != NULL && _VisrenPerspCacheMatch(persp_cache, window, &eye_rwpos)) {
+			*pd = persp_cache->persp;
+
+			/* measure: count the eyes that reused their perspective */
+			vrWindowStatsValue(window, VR_VALUE_PERSPCACHED, 1.0);
+		} else {
+#ifdef USE_FRUSTUMEYE
+			vrCalcPerspFrustumEye(pd, window, &eye_rwpos);
+#else
+			vrCalcPerspMatrix(pd, window, &eye_rwpos);
+#endif
+			if (persp_cache != NULL)
+				persp_cache->persp = *pd;
+		}
+
+		/* Copy the eye's location into the data-structure of the current */
+		/*   eye (and which is redundantly pointed to via vrRenderInfo).  */
+		vrPointGetTransFromMatrix(&eye->loc, &eye_rwpos);
+
+		/* the real-world planes of the eye's view frustum, for culling */
+		_VisrenFrustumEye(&(window->eye_frustum[count_eye]), &(window->eye_corners[8 * count_eye]), pd);
+	}
+	_VisrenFrustumWindow(&(window->frustum), window->eye_frustum, window->eye_corners, num_eyes);
+
+	/* NOTE: with single-pass stereo, both eyes are rendered at once below */
+	stereo_pass = _VisrenStereoPassPossible(window);
+
+	for (count_eye = 0; count_eye < num_eyes && !stereo_pass; count_eye++) {
+		_VisrenRenderEye(renderinfo, window, count_eye);
+
+		/********************/
+		/* do the rendering */
+		vrTrace("_VisrenRenderWindow", "about to do the rendering");
+
+		/* NOTE: the ...->Render callback is for the specific type of     */
+		/*   graphics system (eg. GLX, Performer).  Currently (6/21/2001) */
+		/*   it is that routine that will then determine the correct      */
+		/*   world rendering callback to use (system, window, user).      */
+		/*   TODO: consider whether to make that determination here, and  */
+		/*     pass that callback as an argument to the ->Render callback.*/
+		vrCallbackInvokeDynamic(window->Render, 1, renderinfo);
+
+		vrTrace("_VisrenRenderWindow", "done rendering");
+	}
+
+	/*******************************************************/
+	/* render both eyes in a single pass of the Render and */
+	/*   world callbacks.  The left eye stands in as the   */
+	/*   current eye for the callbacks that only know one. */
+	if (stereo_pass) {
+		vrTrace("_VisrenRenderWindow", "about to do the single-pass stereo rendering");
+
+		for (count_eye = 0; count_eye < num_eyes; count_eye++) {
+			int	which_eye = (window->eyes[count_eye]->type == VREYE_LEFT ? VR_STEREO_LEFT : VR_STEREO_RIGHT);
+
+			stereo.eye[which_eye] = window->eyes[count_eye];
+			stereo.persp[which_eye] = window->eye_persp[count_eye];
+			if (which_eye == VR_STEREO_LEFT)
+				_VisrenRenderEye(renderinfo, window, count_eye);
+		}
+		stereo.viewport[VR_STEREO_LEFT] = window->viewport_left;
+		stereo.viewport[VR_STEREO_RIGHT] = window->viewport_right;
+
+		renderinfo->stereo = &stereo;
+		vrCallbackInvokeDynamic(window->Render, 1, renderinfo);
+		renderinfo->stereo = NULL;
+
+		/* measure: count the windows rendered in a single pass */
+		vrWindowStatsValue(window, VR_VALUE_STEREOPASS, 1.0);
+
+		vrTrace("_VisrenRenderWindow", "done single-pass stereo rendering");
+	}
+
+	/* measure: time spent in rendering each eye */
+	vrProcessStatsMark(stats, VR_TIME_RENDER1, 1);
+
+#if GFXINIT_TOP == 0 /* test of moving until after rendering -- ie. after the proper GLXcontext is set */
+	/******************************************/
+	/*** (3a) call initialization functions ***/
+	/******************************************/
+
+	/* The initialization functions are only called once per window  */
+	/*   per setting of the initialization function, so this is only */
+	/*   done when a new VisrenInit callback was assigned.           */
+	if (window->call_visreninit == 1) {
+vrPrintf("_VisrenRenderWindow()-B: Calling VisrenInit callback for window '%s' -- call_visreninit was set to 1.\n", window->name);
+		/* TODO: consider whether a per-user initialization routine */
+		/*   is important.  This implementation does not refer to a */
+		/*   per-user init callback -- because we don't know the    */
+		/*   user until we get down to phase (3c).                  */
+		vrTrace("_VisrenRenderWindow", "prep: initialization callback -- yo");
+		callback = window->VisrenInit;
+		vrCallbackInvokeDynamic(callback, 1, renderinfo);
+		window->call_visreninit = 0;
+		vrTrace("_VisrenRenderWindow", "done: initialization callback");
+	}
+
+	/* measure: time spent in init function */
+	vrProcessStatsMark(stats, VR_TIME_INIT, 1);
+#endif
+
+	sprintf(trace_msg, "ending window render loop for window '%s'", window->name);
+	vrTrace("_VisrenRenderWindow", trace_msg);
+
+}
+
+
+/*****************************************************************************/
+/* _VisrenThreadBarrierInit(): set up a barrier for the given number of      */
+/*   clients (the render threads, plus the process).                         */
+static void _VisrenThreadBarrierInit(_VisrenThreadBarrier *barrier, int num_clients)
+{
+	pthread_mutex_init(&(barrier->lock), NULL);
+	pthread_cond_init(&(barrier->cond), NULL);
+	barrier->num_clients = num_clients;
+	barrier->num_waiting = 0;
+	barrier->passes = 0;
+}
+
+
+/*****************************************************************************/
+/* _VisrenThreadBarrierPass(): let the waiting clients through (the lock     */
+/*   must be held).                                                          */
+static void _VisrenThreadBarrierPass(_VisrenThreadBarrier *barrier)
+{
+	barrier->num_waiting = 0;
+	barrier->passes++;
+	pthread_cond_broadcast(&(barrier->cond));
+}
+
+
+/*****************************************************************************/
+/* _VisrenThreadBarrierSync(): wait until all the clients have reached the   */
+/*   barrier.  The waiting is for the count of passes to change, so a pass   */
+/*   is never missed, however soon the next one begins.                      */
+static void _VisrenThreadBarrierSync(_VisrenThreadBarrier *barrier)
+{
+	unsigned long	pass;
+
+	pthread_mutex_lock(&(barrier->lock));
+	pass = barrier->passes;
+	if (++barrier->num_waiting >= barrier->num_clients) {
+		_VisrenThreadBarrierPass(barrier);
+	} else {
+		while (barrier->passes == pass)
+			pthread_cond_wait(&(barrier->cond), &(barrier->lock));
+	}
+	pthread_mutex_unlock(&(barrier->lock));
+}
+
+
+/*****************************************************************************/
+/* _VisrenThreadBarrierDecrement(): remove a client (a render thread that    */
+/*   couldn't be started) -- which may leave the others all waiting.         */
+static void _VisrenThreadBarrierDecrement(_VisrenThreadBarrier *barrier)
+{
+	pthread_mutex_lock(&(barrier->lock));
+	barrier->num_clients--;
+	if (barrier->num_waiting > 0 && barrier->num_waiting >= barrier->num_clients)
+		_VisrenThreadBarrierPass(barrier);
+	pthread_mutex_unlock(&(barrier->lock));
+}
+
+
+/*****************************************************************************/
+/* _VisrenThreadValues(): add the stats values summed by the render threads  */
+/*   (see vrWindowStatsValue()) to those of the process -- or set those the  */
+/*   threads set (see vrWindowStatsValueSet()) -- and clear them for the     */
+/*   next frame.  This must only be called once the threads are waiting    */
+/*   at the "thread_start" barrier.                                         */
+static void _VisrenThreadValues(_VisrenPrivate *visren_aux, vrProcessStats *stats)
+{
+	vrWindowInfo	*window;
+	int		count_thread;
+	int		value;
+
+	for (count_thread = 0; count_thread < visren_aux->num_threads; count_thread++) {
+		window = visren_aux->threads[count_thread].window;
+		for (value = 0; value < VR_MAXSTATSVALUES; value++) {
+			if (window->thread_values_set & (1U << value))
+				vrProcessStatsValue(stats, value, window->thread_values[value], 0);
+			else if (window->thread_values[value] != 0.0)
+				vrProcessStatsValue(stats, value, window->thread_values[value], 1);
+			window->thread_values[value] = 0.0;
+		}
+		window->thread_values_set = 0;
+	}
+}
+
+
+/*****************************************************************************/
+/* _VisrenWindowThread(): the main function of a window's render thread.     */
+/*   The window is opened here, so that its graphics context is made current */
+/*   in this thread, and then each frame the thread waits for the visren     */
+/*   process to start the frame, swaps and renders the window, and reports   */
+/*   back at the "thread_done" barrier.                                      */
+static void *_VisrenWindowThread(void *param)
+{
+	_VisrenThreadInfo	*thread = (_VisrenThreadInfo *)param;
+	vrProcessInfo		*myproc_info = thread->proc;
+	_VisrenPrivate		*visren_aux = myproc_info->aux_data;
+	vrWindowInfo		*window = thread->window;
+	vrRenderInfo		*renderinfo = thread->renderinfo;
+	vrTime			start_wtime;
+
+	vrTrace("_VisrenWindowThread", "opening a window");
+	vrCallbackInvoke(window->Open);
+	vrTrace("_VisrenWindowThread", "done: opening a window");
+
+	/* make the visual rendering initialization callback */
+	/*   NOTE: the correct GLX context should be active from the Open Callback */
+	vrCallbackInvokeDynamic(window->VisrenInit, 1, renderinfo);
+	window->call_visreninit = 0;
+
+	/* let vrVisrenInitProc() know that this window is ready */
+	_VisrenThreadBarrierSync(&(visren_aux->thread_done));
+
+	while (1) {
+		_VisrenThreadBarrierSync(&(visren_aux->thread_start));
+		if (visren_aux->threads_end)
+			break;
+		start_wtime = vrCurrentWallTime();
+
+		/* report any errors of the previous frame, and swap the graphics */
+		vrCallbackInvoke(window->Errors);
+		vrCallbackInvoke(window->Swap);
+		if (window->SwapWait != NULL)
+			vrCallbackInvoke(window->SwapWait);
+
+		thread->render_time = vrCurrentWallTime();
+		_VisrenRenderWindow(myproc_info, window, renderinfo, NULL);
+		thread->render_time = vrCurrentWallTime() - thread->render_time;
+
+		/* measure: time this thread spent swapping & rendering */
+		if (thread->stats_value >= 0)
+			vrProcessStatsValue(myproc_info->stats, thread->stats_value, (vrCurrentWallTime() - start_wtime) * 1000.0, 0);
+
+		_VisrenThreadBarrierSync(&(visren_aux->thread_done));
+	}
+
+	vrDbgPrintfN(SELDOM_DBGLVL, "_VisrenWindowThread(): render thread of window '%s' is exiting.\n", window->name);
+	return NULL;
+}
+
+
 /******************************************************************/
 /* vrVisrenInitProc(): Initialize the rendering devices assocated */
 /*   with this process.                                           */
@@ -1060,6 +2132,7 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 	_VisrenPrivate	*visren_aux;
 	vrRenderInfo	*renderinfo;				/* information passed to each render routine */
 	vrCallback	*callback;
+	_VisrenThreadInfo *thread;
 	int		wincount;
 	int		count;
 	int		total_eyes = 0;
@@ -1088,6 +2161,8 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 	myproc_info->aux_data = (_VisrenPrivate *)vrShmemAlloc(sizeof(_VisrenPrivate));
 	visren_aux = myproc_info->aux_data;
 	visren_aux->renderinfo = (vrRenderInfo *)vrShmemAlloc0(sizeof(vrRenderInfo));
+	visren_aux->budget_cost = 0.0;		/* ie. no frames rendered yet */
+	visren_aux->budget_dev = 0.0;
 
 	renderinfo = visren_aux->renderinfo;
 	renderinfo->persp = (vrPerspData *)vrShmemAlloc(sizeof(vrPerspData));
@@ -1100,6 +2175,22 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 	renderinfo->frame_count = -1;	/* We haven't even begun to start rendering frames */
 	renderinfo->gfx_context = NULL;	/* This is set and used by the application programmer */
 
+	/* count the windows that are to be rendered by threads of their own, */
+	/*   and create the barriers at which they meet with this process.    */
+	visren_aux->num_threads = 0;
+	visren_aux->threads_end = 0;
+	visren_aux->thread_pid = getpid();
+	for (wincount = 0; wincount < myproc_info->num_things; wincount++) {
+		if (myproc_info->things[wincount] != NULL && ((vrWindowInfo *)(myproc_info->things[wincount]))->render_thread)
+			visren_aux->num_threads++;
+	}
+	if (visren_aux->num_threads > 0) {
+		visren_aux->threads = (_VisrenThreadInfo *)vrShmemAlloc0(visren_aux->num_threads * sizeof(_VisrenThreadInfo));
+		_VisrenThreadBarrierInit(&(visren_aux->thread_start), visren_aux->num_threads+1);
+		_VisrenThreadBarrierInit(&(visren_aux->thread_done), visren_aux->num_threads+1);
+	}
+	thread = visren_aux->threads;
+
 	/* copy window info pointers into static array (to avoid the many   */
 	/*   levels of indirection) and initialize the windows as necessary */
 	visren_aux->num_windows = myproc_info->num_things;
@@ -1114,6 +2205,12 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 			continue;
 		}
 		vrCalcPerspIntermediaries(visren_aux->curr_window);	/* do some pre-calculations for the perspective matrix */
+		if (visren_aux->curr_window->num_eyes > 0) {
+			visren_aux->curr_window->persp_cache = (vrPerspCache *)vrShmemAlloc0(visren_aux->curr_window->num_eyes * sizeof(vrPerspCache));
+			visren_aux->curr_window->eye_persp = (vrPerspData *)vrShmemAlloc0(visren_aux->curr_window->num_eyes * sizeof(vrPerspData));
+			visren_aux->curr_window->eye_frustum = (vrFrustumPlanes *)vrShmemAlloc0(visren_aux->curr_window->num_eyes * sizeof(vrFrustumPlanes));
+			visren_aux->curr_window->eye_corners = (vrPoint *)vrShmemAlloc0(8 * visren_aux->curr_window->num_eyes * sizeof(vrPoint));
+		}
 
 		/* set the initial rendering callbacks to the global values */
 		visren_aux->curr_window->VisrenInit = vrContext->callbacks->VisrenInit;
@@ -1122,6 +2219,32 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 		visren_aux->curr_window->VisrenFrame = vrContext->callbacks->VisrenFrame;
 		visren_aux->curr_window->VisrenWorld = vrContext->callbacks->VisrenWorld;
 		visren_aux->curr_window->VisrenSim = vrContext->callbacks->VisrenSim;
+		visren_aux->curr_window->VisrenWorldStereo = vrContext->callbacks->VisrenWorldStereo;
+
+		/* windows with a render thread are opened (and initialized) by */
+		/*   that thread, so that the graphics context is current there. */
+		if (visren_aux->curr_window->render_thread) {
+			thread->proc = myproc_info;
+			thread->window = visren_aux->curr_window;
+			thread->stats_value = (wincount < VR_MAXWINDOWVALUES ? VR_VALUE_WINDOW0 + wincount : -1);
+			thread->render_time = 0.0;
+			thread->renderinfo = (vrRenderInfo *)vrShmemMemDup(renderinfo, sizeof(vrRenderInfo));
+			thread->renderinfo->persp = (vrPerspData *)vrShmemAlloc(sizeof(vrPerspData));
+			thread->renderinfo->window = visren_aux->curr_window;
+
+			vrTrace("vrVisrenInitProc", "starting a render thread");
+			if (pthread_create(&thread->tid, NULL, _VisrenWindowThread, thread) == 0) {
+				thread++;
+				continue;
+			}
+
+			/* without a thread, render the window as any other */
+			vrErrPrintf("vrVisrenInitProc(): " RED_TEXT "unable to create a render thread for window '%s' -- rendering it in the process instead.\n" NORM_TEXT, visren_aux->curr_window->name);
+			visren_aux->curr_window->render_thread = 0;
+			visren_aux->num_threads--;
+			_VisrenThreadBarrierDecrement(&(visren_aux->thread_start));
+			_VisrenThreadBarrierDecrement(&(visren_aux->thread_done));
+		}
 
 		vrTrace("vrVisrenInitProc", "opening a window");
 		vrCallbackInvoke(visren_aux->curr_window->Open);
@@ -1136,6 +2259,12 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 		vrTrace("vrVisrenInitProc", "done: initialization callback");
 	}
 
+	/* wait for the render threads to open their windows */
+	if (visren_aux->num_threads > 0) {
+		vrDbgPrintfN(SELDOM_DBGLVL, "vrVisrenInitProc(): waiting for %d render threads to open their windows\n", visren_aux->num_threads);
+		_VisrenThreadBarrierSync(&(visren_aux->thread_done));
+	}
+
 
 	/*** TODO: we may want to wait here for the vrInput structure to be fully initialized. ***/
 	/***   (otherwise, if the rendering function tries to make use of vrInput data without ***/
@@ -1202,6 +2331,34 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 		myproc_info->stats->elem_labels[VR_TIME_SWAP]    = vrShmemStrDup("swap");
 		myproc_info->stats->elem_labels[VR_TIME_TRAVEL]  = vrShmemStrDup("");	/* TODO: in the future "travel" */
 
+		myproc_info->stats->value_labels[VR_VALUE_LATCHAGE] = vrShmemStrDup("latch-age (ms)");
+		myproc_info->stats->value_labels[VR_VALUE_FREEZECOPIED] = vrShmemStrDup("freeze-copied");
+		myproc_info->stats->value_labels[VR_VALUE_FREEZESKIPPED] = vrShmemStrDup("freeze-skipped");
+		myproc_info->stats->value_labels[VR_VALUE_FENCEWAIT] = vrShmemStrDup("fence-wait (ms)");
+		myproc_info->stats->value_labels[VR_VALUE_PERSPCACHED] = vrShmemStrDup("persp-cached");
+		myproc_info->stats->value_labels[VR_VALUE_STEREOPASS] = vrShmemStrDup("stereo-single-pass");
+		myproc_info->stats->value_labels[VR_VALUE_OVERBUDGET] = vrShmemStrDup("over-budget");
+		myproc_info->stats->value_labels[VR_VALUE_RESSCALE] = vrShmemStrDup("res-scale (%)");
+		myproc_info->stats->value_labels[VR_VALUE_CAPTURETIME] = vrShmemStrDup("capture (ms)");
+		myproc_info->stats->value_labels[VR_VALUE_CAPTUREDROPPED] = vrShmemStrDup("capture-dropped");
+		myproc_info->stats->value_labels[VR_VALUE_GPURENDER] = vrShmemStrDup("gpu-render (ms)");
+		myproc_info->stats->value_labels[VR_VALUE_GPUSWAP] = vrShmemStrDup("gpu-swap (ms)");
+		myproc_info->stats->value_labels[VR_VALUE_PHOTONLATENCY] = vrShmemStrDup("motion-to-photon (ms)");
+		myproc_info->stats->value_labels[VR_VALUE_MISSEDVBLANKS] = vrShmemStrDup("missed-vblanks");
+#ifdef GFX_OSG
+		myproc_info->stats->value_labels[VR_VALUE_PAGERREQUESTS] = vrShmemStrDup("pager-requests");
+		myproc_info->stats->value_labels[VR_VALUE_PAGERMERGED] = vrShmemStrDup("pager-merged");
+		myproc_info->stats->value_labels[VR_VALUE_PAGERWAITING] = vrShmemStrDup("pager-waiting");
+#endif
+		for (wincount = 0; wincount < visren_aux->num_windows && wincount < VR_MAXWINDOWVALUES; wincount++) {
+			char	label[256];
+
+			if (visren_aux->windows[wincount] == NULL)
+				continue;
+			sprintf(label, "render-%.200s (ms)", visren_aux->windows[wincount]->name);
+			myproc_info->stats->value_labels[VR_VALUE_WINDOW0 + wincount] = vrShmemStrDup(label);
+		}
+
 		/* And make the three rendering stats colors to be somewhat alike, */
 		/*   but distinguishable from the others.                          */
 		myproc_info->stats->elem_colors[VR_TIME_RENDER2][0] = 0.20;
@@ -1219,23 +2376,43 @@ void vrVisrenInitProc(vrProcessInfo *myproc_info)
 /******************************************************************/
 /* vrVisrenTermProc(): Terminate the rendering devices assocated  */
 /*   with this process.                                           */
-/* NOTE: currently this is a no-op.                               */
-/* TODO: consider doing something other than no-op.               */
+/* NOTE: currently this only ends any render threads.             */
+/* TODO: consider doing something more.                           */
 /******************************************************************/
 void vrVisrenTermProc(vrProcessInfo *myproc_info)
 {
+	_VisrenPrivate	*visren_aux = myproc_info->aux_data;
+	int		count;
+
+	if (visren_aux == NULL || visren_aux->num_threads == 0)
+		return;
+
+	/* the render threads only exist in the visren process itself */
+	if (visren_aux->thread_pid != getpid() || visren_aux->threads_end)
+		return;
+
+	/* release the threads from the start barrier, with the flag to exit */
+	visren_aux->threads_end = 1;
+	_VisrenThreadBarrierSync(&(visren_aux->thread_start));
+	for (count = 0; count < visren_aux->num_threads; count++) {
+		pthread_join(visren_aux->threads[count].tid, NULL);
+	}
 }
 
 
 /*****************************************************************************/
 void vrVisrenOneFrame(vrProcessInfo *myproc_info)
 {
-static	char		trace_msg[256];
 	_VisrenPrivate	*visren_aux;
 	vrRenderInfo	*renderinfo;				/* information passed to each render routine */
 	vrWindowInfo	*window;
+	vrTime		start_wtime;
+	vrTime		render_time;				/* time spent rendering the windows of this process */
+	vrTime		predicted;				/* the predicted render time of this frame */
+	float		res_scale;				/* the lowest resolution scale of the windows */
+	int		over_budget;
 	int		count_window;
-	int		count_eye;
+	int		count_thread;
 
 	visren_aux = myproc_info->aux_data;
 	renderinfo = visren_aux->renderinfo;
@@ -1247,11 +2424,15 @@ static	char		trace_msg[256];
 	for (count_window = 0; count_window < visren_aux->num_windows; count_window++) {
 		window = visren_aux->windows[count_window];
 
-		/* first report any errors that might have occurred during the rendering */
-		vrCallbackInvoke(window->Errors);
+		/* NOTE: windows with a render thread of their own are swapped by */
+		/*   that thread, since their graphics context is current there.  */
+		if (!window->render_thread) {
+			/* first report any errors that might have occurred during the rendering */
+			vrCallbackInvoke(window->Errors);
 
-		/* now swap the graphics */
-		vrCallbackInvoke(window->Swap);
+			/* now swap the graphics */
+			vrCallbackInvoke(window->Swap);
+		}
 
 		/* now copy over any callbacks that need updating */
 		/* TODO: we may want to put this inside a general lock covering all callbacks */
@@ -1264,6 +2445,22 @@ printf("vrVisrenOneFrame(): HEY, just set visreninit to %d in callback updates s
 		vrCallbackUpdate(&window->VisrenFrame, &vrContext->callbacks->VisrenFrame);
 		vrCallbackUpdate(&window->VisrenWorld, &vrContext->callbacks->VisrenWorld);
 		vrCallbackUpdate(&window->VisrenSim, &vrContext->callbacks->VisrenSim);
+
+		/* NOTE: the stereo world callback starts out as NULL, which */
+		/*   vrCallbackUpdate() doesn't expect of the original.      */
+		if (window->VisrenWorldStereo == NULL)
+			window->VisrenWorldStereo = vrContext->callbacks->VisrenWorldStereo;
+		else	vrCallbackUpdate(&window->VisrenWorldStereo, &vrContext->callbacks->VisrenWorldStereo);
+	}
+
+	/* Now wait for the swapped frames (as the graphics type requires).  */
+	/*   This is done only after all the swaps have been issued, so that */
+	/*   the windows don't each wait for the previous ones to finish.    */
+	/*   NOTE: not all the graphics types have a SwapWait callback.      */
+	for (count_window = 0; count_window < visren_aux->num_windows; count_window++) {
+		window = visren_aux->windows[count_window];
+		if (!window->render_thread && window->SwapWait != NULL)
+			vrCallbackInvoke(window->SwapWait);
 	}
 	vrTrace("vrVisrenOneFrame", "after display buffer swap & callback updates");
 
@@ -1296,205 +2493,75 @@ printf("vrVisrenOneFrame(): HEY, just set visreninit to %d in callback updates s
 	/*   handle the data sharing in sync with the visual rendering.     */
 
 
-	/************************************************************/
-	/*** (3) loop over each window of this process and render ***/
-	/************************************************************/
-	for (count_window = 0; count_window < visren_aux->num_windows; count_window++) {
-		int	num_eyes;			/* for counting through the eyes */
-
-		sprintf(trace_msg, "beginning window render loop for window %d", count_window);
-		vrTrace("vrVisrenOneFrame", trace_msg);
+	/**************************************************************/
+	/*** (3) start the render threads, then loop over the other ***/
+	/***     windows of this process and render them here.       ***/
+	/**************************************************************/
 
-		visren_aux->curr_window = visren_aux->windows[count_window];
-		renderinfo->window = visren_aux->windows[count_window];
-		renderinfo->eye = NULL;		/* the init and frame callbacks are not done on a per-eye basis */
+	/* measure: the windows predicted to go over their budget this frame */
+	predicted = _VisrenBudgetPredict(visren_aux);
+	over_budget = 0;
+	for (count_window = 0; count_window < visren_aux->num_windows; count_window++) {
+		window = visren_aux->windows[count_window];
+		if (window->frame_budget > 0.0 && predicted > window->frame_budget * 0.001)
+			over_budget++;
+	}
+	vrProcessStatsValue(myproc_info->stats, VR_VALUE_OVERBUDGET, (double)over_budget, 0);
 
-#define GFXINIT_TOP 2	/* set to 1 to do here, 0 to do after rendering, and 2 to do not at all -- or in rendering */
-#if GFXINIT_TOP == 1 /* test of moving until after rendering -- ie. after the proper GLXcontext is set */
-		/******************************************/
-		/*** (3a) call initialization functions ***/
-		/******************************************/
-
-		/* The initialization functions are only called once per window  */
-		/*   per setting of the initialization function, so this is only */
-		/*   done when a new VisrenInit callback was assigned.           */
-		if (visren_aux->curr_window->call_visreninit == 1) {
-vrPrintf("vrVisrenOneFrame()-A: Calling VisrenInit callback for window '%s' -- call_visreninit was set to 1.\n", visren_aux->curr_window->name);
-			/* TODO: consider whether a per-user initialization routine */
-			/*   is important.  This implementation does not refer to a */
-			/*   per-user init callback -- because we don't know the    */
-			/*   user until we get down to phase (3c).                  */
-			vrTrace("vrVisrenOneFrame", "prep: initialization callback");
-			callback = visren_aux->curr_window->VisrenInit;
-			vrCallbackInvokeDynamic(callback, 1, renderinfo);
-			visren_aux->curr_window->call_visreninit = 0;
-			vrTrace("vrVisrenOneFrame", "done: initialization callback");
+	if (visren_aux->num_threads > 0) {
+		for (count_thread = 0; count_thread < visren_aux->num_threads; count_thread++) {
+			visren_aux->threads[count_thread].renderinfo->frame_stime = renderinfo->frame_stime;
+			visren_aux->threads[count_thread].renderinfo->frame_count = renderinfo->frame_count;
 		}
+		_VisrenThreadBarrierSync(&(visren_aux->thread_start));
+	}
 
-		/* measure: time spent in init function */
-		vrProcessStatsMark(myproc_info->stats, VR_TIME_INIT, 1);
-#endif
-
-		/*********************************/
-		/*** (3b) call frame functions ***/
-		/*********************************/
-
-		/* NOTE: frame functions are called once per frame, per window */
-
-
-		/* call global frame function (same for all windows) */
-		vrCallbackInvokeDynamic(vrContext->callbacks->VisrenFrame, 1, renderinfo);
-		vrTrace("vrVisrenOneFrame", "after GENERAL visrenframe callback");
-
-		/* TODO: add window-specific frame callback (VR_ONE_DISPLAY_FRAME) */
-
-#if 0 /* TODO: determine if we can to call user-specific frame functions here  */
-/* Hmmm, here is probably bad since we don't know which user we are    */
-/* until we know what eye we're rendering for.  Perhaps it should just */
-/* be a generic user-specific rendering supplement.                    */
-		/* invoke this user's frame function ... */
-		vrCallbackInvokeDynamic(visren_aux->curr_user->VisrenFrame, 1, renderinfo);
-		vrTrace("vrVisrenOneFrame", "after USER visrenframe callback");
-#endif
-		/* measure: time spent in frame function */
-		vrProcessStatsMark(myproc_info->stats, VR_TIME_FRAME, 1);
-
-
-		/****************************/
-		/*** (3c) foreach eye ... ***/
-		/****************************/
-		num_eyes = visren_aux->curr_window->num_eyes;
-		if (num_eyes == 0) {
-			/* There's no reason to continue the loop with no eyes.  Is there?*/
+	render_time = vrCurrentWallTime();
+	for (count_window = 0; count_window < visren_aux->num_windows; count_window++) {
+		window = visren_aux->windows[count_window];
+		if (window->render_thread)
 			continue;
-		}
 
-		for (count_eye = 0; count_eye < num_eyes; count_eye++) {
-			vrMatrix	head_rwpos;
-			vrMatrix	eye_rwpos;
-
-			visren_aux->curr_eye = visren_aux->curr_window->eyes[count_eye];
-			visren_aux->curr_user = visren_aux->curr_eye->user;
-			renderinfo->eye = visren_aux->curr_eye;
-			vrLockReadSet(renderinfo->eye->user->app_lock);		/* NOTE: this can probably go away if the user->visren_Xw2Yw data are double buffered in the call to vrFrame() */
-			vrLockReadSet(visren_aux->curr_user->visren_lock);	/* NOTE: there is probably no need for this anymore -- not that it did much in the past */
-			renderinfo->rw2vw_xform = visren_aux->curr_user->visren_rw2vw;
-			renderinfo->vw2rw_xform = visren_aux->curr_user->visren_vw2rw;
-			vrLockReadRelease(visren_aux->curr_user->visren_lock);	/* NOTE: there is probably no need for this anymore -- not that it did much in the past */
-			vrLockReadRelease(renderinfo->eye->user->app_lock);	/* NOTE: this can probably go away if the user->visren_Xw2Yw data are double buffered in the call to vrFrame() */
-
-			/***********************************************************/
-			/* now compute the current eye position based on the world */
-			/*   position information from the tracker for this user.  */
-			sprintf(trace_msg, "about to calculate the eye position for eye %d", count_eye);
-			vrTrace("vrVisrenOneFrame", trace_msg);
-
-#if 0 /* 1 = the unsynced version, 0 = the new frozen-data-storage version */
-			vrMatrixGet6sensorValuesDirectNoLastUpdate(&head_rwpos, visren_aux->curr_user->head);
-#else
-			/* NOTE: no need for a read-lock, since this value can */
-			/*   only be written in phase 3 of this loop.          */
-			vrMatrixCopy(&head_rwpos, visren_aux->curr_user->visren_headpos);
-#endif
-			vrMatrixCopy(&eye_rwpos, &head_rwpos);
+		visren_aux->curr_window = window;
+		start_wtime = vrCurrentWallTime();
 
-			switch (visren_aux->curr_eye->type) {
-			case VREYE_DEFAULT:
-			case VREYE_CYCLOPS:
-				/* NOP: leave the eye at the generic head position */
-#ifndef VIBRATE_TEST	/* when testing vibrate mode have the cyclops renderings fall into the vibrate code */
-				break;
-#endif
-			case VREYE_VIBRATE:
-				if ((renderinfo->frame_count / 20) % 2) {
-					vrMatrixPostTranslate3d(&eye_rwpos, /*-visren_aux->curr_user->iod */-.3 * 0.5, 0.0, 0.0);
-				} else {
-					vrMatrixPostTranslate3d(&eye_rwpos, /* visren_aux->curr_user->iod */.3 * 0.5, 0.0, 0.0);
-				}
-				break;
-			case VREYE_LEFT:
-				/* TODO: the sign seems backward on these, need to figure */
-				/*  out why the left eye is translated in positive-X, etc.*/
-				/*  3/5/3 -- that was yesterday, today, it appears that   */
-				/*  yesterday's change was backward, so I went back to the*/
-				/*  way it was.                                           */
-				vrMatrixPostTranslate3d(&eye_rwpos, -visren_aux->curr_user->iod * 0.5, 0.0, 0.0);
-				break;
-			case VREYE_RIGHT:
-				vrMatrixPostTranslate3d(&eye_rwpos,  visren_aux->curr_user->iod * 0.5, 0.0, 0.0);
-				break;
-
-
-			default:
-				/* TODO: error */
-				break;
-			}
+		_VisrenRenderWindow(myproc_info, window, renderinfo, myproc_info->stats);
 
-			/**********************************************************/
-			/* now compute the perspective matrix for this window/eye */
-			vrTrace("vrVisrenOneFrame", "about to calculate the perspective matrix");
-
-			/* TODO: for hand-based displays, we'll need to give information  */
-			/*   on where the window is located to vrCalcPerspMatrix().       */
-			/*   This could be done either by putting that info in the        */
-			/*   renderinfo->window structure, or by passing another argument.*/
-			/*   I prefer the former [BS: 9/13/2000].                         */
-#ifdef USE_FRUSTUMEYE
-			vrCalcPerspFrustumEye(renderinfo->persp, renderinfo->window, &eye_rwpos);
-#else
-			vrCalcPerspMatrix(renderinfo->persp, renderinfo->window, &eye_rwpos);
-#endif
-
-			/* Copy the eye's location into the data-structure of the current */
-			/*   eye (and which is redundantly pointed to via vrRenderInfo).  */
-			vrPointGetTransFromMatrix(&renderinfo->eye->loc, &eye_rwpos);
-
-			/********************/
-			/* do the rendering */
-			vrTrace("vrVisrenOneFrame", "about to do the rendering");
-
-			/* NOTE: the ...->Render callback is for the specific type of     */
-			/*   graphics system (eg. GLX, Performer).  Currently (6/21/2001) */
-			/*   it is that routine that will then determine the correct      */
-			/*   world rendering callback to use (system, window, user).      */
-			/*   TODO: consider whether to make that determination here, and  */
-			/*     pass that callback as an argument to the ->Render callback.*/
-			vrCallbackInvokeDynamic(visren_aux->windows[count_window]->Render, 1, renderinfo);
+		/* measure: time spent rendering this window */
+		if (count_window < VR_MAXWINDOWVALUES)
+			vrProcessStatsValue(myproc_info->stats, VR_VALUE_WINDOW0 + count_window, (vrCurrentWallTime() - start_wtime) * 1000.0, 0);
+	}
+	render_time = vrCurrentWallTime() - render_time;
 
-			vrTrace("vrVisrenOneFrame", "done rendering");
-		}
+	/* Wait for the render threads to be done with their windows, */
+	/*   so that all the windows are ready for the next swap.      */
+	if (visren_aux->num_threads > 0) {
+		vrTrace("vrVisrenOneFrame", "waiting for the render threads");
+		_VisrenThreadBarrierSync(&(visren_aux->thread_done));
 
-		/* measure: time spent in rendering each eye */
+		/* measure: time spent waiting for the render threads */
 		vrProcessStatsMark(myproc_info->stats, VR_TIME_RENDER1, 1);
 
-#if GFXINIT_TOP == 0 /* test of moving until after rendering -- ie. after the proper GLXcontext is set */
-		/******************************************/
-		/*** (3a) call initialization functions ***/
-		/******************************************/
-
-		/* The initialization functions are only called once per window  */
-		/*   per setting of the initialization function, so this is only */
-		/*   done when a new VisrenInit callback was assigned.           */
-		if (visren_aux->curr_window->call_visreninit == 1) {
-vrPrintf("vrVisrenOneFrame()-B: Calling VisrenInit callback for window '%s' -- call_visreninit was set to 1.\n", visren_aux->curr_window->name);
-			/* TODO: consider whether a per-user initialization routine */
-			/*   is important.  This implementation does not refer to a */
-			/*   per-user init callback -- because we don't know the    */
-			/*   user until we get down to phase (3c).                  */
-			vrTrace("vrVisrenOneFrame", "prep: initialization callback -- yo");
-			callback = visren_aux->curr_window->VisrenInit;
-			vrCallbackInvokeDynamic(callback, 1, renderinfo);
-			visren_aux->curr_window->call_visreninit = 0;
-			vrTrace("vrVisrenOneFrame", "done: initialization callback");
+		/* now that the threads are done, add in what they measured */
+		_VisrenThreadValues(visren_aux, myproc_info->stats);
+
+		/* the threads render alongside this process, so the frame */
+		/*   takes as long as the slowest of them (or the process). */
+		for (count_thread = 0; count_thread < visren_aux->num_threads; count_thread++) {
+			if (visren_aux->threads[count_thread].render_time > render_time)
+				render_time = visren_aux->threads[count_thread].render_time;
 		}
+	}
 
-		/* measure: time spent in init function */
-		vrProcessStatsMark(myproc_info->stats, VR_TIME_INIT, 1);
-#endif
+	_VisrenBudgetUpdate(visren_aux, render_time);
 
-		sprintf(trace_msg, "ending window render loop for window %d", count_window);
-		vrTrace("vrVisrenOneFrame", trace_msg);
+	/* measure: the lowest resolution scale of the windows this frame */
+	res_scale = 1.0;
+	for (count_window = 0; count_window < visren_aux->num_windows; count_window++) {
+		if (visren_aux->windows[count_window]->res_scale < res_scale)
+			res_scale = visren_aux->windows[count_window]->res_scale;
 	}
+	vrProcessStatsValue(myproc_info->stats, VR_VALUE_RESSCALE, res_scale * 100.0, 0);
 }
 
 
@@ -1687,6 +2754,7 @@ static void vrVisrenDefaultInfo(vrWindowInfo *info)
 	info->RenderSimulator = vrCallbackCreateNamed("DefWindow:RenderSim-DN", vrDoNothing, 0);
 	info->RenderTransform = vrCallbackCreateNamed("DefWindow:Transform-DN", vrDoNothing, 0);
 	info->Swap = vrCallbackCreateNamed("DefWindow:Swap-DN", vrDoNothing, 0);
+	info->SwapWait = vrCallbackCreateNamed("DefWindow:SwapWait-DN", vrDoNothing, 0);
 	info->Errors = vrCallbackCreateNamed("DefWindow:Errors-DN", vrDoNothing, 0);
 	info->Close = vrCallbackCreateNamed("DefWindow:Close-DN", vrDoNothing, 0);
 }
@@ -1726,6 +2794,14 @@ void vrVisrenGetInfo(vrWindowInfo *info)
 		vrVisrenDefaultInfo(info);
 		return;
 	} else {
+#ifdef WIN_EGL
+		/* run the configuration's GLX windows headless -- and say so */
+		/*   in the window, so the X11 inputs know not to use it.     */
+		if (getenv("FREEVR_HEADLESS") != NULL && !strcmp(graphics, "glx")) {
+			graphics = "egl";
+			info->graphics = vrShmemStrDup(graphics);
+		}
+#endif
 		option = vrVisrenOpts;
 		while (option->option_name != NULL) {
 			if (!strcmp(option->option_name, graphics)) {
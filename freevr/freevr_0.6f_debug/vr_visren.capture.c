@@ -0,0 +1,871 @@
+/* ======================================================================
+ *
+ *  CCCCC          vr_visren.capture.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for the frame capture (recording) and shared-memory export
+ *   of windows shared by the OpenGL visual rendering types (GLX and EGL).
+ *
+ * A synchronous glReadPixels() of each frame waits for the GPU to finish
+ *   the frame, and then for the copy -- which can halve the frame rate.
+ *   Instead, each frame is read into one of a ring of pixel-pack buffer
+ *   objects, which returns at once, and the frame is only copied out of
+ *   the buffer a couple of frames later, when the GPU is long done with
+ *   it.  The conversion and writing of the frames is done by a writer
+ *   thread, so the only cost left to the rendering is that one copy.
+ *
+ * The capture of a window is started and stopped with the telnet command
+ *   "window[<num>] capture {start [<file>]|stop}", or started from the
+ *   first frame with the "capture=<file>" window argument.  The format
+ *   is chosen by the extension of the file:
+ *	".y4m" -- a YUV4MPEG2 stream (eg. for "ffmpeg -i capture.y4m ...")
+ *	".png" -- a series of PNG files, with the frame number added to the
+ *		name (eg. "capture_00042.png").  The images are not
+ *		compressed, to keep the writer's cost down.
+ *	other  -- bare 24-bit RGB frames (eg. for "ffmpeg -f rawvideo
+ *		-pix_fmt rgb24 -s <width>x<height> -i capture.rgb ...")
+ *
+ * The same buffered frames can also be exported -- put into a ring of
+ *   slots in a POSIX shared-memory object, from where a local program
+ *   (eg. a compositor, or a streaming encoder) can use them in place.
+ *   Beyond the one copy out of the buffer, there are no copies, and the
+ *   rendering never waits for a reader.  An export is started and stopped
+ *   with "window[<num>] export {start [<name>]|stop}", or the "export=<name>"
+ *   window argument.  The layout of the object is in vr_fbexport.h, and
+ *   fbexportread.c is an example reader.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "vr_visren.capture.h"
+#include "vr_debug.h"
+#include "vr_shmem.h"	/* for vrMemoryBarrier() */
+
+
+/****************************************************************************/
+/* The buffer object functions (OpenGL 2.1, or GL_ARB_pixel_buffer_object)  */
+/*   are fetched at run-time, since the GL library to which we link need not */
+/*   have them.  The addresses are the same for every context, so they are  */
+/*   only fetched once per process.                                          */
+static	PFNGLGENBUFFERSPROC		glGenBuffers_func = NULL;
+static	PFNGLDELETEBUFFERSPROC		glDeleteBuffers_func = NULL;
+static	PFNGLBINDBUFFERPROC		glBindBuffer_func = NULL;
+static	PFNGLBUFFERDATAPROC		glBufferData_func = NULL;
+static	PFNGLMAPBUFFERPROC		glMapBuffer_func = NULL;
+static	PFNGLUNMAPBUFFERPROC		glUnmapBuffer_func = NULL;
+
+/* the CRC table of the PNG chunks -- made once per process */
+static	unsigned long			crc_table[256];
+static	pthread_once_t			crc_table_once = PTHREAD_ONCE_INIT;
+
+
+/****************************************************************************/
+/* _CaptureLoadFuncs(): returns 1 if the pixel buffer object functions are   */
+/*   available to the current context, after fetching them if not already   */
+/*   fetched.                                                                */
+static int _CaptureLoadFuncs(void *(*getproc)(const char *))
+{
+	const char	*version = (const char *)glGetString(GL_VERSION);
+	const char	*extensions = (const char *)glGetString(GL_EXTENSIONS);
+	int		major = 0;
+	int		minor = 0;
+
+	if (version != NULL)
+		sscanf(version, "%d.%d", &major, &minor);
+	if ((major < 2 || (major == 2 && minor < 1)) && (extensions == NULL || strstr(extensions, "GL_ARB_pixel_buffer_object") == NULL))
+		return 0;
+
+	if (glUnmapBuffer_func == NULL) {
+		glGenBuffers_func = (PFNGLGENBUFFERSPROC)getproc("glGenBuffers");
+		glDeleteBuffers_func = (PFNGLDELETEBUFFERSPROC)getproc("glDeleteBuffers");
+		glBindBuffer_func = (PFNGLBINDBUFFERPROC)getproc("glBindBuffer");
+		glBufferData_func = (PFNGLBUFFERDATAPROC)getproc("glBufferData");
+		glMapBuffer_func = (PFNGLMAPBUFFERPROC)getproc("glMapBuffer");
+		glUnmapBuffer_func = (PFNGLUNMAPBUFFERPROC)getproc("glUnmapBuffer");
+	}
+
+	return (glGenBuffers_func != NULL && glDeleteBuffers_func != NULL
+		&& glBindBuffer_func != NULL && glBufferData_func != NULL
+		&& glMapBuffer_func != NULL && glUnmapBuffer_func != NULL);
+}
+
+
+/****************************************************************************/
+static void _CaptureMakeCrcTable()
+{
+	unsigned long	c;
+	int		n, k;
+
+	for (n = 0; n < 256; n++) {
+		c = (unsigned long)n;
+		for (k = 0; k < 8; k++)
+			c = (c & 1) ? 0xedb88320L ^ (c >> 1) : c >> 1;
+		crc_table[n] = c;
+	}
+}
+
+
+/****************************************************************************/
+static unsigned long _CaptureCrc(unsigned long crc, unsigned char *buf, long len)
+{
+	long	n;
+
+	for (n = 0; n < len; n++)
+		crc = crc_table[(crc ^ buf[n]) & 0xff] ^ (crc >> 8);
+	return crc;
+}
+
+
+/****************************************************************************/
+static void _CapturePut32(unsigned char *buf, unsigned long value)
+{
+	buf[0] = (value >> 24) & 0xff;
+	buf[1] = (value >> 16) & 0xff;
+	buf[2] = (value >>  8) & 0xff;
+	buf[3] =  value        & 0xff;
+}
+
+
+/****************************************************************************/
+/* _CaptureRGBRow(): the RGB of one row of a frame (counting from the top). */
+static void _CaptureRGBRow(vrCaptureInfo *capture, unsigned char *frame, int row, unsigned char *rgb)
+{
+	unsigned char	*src = frame + (long)(capture->height - 1 - row) * capture->width * 4;
+	int		count;
+
+	for (count = 0; count < capture->width; count++) {
+		rgb[count*3+0] = src[count*4+0];
+		rgb[count*3+1] = src[count*4+1];
+		rgb[count*3+2] = src[count*4+2];
+	}
+}
+
+
+/****************************************************************************/
+static void _CaptureWriteRaw(vrCaptureInfo *capture, unsigned char *frame, unsigned char *rgb)
+{
+	int	row;
+
+	for (row = 0; row < capture->height; row++) {
+		_CaptureRGBRow(capture, frame, row, rgb);
+		fwrite(rgb, 3, capture->width, capture->fp);
+	}
+}
+
+
+/****************************************************************************/
+/* _CaptureWriteY4M(): write a frame as YUV 4:2:0 (with the full-range      */
+/*   BT.601 conversion of JPEG) -- each chroma sample is the average of its */
+/*   2x2 block.                                                             */
+static void _CaptureWriteY4M(vrCaptureInfo *capture, unsigned char *frame, unsigned char *plane)
+{
+	int		cwidth = (capture->width + 1) / 2;
+	int		cheight = (capture->height + 1) / 2;
+	unsigned char	*p;
+	int		x, y, x2, y2;
+	int		r, g, b;
+	int		samples;
+
+	fputs("FRAME\n", capture->fp);
+
+	/* Y -- from the top row down */
+	for (y = 0; y < capture->height; y++) {
+		p = frame + (long)(capture->height - 1 - y) * capture->width * 4;
+		for (x = 0; x < capture->width; x++, p += 4)
+			plane[(long)y * capture->width + x] = (unsigned char)((77 * p[0] + 150 * p[1] + 29 * p[2]) >> 8);
+	}
+	fwrite(plane, 1, (long)capture->width * capture->height, capture->fp);
+
+	/* U & V -- averaged over each 2x2 block */
+	for (y = 0; y < cheight; y++) {
+		for (x = 0; x < cwidth; x++) {
+			r = g = b = samples = 0;
+			for (y2 = y*2; y2 < y*2+2 && y2 < capture->height; y2++) {
+				for (x2 = x*2; x2 < x*2+2 && x2 < capture->width; x2++) {
+					p = frame + ((long)(capture->height - 1 - y2) * capture->width + x2) * 4;
+					r += p[0];
+					g += p[1];
+					b += p[2];
+					samples++;
+				}
+			}
+			r /= samples;
+			g /= samples;
+			b /= samples;
+			plane[(long)y * cwidth + x] = (unsigned char)((-43 * r - 85 * g + 128 * b + 32768) >> 8);
+			plane[(long)cwidth * cheight + (long)y * cwidth + x] = (unsigned char)((128 * r - 107 * g - 21 * b + 32768) >> 8);
+		}
+	}
+	fwrite(plane, 1, (long)cwidth * cheight * 2, capture->fp);
+}
+
+
+/****************************************************************************/
+/* _CaptureWritePNG(): write a frame to a PNG file of its own.  The image   */
+/*   data is put in "stored" (uncompressed) deflate blocks, which needs no  */
+/*   compression library, and costs the writer little more than a copy.    */
+static void _CaptureWritePNG(vrCaptureInfo *capture, unsigned char *frame, unsigned char *rgb, long number)
+{
+static	unsigned char	signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	char		filename[300];
+	char		*dot;
+	FILE		*fp;
+	unsigned char	head[8];
+	unsigned char	block[5];
+	unsigned char	ihdr[13];
+	unsigned long	crc;
+	unsigned long	adler_a = 1;
+	unsigned long	adler_b = 0;
+	long		row_size = (long)capture->width * 3 + 1;
+	long		data_size = row_size * capture->height;
+	long		idat_size;
+	long		left;
+	long		block_left = 0;
+	long		count;
+	int		row;
+
+	/* the frame number goes before the extension */
+	dot = strrchr(capture->file, '.');
+	sprintf(filename, "%.*s_%05ld.png", (int)(dot - capture->file), capture->file, number);
+	if ((fp = fopen(filename, "wb")) == NULL) {
+		vrErrPrintf("_CaptureWritePNG(): " RED_TEXT "unable to write '%s'.\n" NORM_TEXT, filename);
+		return;
+	}
+
+	fwrite(signature, 1, 8, fp);
+
+	/* IHDR: 8-bit RGB, no interlace */
+	_CapturePut32(ihdr+0, capture->width);
+	_CapturePut32(ihdr+4, capture->height);
+	ihdr[8] = 8;
+	ihdr[9] = 2;
+	ihdr[10] = ihdr[11] = ihdr[12] = 0;
+	_CapturePut32(head+0, 13);
+	memcpy(head+4, "IHDR", 4);
+	fwrite(head, 1, 8, fp);
+	fwrite(ihdr, 1, 13, fp);
+	crc = _CaptureCrc(0xffffffffL, head+4, 4);
+	crc = _CaptureCrc(crc, ihdr, 13);
+	_CapturePut32(head, crc ^ 0xffffffffL);
+	fwrite(head, 1, 4, fp);
+
+	/* IDAT: the zlib header, the stored blocks (of up to 65535 bytes), and the Adler-32 */
+	idat_size = 2 + data_size + 5 * ((data_size + 65534) / 65535) + 4;
+	_CapturePut32(head+0, idat_size);
+	memcpy(head+4, "IDAT", 4);
+	fwrite(head, 1, 8, fp);
+	crc = _CaptureCrc(0xffffffffL, head+4, 4);
+	block[0] = 0x78;
+	block[1] = 0x01;
+	fwrite(block, 1, 2, fp);
+	crc = _CaptureCrc(crc, block, 2);
+
+	left = data_size;
+	for (row = 0; row < capture->height; row++) {
+		unsigned char	*data = rgb;
+		long		data_left = row_size;
+
+		rgb[0] = 0;		/* no filter */
+		_CaptureRGBRow(capture, frame, row, rgb + 1);
+		for (count = 0; count < row_size; count++) {
+			adler_a = (adler_a + rgb[count]) % 65521;
+			adler_b = (adler_b + adler_a) % 65521;
+		}
+
+		while (data_left > 0) {
+			long	chunk;
+
+			if (block_left == 0) {
+				block_left = (left > 65535 ? 65535 : left);
+				block[0] = (left == block_left ? 1 : 0);	/* the last block is flagged */
+				block[1] = block_left & 0xff;
+				block[2] = (block_left >> 8) & 0xff;
+				block[3] = ~block_left & 0xff;
+				block[4] = (~block_left >> 8) & 0xff;
+				fwrite(block, 1, 5, fp);
+				crc = _CaptureCrc(crc, block, 5);
+			}
+			chunk = (data_left < block_left ? data_left : block_left);
+			fwrite(data, 1, chunk, fp);
+			crc = _CaptureCrc(crc, data, chunk);
+			data += chunk;
+			data_left -= chunk;
+			block_left -= chunk;
+			left -= chunk;
+		}
+	}
+	_CapturePut32(head, (adler_b << 16) | adler_a);
+	fwrite(head, 1, 4, fp);
+	crc = _CaptureCrc(crc, head, 4);
+	_CapturePut32(head, crc ^ 0xffffffffL);
+	fwrite(head, 1, 4, fp);
+
+	/* IEND */
+	_CapturePut32(head+0, 0);
+	memcpy(head+4, "IEND", 4);
+	fwrite(head, 1, 8, fp);
+	_CapturePut32(head, _CaptureCrc(0xffffffffL, head+4, 4) ^ 0xffffffffL);
+	fwrite(head, 1, 4, fp);
+
+	fclose(fp);
+}
+
+
+/****************************************************************************/
+/* _CaptureWriterThread(): the body of a capture's writer thread.  It waits */
+/*   for frames in the queue, and writes them in order.  When told to quit, */
+/*   it first writes all the frames still in the queue.                     */
+static void *_CaptureWriterThread(void *data)
+{
+	vrCaptureInfo	*capture = (vrCaptureInfo *)data;
+	unsigned char	*frame;
+	unsigned char	*work;		/* a row (RAW & PNG) or the planes (Y4M) of the conversion */
+
+	work = (unsigned char *)malloc((long)capture->width * capture->height * 2 + capture->width * 3 + 16);
+
+	while (1) {
+		pthread_mutex_lock(&(capture->lock));
+		while (capture->queue_tail == capture->queue_head && !capture->quit)
+			pthread_cond_wait(&(capture->cond), &(capture->lock));
+		if (capture->queue_tail == capture->queue_head) {
+			pthread_mutex_unlock(&(capture->lock));
+			break;
+		}
+		frame = capture->queue[capture->queue_tail % VR_CAPTURE_QUEUE];
+		pthread_mutex_unlock(&(capture->lock));
+
+		switch (capture->format) {
+		case VR_CAPTURE_Y4M:
+			_CaptureWriteY4M(capture, frame, work);
+			break;
+		case VR_CAPTURE_PNG:
+			_CaptureWritePNG(capture, frame, work, capture->frames_written);
+			break;
+		default:
+			_CaptureWriteRaw(capture, frame, work);
+			break;
+		}
+		capture->frames_written++;
+
+		/* only now is the slot free to be reused */
+		pthread_mutex_lock(&(capture->lock));
+		capture->queue_tail++;
+		pthread_mutex_unlock(&(capture->lock));
+	}
+
+	free(work);
+	return NULL;
+}
+
+
+/****************************************************************************/
+/* _ExportPublish(): put a frame in the next slot of the shared-memory ring. */
+/*   The slot's sequence number is cleared while the frame is copied in, so  */
+/*   a reader can tell when a slot it is using has been overwritten.         */
+static void _ExportPublish(vrCaptureInfo *capture, void *pixels, int slot)
+{
+	vrFBExportHeader	*header = capture->export_header;
+	uint64_t		seq = capture->export_seq + 1;
+	int			num = (int)(seq % header->num_slots);
+
+	header->slot[num].seq = 0;
+	vrMemoryBarrier();
+	memcpy(VR_FBEXPORT_PIXELS(header, num), pixels, header->slot_size);
+	header->slot[num].frame = capture->pbo_frame[slot];
+	header->slot[num].render_wtime = capture->pbo_wtime[slot];
+	header->slot[num].publish_wtime = vrCurrentWallTime();
+	vrMemoryBarrier();
+	header->slot[num].seq = seq;
+	header->frame_seq = seq;
+
+	capture->export_seq = seq;
+}
+
+
+/****************************************************************************/
+/* _CaptureCopy(): copy a frame out of a (finished) pixel-pack buffer, to   */
+/*   each active output -- the writer's queue (unless full, in which case   */
+/*   the frame is dropped from the file), and the export ring.              */
+static void _CaptureCopy(vrCaptureInfo *capture, int slot)
+{
+	long	queued = 0;
+	int	to_file = capture->active;
+	void	*pixels;
+
+	capture->pbo_pending[slot] = 0;
+
+	if (to_file) {
+		pthread_mutex_lock(&(capture->lock));
+		queued = capture->queue_head - capture->queue_tail;
+		pthread_mutex_unlock(&(capture->lock));
+		if (queued >= VR_CAPTURE_QUEUE) {
+			capture->frames_dropped++;
+			to_file = 0;
+		}
+	}
+	if (!to_file && !capture->export_active)
+		return;
+
+	glBindBuffer_func(GL_PIXEL_PACK_BUFFER, capture->pbo[slot]);
+	pixels = glMapBuffer_func(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+	if (pixels == NULL) {
+		if (to_file)
+			capture->frames_dropped++;
+		glBindBuffer_func(GL_PIXEL_PACK_BUFFER, 0);
+		return;
+	}
+
+	if (to_file) {
+		memcpy(capture->queue[capture->queue_head % VR_CAPTURE_QUEUE], pixels, (long)capture->width * capture->height * 4);
+
+		pthread_mutex_lock(&(capture->lock));
+		capture->queue_head++;
+		pthread_cond_signal(&(capture->cond));
+		pthread_mutex_unlock(&(capture->lock));
+		capture->frames_queued++;
+	}
+	if (capture->export_active)
+		_ExportPublish(capture, pixels, slot);
+
+	glUnmapBuffer_func(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer_func(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+
+/****************************************************************************/
+/* _CaptureDrain(): copy out all the frames still in the buffers, oldest   */
+/*   first -- eg. before an output is stopped.                             */
+static void _CaptureDrain(vrCaptureInfo *capture)
+{
+	int	count;
+	int	slot;
+
+	for (count = 0; count < VR_CAPTURE_PBOS; count++) {
+		slot = (capture->pbo_next + count) % VR_CAPTURE_PBOS;
+		if (capture->pbo_pending[slot])
+			_CaptureCopy(capture, slot);
+	}
+}
+
+
+/****************************************************************************/
+/* _CaptureBuffersStart(): make the ring of pixel-pack buffers, at the size */
+/*   of the window.  Returns 0 if the buffer functions aren't available.    */
+static int _CaptureBuffersStart(vrCaptureInfo *capture, vrWindowInfo *window, void *(*getproc)(const char *))
+{
+	int	count;
+
+	if (capture->buffers)
+		return 1;
+
+	if (capture->status == 0)
+		capture->status = (_CaptureLoadFuncs(getproc) ? 1 : -1);
+	if (capture->status < 0) {
+		vrErrPrintf("_CaptureBuffersStart(): " RED_TEXT "window '%s' has no pixel buffer objects -- unable to capture or export.\n" NORM_TEXT, window->name);
+		return 0;
+	}
+
+	capture->width = window->geometry.width;
+	capture->height = window->geometry.height;
+	if (capture->width <= 0 || capture->height <= 0)
+		return 0;
+
+	glGenBuffers_func(VR_CAPTURE_PBOS, capture->pbo);
+	for (count = 0; count < VR_CAPTURE_PBOS; count++) {
+		glBindBuffer_func(GL_PIXEL_PACK_BUFFER, capture->pbo[count]);
+		glBufferData_func(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)capture->width * capture->height * 4, NULL, GL_STREAM_READ);
+		capture->pbo_pending[count] = 0;
+	}
+	glBindBuffer_func(GL_PIXEL_PACK_BUFFER, 0);
+	capture->pbo_next = 0;
+	capture->frames_read = 0;
+	capture->buffers = 1;
+
+	return 1;
+}
+
+
+/****************************************************************************/
+static void _CaptureBuffersStop(vrCaptureInfo *capture)
+{
+	if (!capture->buffers)
+		return;
+
+	glDeleteBuffers_func(VR_CAPTURE_PBOS, capture->pbo);
+	capture->buffers = 0;
+}
+
+
+/****************************************************************************/
+/* _CaptureFileStart(): open the file, and start the writer thread of a     */
+/*   capture.  Returns 0 (and clears the window's request) on failure.      */
+static int _CaptureFileStart(vrCaptureInfo *capture, vrWindowInfo *window, void *(*getproc)(const char *))
+{
+	char	*ext;
+	int	count;
+
+	if (!_CaptureBuffersStart(capture, window, getproc)) {
+		window->capture_request = 0;
+		return 0;
+	}
+	capture->fps = (window->frame_budget > 0.0 ? (int)(1000.0 / window->frame_budget + 0.5) : 60);
+
+	if (window->capture_file[0] == '\0')
+		sprintf(capture->file, "capture-%.200s.y4m", window->name);
+	else	sprintf(capture->file, "%.255s", window->capture_file);
+	ext = strrchr(capture->file, '.');
+	if (ext != NULL && !strcmp(ext, ".y4m"))
+		capture->format = VR_CAPTURE_Y4M;
+	else if (ext != NULL && !strcmp(ext, ".png"))
+		capture->format = VR_CAPTURE_PNG;
+	else	capture->format = VR_CAPTURE_RAW;
+
+	capture->fp = NULL;
+	if (capture->format != VR_CAPTURE_PNG) {
+		if ((capture->fp = fopen(capture->file, "wb")) == NULL) {
+			vrErrPrintf("_CaptureFileStart(): " RED_TEXT "unable to write '%s' -- not capturing window '%s'.\n" NORM_TEXT, capture->file, window->name);
+			window->capture_request = 0;
+			return 0;
+		}
+		if (capture->format == VR_CAPTURE_Y4M)
+			fprintf(capture->fp, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", capture->width, capture->height, capture->fps);
+	} else {
+		pthread_once(&crc_table_once, _CaptureMakeCrcTable);
+	}
+
+	for (count = 0; count < VR_CAPTURE_QUEUE; count++)
+		capture->queue[count] = (unsigned char *)malloc((long)capture->width * capture->height * 4);
+
+	capture->frames_queued = 0;
+	capture->frames_written = 0;
+	capture->frames_dropped = 0;
+	capture->queue_head = 0;
+	capture->queue_tail = 0;
+	capture->quit = 0;
+	pthread_mutex_init(&(capture->lock), NULL);
+	pthread_cond_init(&(capture->cond), NULL);
+	if (pthread_create(&(capture->writer_tid), NULL, _CaptureWriterThread, (void *)capture) != 0) {
+		vrErrPrintf("_CaptureFileStart(): " RED_TEXT "unable to create the writer thread -- not capturing window '%s'.\n" NORM_TEXT, window->name);
+		for (count = 0; count < VR_CAPTURE_QUEUE; count++)
+			free(capture->queue[count]);
+		if (capture->fp != NULL)
+			fclose(capture->fp);
+		window->capture_request = 0;
+		return 0;
+	}
+	capture->active = 1;
+
+	vrDbgPrintfN(COMMON_DBGLVL, "_CaptureFileStart(): capturing window '%s' (%dx%d) to '%s'.\n",
+		window->name, capture->width, capture->height, capture->file);
+
+	return 1;
+}
+
+
+/****************************************************************************/
+/* _CaptureFileStop(): end a file capture -- the frames still in the buffers */
+/*   are handed to the writer, which finishes writing the queue before the  */
+/*   file is closed.                                                        */
+static void _CaptureFileStop(vrCaptureInfo *capture)
+{
+	int	count;
+
+	if (!capture->active)
+		return;
+
+	_CaptureDrain(capture);
+
+	pthread_mutex_lock(&(capture->lock));
+	capture->quit = 1;
+	pthread_cond_signal(&(capture->cond));
+	pthread_mutex_unlock(&(capture->lock));
+	pthread_join(capture->writer_tid, NULL);
+
+	if (capture->fp != NULL) {
+		fclose(capture->fp);
+		capture->fp = NULL;
+	}
+	for (count = 0; count < VR_CAPTURE_QUEUE; count++) {
+		free(capture->queue[count]);
+		capture->queue[count] = NULL;
+	}
+	pthread_mutex_destroy(&(capture->lock));
+	pthread_cond_destroy(&(capture->cond));
+	capture->active = 0;
+
+	vrDbgPrintfN(COMMON_DBGLVL, "_CaptureFileStop(): wrote %ld frames to '%s' (%ld dropped).\n",
+		capture->frames_written, capture->file, capture->frames_dropped);
+}
+
+
+/****************************************************************************/
+/* _ExportStart(): create (or re-create) the window's shared-memory object, */
+/*   and fill in its header.  Returns 0 (and clears the window's request) on */
+/*   failure.                                                               */
+static int _ExportStart(vrCaptureInfo *capture, vrWindowInfo *window, void *(*getproc)(const char *))
+{
+	vrFBExportHeader	*header;
+	size_t			header_size;
+	size_t			slot_size;
+
+	if (!_CaptureBuffersStart(capture, window, getproc)) {
+		window->export_request = 0;
+		return 0;
+	}
+
+	/* POSIX shared-memory names begin with a slash */
+	if (window->export_name[0] == '\0')
+		sprintf(capture->export_name, "/freevr-%.200s", window->name);
+	else if (window->export_name[0] != '/')
+		sprintf(capture->export_name, "/%.254s", window->export_name);
+	else	sprintf(capture->export_name, "%.255s", window->export_name);
+
+	/* the frames start on a page boundary, for any reader that wants to map them itself */
+	header_size = (sizeof(vrFBExportHeader) + 4095) & ~(size_t)4095;
+	slot_size = (size_t)capture->width * capture->height * 4;
+	capture->export_size = header_size + slot_size * VR_FBEXPORT_SLOTS;
+
+	capture->export_fd = shm_open(capture->export_name, O_CREAT | O_RDWR, 0644);
+	if (capture->export_fd < 0) {
+		vrErrPrintf("_ExportStart(): " RED_TEXT "unable to open shared memory '%s' (%s) -- not exporting window '%s'.\n" NORM_TEXT,
+			capture->export_name, strerror(errno), window->name);
+		window->export_request = 0;
+		return 0;
+	}
+	if (ftruncate(capture->export_fd, capture->export_size) < 0
+	    || (header = (vrFBExportHeader *)mmap(NULL, capture->export_size, PROT_READ | PROT_WRITE, MAP_SHARED, capture->export_fd, 0)) == MAP_FAILED) {
+		vrErrPrintf("_ExportStart(): " RED_TEXT "unable to map %ld bytes of shared memory '%s' (%s) -- not exporting window '%s'.\n" NORM_TEXT,
+			(long)capture->export_size, capture->export_name, strerror(errno), window->name);
+		close(capture->export_fd);
+		shm_unlink(capture->export_name);
+		window->export_request = 0;
+		return 0;
+	}
+
+	memset(header, 0, sizeof(vrFBExportHeader));
+	header->version = VR_FBEXPORT_VERSION;
+	header->width = capture->width;
+	header->height = capture->height;
+	header->bytes_per_pixel = 4;
+	header->num_slots = VR_FBEXPORT_SLOTS;
+	header->slot_size = slot_size;
+	header->slot_offset = header_size;
+	header->writer_pid = getpid();
+	header->frame_seq = 0;
+	header->writer_alive = 1;
+	vrMemoryBarrier();
+	header->magic = VR_FBEXPORT_MAGIC;	/* the header is complete */
+
+	capture->export_header = header;
+	capture->export_seq = 0;
+	capture->export_active = 1;
+
+	vrDbgPrintfN(COMMON_DBGLVL, "_ExportStart(): exporting window '%s' (%dx%d) to shared memory '%s'.\n",
+		window->name, capture->width, capture->height, capture->export_name);
+
+	return 1;
+}
+
+
+/****************************************************************************/
+/* _ExportStop(): hand out the frames still in the buffers, flag the export */
+/*   as ended, and remove the object's name -- readers that still have it   */
+/*   mapped keep it until they let go.                                      */
+static void _ExportStop(vrCaptureInfo *capture)
+{
+	if (!capture->export_active)
+		return;
+
+	_CaptureDrain(capture);
+
+	capture->export_header->writer_alive = 0;
+	munmap(capture->export_header, capture->export_size);
+	close(capture->export_fd);
+	shm_unlink(capture->export_name);
+	capture->export_header = NULL;
+	capture->export_active = 0;
+
+	vrDbgPrintfN(COMMON_DBGLVL, "_ExportStop(): exported %llu frames to '%s'.\n",
+		(unsigned long long)capture->export_seq, capture->export_name);
+}
+
+
+/*****************************************************************/
+/* vrCaptureInit(): set the defaults -- not capturing or exporting. */
+void vrCaptureInit(vrCaptureInfo *capture)
+{
+	memset(capture, 0, sizeof(vrCaptureInfo));
+	capture->active = 0;
+	capture->export_active = 0;
+	capture->buffers = 0;
+	capture->status = 0;
+	capture->export_fd = -1;
+}
+
+
+/*****************************************************************/
+/* _CaptureArgName(): copy the name given to an argument */
+static void _CaptureArgName(char *dst, int size, char *str)
+{
+	int	length;
+
+	str += strspn(str, " \t");
+	length = strcspn(str, ",; \t");
+	if (length >= size)
+		length = size - 1;
+	strncpy(dst, str, length);
+	dst[length] = '\0';
+}
+
+
+/*****************************************************************/
+void vrCaptureParseArgs(vrWindowInfo *window, char *args)
+{
+	char	*str = NULL;
+
+	/*******************************************************/
+	/** Argument format: "capture=" <file> [(";" | ",")]  **/
+	/*******************************************************/
+	/* starts capturing the window from its first frame */
+	if (str = strstr(args, "capture=")) {
+		_CaptureArgName(window->capture_file, sizeof(window->capture_file), strchr(str, '=') + 1);
+		window->capture_request = 1;
+	}
+
+	/*******************************************************/
+	/** Argument format: "export=" <name> [(";" | ",")]   **/
+	/*******************************************************/
+	/* exports the frames of the window to the named shared memory */
+	/*   from its first frame (a name of "1" for the default name) */
+	if (str = strstr(args, "export=")) {
+		_CaptureArgName(window->export_name, sizeof(window->export_name), strchr(str, '=') + 1);
+		if (!strcmp(window->export_name, "1"))
+			window->export_name[0] = '\0';
+		window->export_request = 1;
+	}
+}
+
+
+/*****************************************************************/
+void vrCaptureFprint(FILE *file, vrCaptureInfo *capture)
+{
+	vrFprintf(file, "\r\tcapture = { active = %d; file = '%s' (%dx%d); read = %ld; written = %ld; dropped = %ld }\n",
+		capture->active,
+		capture->file,
+		capture->width,
+		capture->height,
+		capture->frames_read,
+		capture->frames_written,
+		capture->frames_dropped);
+	vrFprintf(file, "\r\texport = { active = %d; name = '%s'; frames = %llu }\n",
+		capture->export_active,
+		capture->export_name,
+		(unsigned long long)capture->export_seq);
+}
+
+
+/****************************************************************************/
+/* vrCaptureFrame(): called by the Swap function of the graphics type, with */
+/*   the window's context current, just before the buffers are swapped.     */
+/*   This starts or stops the outputs as requested, copies out the oldest   */
+/*   buffered frame, and starts the read of the new one.  The time spent    */
+/*   (and any frames dropped) are added to the process' stats values.       */
+/* NOTE: the "getproc" function fetches a GL function of the graphics type */
+/*   (ie. glXGetProcAddressARB() or eglGetProcAddress()).                   */
+void vrCaptureFrame(vrCaptureInfo *capture, vrWindowInfo *window, void *(*getproc)(const char *))
+{
+	vrTime		start_wtime;
+	long		dropped;
+	GLint		read_buffer;
+	GLboolean	double_buffer;
+	int		slot;
+
+	if (!capture->buffers && !window->capture_request && !window->export_request)
+		return;
+
+	start_wtime = vrCurrentWallTime();
+	dropped = capture->frames_dropped;
+
+	/* a new size means new buffers -- the file capture ends, the export restarts next frame */
+	if (capture->buffers && (window->geometry.width != capture->width || window->geometry.height != capture->height)) {
+		if (capture->active) {
+			vrErrPrintf("vrCaptureFrame(): " RED_TEXT "window '%s' changed size -- stopping the capture.\n" NORM_TEXT, window->name);
+			window->capture_request = 0;
+		}
+		vrCaptureStop(capture);
+		return;
+	}
+
+	/* follow the requests */
+	if (window->capture_request && !capture->active)
+		_CaptureFileStart(capture, window, getproc);
+	else if (!window->capture_request && capture->active)
+		_CaptureFileStop(capture);
+	if (window->export_request && !capture->export_active)
+		_ExportStart(capture, window, getproc);
+	else if (!window->export_request && capture->export_active)
+		_ExportStop(capture);
+
+	if (!capture->active && !capture->export_active) {
+		_CaptureBuffersStop(capture);
+		return;
+	}
+
+	/* the oldest buffer was read VR_CAPTURE_PBOS-1 frames ago, so it's done */
+	slot = capture->pbo_next;
+	if (capture->pbo_pending[slot])
+		_CaptureCopy(capture, slot);
+
+	/* start the read of this frame -- into the buffer, so it doesn't wait */
+	glGetIntegerv(GL_READ_BUFFER, &read_buffer);
+	glGetBooleanv(GL_DOUBLEBUFFER, &double_buffer);
+	glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_PACK_SKIP_ROWS, 0);
+	glPixelStorei(GL_PACK_SKIP_PIXELS, 0);
+	glReadBuffer(double_buffer ? GL_BACK : GL_FRONT);	/* (in stereo, the left eye) */
+
+	glBindBuffer_func(GL_PIXEL_PACK_BUFFER, capture->pbo[slot]);
+	glReadPixels(0, 0, capture->width, capture->height, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid *)0);
+	glBindBuffer_func(GL_PIXEL_PACK_BUFFER, 0);
+
+	glReadBuffer(read_buffer);
+	glPopClientAttrib();
+
+	capture->pbo_pending[slot] = 1;
+	capture->pbo_frame[slot] = window->proc->frame_count;
+	capture->pbo_wtime[slot] = start_wtime;
+	capture->pbo_next = (slot + 1) % VR_CAPTURE_PBOS;
+	capture->frames_read++;
+
+	/* measure: the time (and frames) the capture cost this frame */
+	vrWindowStatsValue(window, VR_VALUE_CAPTURETIME, (vrCurrentWallTime() - start_wtime) * 1000.0);
+	vrWindowStatsValue(window, VR_VALUE_CAPTUREDROPPED, capture->frames_dropped - dropped);
+}
+
+
+/****************************************************************************/
+/* vrCaptureStop(): end both outputs, and free the buffers (so must be     */
+/*   called with the window's context current).  The requests are left as  */
+/*   they are -- eg. an export continues at the next frame.                 */
+void vrCaptureStop(vrCaptureInfo *capture)
+{
+	_CaptureFileStop(capture);
+	_ExportStop(capture);
+	_CaptureBuffersStop(capture);
+}
@@ -0,0 +1,114 @@
+/* ======================================================================
+ *
+ * HH   HH         vr_visren.capture.h
+ * HH   HH         Author(s): agent
+ * HHHHHHH         Created: October 19, 2026
+ * HH   HH         Last Modified: October 19, 2026
+ * HH   HH
+ *
+ * Header file for the frame capture (recording) and shared-memory export
+ *   of windows shared by the OpenGL visual rendering types (GLX and EGL).
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#ifndef __VRVISREN_CAPTURE_H__
+#define __VRVISREN_CAPTURE_H__
+
+#include <stdio.h>
+#include <pthread.h>
+#include <GL/gl.h>
+
+#include "vr_fbexport.h"
+
+#if !defined(TEST_APP) /* { */
+#include "vr_visren.h"
+#endif /* } !TEST_APP */
+
+
+#define	VR_CAPTURE_PBOS		3	/* pixel-pack buffers in the ring -- ie. frames between a read and its copy */
+#define	VR_CAPTURE_QUEUE	8	/* frames the writer thread may fall behind before new frames are dropped */
+
+
+/* the file formats a capture can be written in -- chosen by the extension */
+typedef enum {
+		VR_CAPTURE_RAW,		/* (any other extension) bare 24-bit RGB frames, top row first */
+		VR_CAPTURE_Y4M,		/* ".y4m" a YUV4MPEG2 (4:2:0) stream */
+		VR_CAPTURE_PNG		/* ".png" one (uncompressed) PNG file per frame */
+	} vrCaptureFormat;
+
+
+/*******************************************************************/
+/* The frame capture data of one window.  Once per frame (at the   */
+/*   swap), the finished frame is read into the next pixel-pack    */
+/*   buffer of a ring, without waiting for it.  The buffer read    */
+/*   VR_CAPTURE_PBOS-1 frames earlier is then done, and is copied  */
+/*   out to each of the active outputs:                            */
+/*     - the file capture: into a queue for the writer thread,     */
+/*       which converts and writes the frames to the file.  When   */
+/*       the queue is full (ie. the disk can't keep up), the       */
+/*       newest frame is dropped, rather than holding up the       */
+/*       rendering.                                                */
+/*     - the export: into the next slot of a shared-memory ring    */
+/*       (see vr_fbexport.h), from where other programs use it.    */
+/* The outputs are started and stopped by the window's (shared)    */
+/*   "capture_request" & "export_request" fields -- eg. from the   */
+/*   telnet "capture" and "export" commands -- the rest is only    */
+/*   used by the process rendering it.                             */
+typedef struct {
+		int		active;		/* flag set while capturing to a file */
+		int		status;		/* 1 when the buffer functions are loaded, -1 if they aren't available */
+		vrCaptureFormat	format;		/* the format of the file being written */
+		char		file[256];	/* the file (or for PNG, the base of the files) being written */
+		int		width;		/* the size of the frames in the buffers */
+		int		height;
+		int		fps;		/* the frame rate put in the Y4M header */
+
+		int		buffers;	/* flag set while the ring of buffers exists (for either output) */
+		GLuint		pbo[VR_CAPTURE_PBOS];/* the ring of pixel-pack buffers */
+		int		pbo_pending[VR_CAPTURE_PBOS];/* flags for the buffers holding a frame not yet copied */
+		long		pbo_frame[VR_CAPTURE_PBOS];/* the process frame read into each buffer */
+		vrTime		pbo_wtime[VR_CAPTURE_PBOS];/* the wall time each buffer was read */
+		int		pbo_next;	/* the next buffer to read into -- which also holds the oldest frame */
+
+		long		frames_read;	/* frames read from the window */
+		long		frames_queued;	/* frames handed to the writer thread */
+		long		frames_written;	/* frames written to the file */
+		long		frames_dropped;	/* frames lost to a full queue */
+
+		pthread_t	writer_tid;	/* the thread that writes the frames */
+		pthread_mutex_t	lock;		/* guards the queue and the quit flag */
+		pthread_cond_t	cond;		/* signals a new frame (or the quit flag) to the writer */
+		unsigned char	*queue[VR_CAPTURE_QUEUE];/* the frames waiting to be written (RGBA, bottom row first) */
+		long		queue_head;	/* count of frames put in the queue */
+		long		queue_tail;	/* count of frames taken from the queue */
+		int		quit;		/* flag telling the writer to finish the queue and end */
+		FILE		*fp;		/* the open file (RAW & Y4M) */
+
+		int		export_active;	/* flag set while exporting to shared memory */
+		char		export_name[256];/* the name of the shared-memory object */
+		int		export_fd;	/* the open shared-memory object */
+		size_t		export_size;	/* the size of the object (header and frames) */
+		vrFBExportHeader *export_header;/* the object, as mapped in this process */
+		uint64_t	export_seq;	/* the sequence number of the last frame exported */
+	} vrCaptureInfo;
+
+
+/*****************************/
+/*** Function declarations ***/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void	vrCaptureInit(vrCaptureInfo *capture);
+void	vrCaptureParseArgs(vrWindowInfo *window, char *args);
+void	vrCaptureFprint(FILE *file, vrCaptureInfo *capture);
+void	vrCaptureFrame(vrCaptureInfo *capture, vrWindowInfo *window, void *(*getproc)(const char *));
+void	vrCaptureStop(vrCaptureInfo *capture);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,388 @@
+/* ======================================================================
+ *
+ *  CCCCC          vr_visren.dynres.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for the dynamic resolution scaling shared by the OpenGL
+ *   visual rendering types (GLX and EGL).
+ *
+ * When a window is given the "dynamicResolution" argument, the world of
+ *   each eye is rendered into an offscreen framebuffer object, at a
+ *   fraction of the size of the eye's viewport, and is then upscaled
+ *   (with glBlitFramebuffer()) into the viewport.  The fraction is set
+ *   once per frame from the measured time between the frames of the
+ *   window's process, and the window's frame budget, so a heavy scene
+ *   is rendered at a lower resolution rather than at half the frame
+ *   rate.  The simulator and information displays (fps, stats, etc.)
+ *   are rendered directly into the window at its full resolution.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "vr_visren.dynres.h"
+#include "vr_debug.h"
+
+
+/****************************************************************************/
+/* The framebuffer object functions (OpenGL 3.0, or GL_ARB_framebuffer_object) */
+/*   are fetched at run-time, since the GL library to which we link need not  */
+/*   have them.  The addresses are the same for every context, so they are   */
+/*   only fetched once per process.                                           */
+static	PFNGLGENFRAMEBUFFERSPROC		glGenFramebuffers_func = NULL;
+static	PFNGLBINDFRAMEBUFFERPROC		glBindFramebuffer_func = NULL;
+static	PFNGLFRAMEBUFFERRENDERBUFFERPROC	glFramebufferRenderbuffer_func = NULL;
+static	PFNGLCHECKFRAMEBUFFERSTATUSPROC		glCheckFramebufferStatus_func = NULL;
+static	PFNGLGENRENDERBUFFERSPROC		glGenRenderbuffers_func = NULL;
+static	PFNGLBINDRENDERBUFFERPROC		glBindRenderbuffer_func = NULL;
+static	PFNGLRENDERBUFFERSTORAGEPROC		glRenderbufferStorage_func = NULL;
+static	PFNGLBLITFRAMEBUFFERPROC		glBlitFramebuffer_func = NULL;
+
+
+/****************************************************************************/
+/* _DynresLoadFuncs(): returns 1 if the framebuffer object functions are     */
+/*   available to the current context, after fetching them if not already   */
+/*   fetched.                                                                */
+static int _DynresLoadFuncs(void *(*getproc)(const char *))
+{
+	const char	*version = (const char *)glGetString(GL_VERSION);
+	const char	*extensions = (const char *)glGetString(GL_EXTENSIONS);
+	int		major = 0;
+
+	if (version != NULL)
+		sscanf(version, "%d", &major);
+	if (major < 3 && (extensions == NULL || strstr(extensions, "GL_ARB_framebuffer_object") == NULL))
+		return 0;
+
+	if (glBlitFramebuffer_func == NULL) {
+		glGenFramebuffers_func = (PFNGLGENFRAMEBUFFERSPROC)getproc("glGenFramebuffers");
+		glBindFramebuffer_func = (PFNGLBINDFRAMEBUFFERPROC)getproc("glBindFramebuffer");
+		glFramebufferRenderbuffer_func = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)getproc("glFramebufferRenderbuffer");
+		glCheckFramebufferStatus_func = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)getproc("glCheckFramebufferStatus");
+		glGenRenderbuffers_func = (PFNGLGENRENDERBUFFERSPROC)getproc("glGenRenderbuffers");
+		glBindRenderbuffer_func = (PFNGLBINDRENDERBUFFERPROC)getproc("glBindRenderbuffer");
+		glRenderbufferStorage_func = (PFNGLRENDERBUFFERSTORAGEPROC)getproc("glRenderbufferStorage");
+		glBlitFramebuffer_func = (PFNGLBLITFRAMEBUFFERPROC)getproc("glBlitFramebuffer");
+	}
+
+	return (glGenFramebuffers_func != NULL && glBindFramebuffer_func != NULL
+		&& glFramebufferRenderbuffer_func != NULL && glCheckFramebufferStatus_func != NULL
+		&& glGenRenderbuffers_func != NULL && glBindRenderbuffer_func != NULL
+		&& glRenderbufferStorage_func != NULL && glBlitFramebuffer_func != NULL);
+}
+
+
+/****************************************************************************/
+/* _DynresAllocate(): (re)size the renderbuffers of the framebuffer to fit   */
+/*   the window at the highest scale.  Returns 0 if the framebuffer can't be */
+/*   used.                                                                   */
+static int _DynresAllocate(vrDynresInfo *dynres, int width, int height)
+{
+	GLenum	status;
+
+	if (dynres->fbo == 0) {
+		glGenFramebuffers_func(1, &(dynres->fbo));
+		glGenRenderbuffers_func(1, &(dynres->color_rb));
+		glGenRenderbuffers_func(1, &(dynres->depth_rb));
+	}
+
+	glBindRenderbuffer_func(GL_RENDERBUFFER, dynres->color_rb);
+	glRenderbufferStorage_func(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glBindRenderbuffer_func(GL_RENDERBUFFER, dynres->depth_rb);
+	glRenderbufferStorage_func(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer_func(GL_RENDERBUFFER, 0);
+
+	glBindFramebuffer_func(GL_FRAMEBUFFER, dynres->fbo);
+	glFramebufferRenderbuffer_func(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, dynres->color_rb);
+	glFramebufferRenderbuffer_func(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, dynres->depth_rb);
+	status = glCheckFramebufferStatus_func(GL_FRAMEBUFFER);
+	glBindFramebuffer_func(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE) {
+		vrErrPrintf("_DynresAllocate(): " RED_TEXT "the offscreen framebuffer is incomplete (0x%x) -- rendering at full resolution.\n" NORM_TEXT, status);
+		return 0;
+	}
+
+	dynres->fbo_width = width;
+	dynres->fbo_height = height;
+	vrDbgPrintfN(SELDOM_DBGLVL, "_DynresAllocate(): offscreen framebuffer is now %dx%d\n", width, height);
+
+	return 1;
+}
+
+
+/****************************************************************************/
+/* _DynresAdjust(): set the scale of this frame.  The time of the last frame */
+/*   (which includes the time the GPU took, by way of the swap) is smoothed, */
+/*   and compared to the window's budget:                                   */
+/*     - over the budget: drop the scale by the square root of the ratio    */
+/*       (since the cost goes with the area), and hold it there a while.    */
+/*     - well under the budget: raise the scale the same way.               */
+/*     - close to the budget (eg. held to the vsync): raise the scale       */
+/*       slowly while the CPU has room to spare, but not back up to a scale */
+/*       that recently went over the budget.                                */
+static void _DynresAdjust(vrDynresInfo *dynres, vrRenderInfo *renderinfo)
+{
+	vrTime	budget = renderinfo->frame_budget;
+	float	fps1 = renderinfo->window->proc->fps1;
+	vrTime	last;
+	double	ratio;
+
+	if (budget <= 0.0) {
+		/* without a budget, there's nothing to scale to */
+		dynres->scale = dynres->max_scale;
+		return;
+	}
+	if (!(fps1 > 0.0) || isinf(fps1))
+		return;
+
+	last = 1.0 / fps1;
+	if (dynres->interval == 0.0)
+		dynres->interval = last;
+	else	dynres->interval += (last - dynres->interval) * 0.25;
+
+	if (dynres->hold > 0)
+		dynres->hold--;
+
+	if (dynres->interval > budget * 1.05) {
+		/* only drop again once the last drop has had a chance to show */
+		if (dynres->hold > VR_DYNRES_HOLDFRAMES - 4)
+			return;
+		ratio = sqrt(budget * 0.9 / dynres->interval);
+		if (ratio < 0.8)
+			ratio = 0.8;
+		dynres->ceiling = dynres->scale * 0.95;
+		dynres->scale *= ratio;
+		dynres->hold = VR_DYNRES_HOLDFRAMES;
+	} else if (dynres->hold > 0) {
+		return;
+	} else if (dynres->interval < budget * 0.8) {
+		ratio = sqrt(budget * 0.9 / dynres->interval);
+		if (ratio > 1.1)
+			ratio = 1.1;
+		dynres->scale *= ratio;
+	} else if (renderinfo->frame_headroom > budget * 0.25 && dynres->scale < dynres->ceiling) {
+		dynres->scale *= 1.002;
+		if (dynres->scale > dynres->ceiling)
+			dynres->scale = dynres->ceiling;
+	}
+
+	/* the ceiling creeps back up while the frames stay within the budget */
+	if (dynres->ceiling < dynres->max_scale)
+		dynres->ceiling *= 1.001;
+
+	if (dynres->scale < dynres->min_scale)
+		dynres->scale = dynres->min_scale;
+	if (dynres->scale > dynres->max_scale)
+		dynres->scale = dynres->max_scale;
+}
+
+
+/****************************************************************************/
+/* _DynresScaleRect(): scale a rectangle of the window into the offscreen   */
+/*   framebuffer (rounding the edges, so neighboring viewports still meet). */
+static void _DynresScaleRect(GLint *dst, GLint *src, float scale)
+{
+	dst[0] = (GLint)(src[0] * scale + 0.5);
+	dst[1] = (GLint)(src[1] * scale + 0.5);
+	dst[2] = (GLint)((src[0] + src[2]) * scale + 0.5) - dst[0];
+	dst[3] = (GLint)((src[1] + src[3]) * scale + 0.5) - dst[1];
+	if (dst[2] < 1)
+		dst[2] = 1;
+	if (dst[3] < 1)
+		dst[3] = 1;
+}
+
+
+/*****************************************************************/
+/* vrDynresInit(): set the defaults -- dynamic resolution is off. */
+void vrDynresInit(vrDynresInfo *dynres)
+{
+	memset(dynres, 0, sizeof(vrDynresInfo));
+	dynres->enabled = 0;
+	dynres->min_scale = 0.5;
+	dynres->max_scale = 1.0;
+	dynres->scale = 1.0;
+	dynres->ceiling = 1.0;
+	dynres->frame = -1;
+}
+
+
+/*****************************************************************/
+void vrDynresParseArgs(vrDynresInfo *dynres, char *args)
+{
+	char	*str = NULL;
+	float	min_scale;
+	float	max_scale;
+
+	/****************************************************************************/
+	/** Argument format: "dynamicResolution=" <min>[,<max>] [(";" | ",")]      **/
+	/****************************************************************************/
+	/* where <min> and <max> are the bounds of the scale of each axis of */
+	/*   the rendering (eg. "dynamicResolution=0.5,1.0;").  A <min> of 0  */
+	/*   (or "dynamicResolution=0") turns dynamic resolution off.        */
+	if (str = strstr(args, "dynamicResolution=")) {
+		str = strchr(str, '=') + 1;
+		min_scale = atof(str);
+		max_scale = 1.0;
+		str += strcspn(str, ",;");
+		if (*str == ',' && (str[1] == '.' || (str[1] >= '0' && str[1] <= '9')))
+			max_scale = atof(str + 1);
+
+		if (min_scale <= 0.0) {
+			dynres->enabled = 0;
+			return;
+		}
+		if (min_scale < VR_DYNRES_MINSCALE) {
+			vrErrPrintf("vrDynresParseArgs(): " RED_TEXT "dynamicResolution minimum of %.2f is too low, using %.2f.\n" NORM_TEXT,
+				min_scale, VR_DYNRES_MINSCALE);
+			min_scale = VR_DYNRES_MINSCALE;
+		}
+		if (max_scale > 2.0)
+			max_scale = 2.0;
+		if (max_scale < min_scale)
+			max_scale = min_scale;
+
+		dynres->enabled = 1;
+		dynres->min_scale = min_scale;
+		dynres->max_scale = max_scale;
+		dynres->scale = max_scale;
+		dynres->ceiling = max_scale;
+	}
+}
+
+
+/*****************************************************************/
+void vrDynresFprint(FILE *file, vrDynresInfo *dynres)
+{
+	vrFprintf(file, "\r\tdynres = { enabled = %d; scale = %.3f (%.2f - %.2f); fbo = %d (%dx%d) }\n",
+		dynres->enabled,
+		dynres->scale,
+		dynres->min_scale,
+		dynres->max_scale,
+		dynres->fbo_status,
+		dynres->fbo_width,
+		dynres->fbo_height);
+}
+
+
+/****************************************************************************/
+/* vrDynresBegin(): called by the Render function of the graphics type once */
+/*   the buffer, viewport and scissor of the eye are set.  When dynamic     */
+/*   resolution is in use, this redirects the rendering of the world into   */
+/*   the offscreen framebuffer, with the viewport (and the single-pass      */
+/*   stereo viewports) scaled down, and returns 1.                          */
+/* NOTE: the "getproc" function fetches a GL function of the graphics type */
+/*   (ie. glXGetProcAddressARB() or eglGetProcAddress()).                   */
+int vrDynresBegin(vrDynresInfo *dynres, vrRenderInfo *renderinfo, void *(*getproc)(const char *))
+{
+	vrWindowInfo	*window = renderinfo->window;
+	GLint		rect[4];
+	int		width;
+	int		height;
+	int		count;
+
+	window->res_scale = 1.0;
+	if (!dynres->enabled || window->mount == VRWINDOW_SIMULATOR)
+		return 0;
+
+	if (dynres->fbo_status == 0) {
+		if (_DynresLoadFuncs(getproc)) {
+			dynres->fbo_status = 1;
+		} else {
+			vrErrPrintf("vrDynresBegin(): " RED_TEXT "window '%s' has no framebuffer objects -- rendering at full resolution.\n" NORM_TEXT, window->name);
+			dynres->fbo_status = -1;
+		}
+	}
+	if (dynres->fbo_status < 0)
+		return 0;
+
+	/* adjust the scale once per frame (not per eye) */
+	if (renderinfo->frame_count != dynres->frame) {
+		dynres->frame = renderinfo->frame_count;
+		_DynresAdjust(dynres, renderinfo);
+	}
+
+	/* make sure the framebuffer fits the (possibly resized) window */
+	width = (int)ceil(window->geometry.width * dynres->max_scale);
+	height = (int)ceil(window->geometry.height * dynres->max_scale);
+	if (width < 1 || height < 1)
+		return 0;
+	if (width != dynres->fbo_width || height != dynres->fbo_height) {
+		if (!_DynresAllocate(dynres, width, height)) {
+			dynres->fbo_status = -1;
+			return 0;
+		}
+	}
+
+	glGetIntegerv(GL_VIEWPORT, dynres->viewport);
+	glGetIntegerv(GL_SCISSOR_BOX, dynres->scissor);
+
+	glBindFramebuffer_func(GL_FRAMEBUFFER, dynres->fbo);
+	_DynresScaleRect(rect, dynres->viewport, dynres->scale);
+	glViewport(rect[0], rect[1], rect[2], rect[3]);
+	_DynresScaleRect(rect, dynres->scissor, dynres->scale);
+	glScissor(rect[0], rect[1], rect[2], rect[3]);
+
+	/* the single-pass stereo callback sets the viewport of each eye itself */
+	if (renderinfo->stereo != NULL) {
+		for (count = VR_STEREO_LEFT; count <= VR_STEREO_RIGHT; count++) {
+			dynres->stereo_viewport[count] = renderinfo->stereo->viewport[count];
+			_DynresScaleRect(rect, (GLint *)&(renderinfo->stereo->viewport[count]), dynres->scale);
+			renderinfo->stereo->viewport[count].origX = rect[0];
+			renderinfo->stereo->viewport[count].origY = rect[1];
+			renderinfo->stereo->viewport[count].width = rect[2];
+			renderinfo->stereo->viewport[count].height = rect[3];
+		}
+	}
+
+	window->res_scale = dynres->scale;
+	dynres->active = 1;
+
+	return 1;
+}
+
+
+/****************************************************************************/
+/* vrDynresEnd(): called by the Render function of the graphics type after  */
+/*   the world is rendered.  This upscales the world from the offscreen     */
+/*   framebuffer into the eye's viewport of the window, and restores the    */
+/*   window's framebuffer, viewport and scissor for the rest of the frame.  */
+void vrDynresEnd(vrDynresInfo *dynres, vrRenderInfo *renderinfo)
+{
+	GLint		src[4];
+	int		count;
+
+	if (!dynres->active)
+		return;
+	dynres->active = 0;
+
+	/* NOTE: the draw buffer (eg. GL_BACK_LEFT) is part of the state of */
+	/*   the window's framebuffer, so it comes back with the binding.  */
+	glBindFramebuffer_func(GL_READ_FRAMEBUFFER, dynres->fbo);
+	glBindFramebuffer_func(GL_DRAW_FRAMEBUFFER, 0);
+	glViewport(dynres->viewport[0], dynres->viewport[1], dynres->viewport[2], dynres->viewport[3]);
+	glScissor(dynres->scissor[0], dynres->scissor[1], dynres->scissor[2], dynres->scissor[3]);
+
+	_DynresScaleRect(src, dynres->viewport, dynres->scale);
+	glBlitFramebuffer_func(src[0], src[1], src[0] + src[2], src[1] + src[3],
+		dynres->viewport[0], dynres->viewport[1],
+		dynres->viewport[0] + dynres->viewport[2], dynres->viewport[1] + dynres->viewport[3],
+		GL_COLOR_BUFFER_BIT, GL_LINEAR);
+	glBindFramebuffer_func(GL_FRAMEBUFFER, 0);
+
+	if (renderinfo->stereo != NULL) {
+		for (count = VR_STEREO_LEFT; count <= VR_STEREO_RIGHT; count++)
+			renderinfo->stereo->viewport[count] = dynres->stereo_viewport[count];
+	}
+}
@@ -0,0 +1,81 @@
+/* ======================================================================
+ *
+ * HH   HH         vr_visren.dynres.h
+ * HH   HH         Author(s): agent
+ * HHHHHHH         Created: October 19, 2026
+ * HH   HH         Last Modified: October 19, 2026
+ * HH   HH
+ *
+ * Header file for the dynamic resolution scaling shared by the OpenGL
+ *   visual rendering types (GLX and EGL).
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#ifndef __VRVISREN_DYNRES_H__
+#define __VRVISREN_DYNRES_H__
+
+#include <GL/gl.h>
+
+#if !defined(TEST_APP) /* { */
+#include "vr_visren.h"
+#endif /* } !TEST_APP */
+
+
+/* the limits of the "dynamicResolution=" window argument */
+#define	VR_DYNRES_MINSCALE	0.25	/* lowest allowed scale of each axis */
+#define	VR_DYNRES_HOLDFRAMES	30	/* frames to wait after a drop before raising the scale again */
+
+
+/*******************************************************************/
+/* The dynamic resolution data of one window.  When enabled, the   */
+/*   world of each eye is rendered into an offscreen framebuffer   */
+/*   at a fraction of the window's resolution, and then upscaled   */
+/*   into the eye's viewport of the window.  The fraction follows  */
+/*   the measured frame time of the window's process, such that    */
+/*   it stays within the window's frame budget.                    */
+/* This structure is part of the graphics type's private data of a */
+/*   window, so it is only used by the process rendering it.       */
+typedef struct {
+		int		enabled;	/* CONFIG-arg: flag set by the "dynamicResolution" argument */
+		float		min_scale;	/* CONFIG-arg: the lowest scale (of each axis) to render at */
+		float		max_scale;	/* CONFIG-arg: the highest scale (of each axis) to render at */
+
+		float		scale;		/* the scale at which the current frame is rendered */
+		vrTime		interval;	/* smoothed time between the frames of the process */
+		int		hold;		/* frames to go before the scale may be raised */
+		float		ceiling;	/* the highest scale to slowly raise to (below the last that went over) */
+		long		frame;		/* the frame for which the scale was last adjusted */
+
+		int		fbo_status;	/* 1 when the framebuffer is ready, -1 if it can't be made */
+		GLuint		fbo;		/* the offscreen framebuffer object */
+		GLuint		color_rb;	/* its color renderbuffer */
+		GLuint		depth_rb;	/* its depth (and stencil) renderbuffer */
+		int		fbo_width;	/* the size of the renderbuffers */
+		int		fbo_height;
+
+		int		active;		/* flag set between vrDynresBegin() and vrDynresEnd() */
+		GLint		viewport[4];	/* the eye's (full-size) viewport in the window */
+		GLint		scissor[4];	/* the eye's (full-size) scissor box in the window */
+		vrViewport	stereo_viewport[2];/* the (full-size) single-pass stereo viewports */
+	} vrDynresInfo;
+
+
+/*****************************/
+/*** Function declarations ***/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void	vrDynresInit(vrDynresInfo *dynres);
+void	vrDynresParseArgs(vrDynresInfo *dynres, char *args);
+void	vrDynresFprint(FILE *file, vrDynresInfo *dynres);
+int	vrDynresBegin(vrDynresInfo *dynres, vrRenderInfo *renderinfo, void *(*getproc)(const char *));
+void	vrDynresEnd(vrDynresInfo *dynres, vrRenderInfo *renderinfo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1315 @@
+/* ======================================================================
+ *
+ *  CCCCC          vr_visren.egl.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026 (based on vr_visren.glx.c)
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for FreeVR visual rendering into a headless (offscreen)
+ *   EGL pbuffer.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * Based on vr_visren.glx.c, Copyright 2014, Bill Sherman, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+/*************************************************************************
+
+ABOUT:
+	The EGL rendering interface renders the same OpenGL as the GLX
+	interface, but into offscreen pbuffers, so no X server (and with
+	a software OpenGL, no GPU) is needed.  Nothing is ever seen, but
+	the frame loop runs at full speed, which allows FreeVR and its
+	applications to be profiled and tested on build servers.
+
+	Windows can use it directly (GraphicsType "egl"), or by setting
+	the FREEVR_HEADLESS environment variable, all "glx" windows of a
+	configuration are rendered with EGL instead (and their graphicsType
+	becomes "egl") -- so the windows of a freevrrc (eg. of a 4-wall
+	CAVE) can be run headless without changes, though not its X11
+	inputs (see below).
+
+	A pbuffer has no stereo buffers, so the left and right eyes of
+	"dualfb" windows are both rendered into the one buffer.  Text is
+	not rendered, as there are no X fonts.
+
+	Input devices that read the X events of a rendering window (ie.
+	"xwindows", such as the "simulator-indev" of the default
+	configuration) have no window to read from.  They skip the EGL
+	windows with a message, and with no X window left, they don't
+	operate -- so headless configurations need other inputs (eg.
+	"static", "shmem" or "replay") for anything to move.
+
+
+FreeVR USAGE:
+	Here are the FreeVR configuration options for the EGL visual rendering window:
+		"geometry=[WxH][+X+Y]" -- set the size of the pbuffer (the position
+			is ignored, so the "glx" geometry can be used as is)
+		"device={surfaceless|default}" -- the EGL display to render with
+			(default is "surfaceless" when available -- Mesa's platform
+			that needs no window system)
+		"finish={0|1}" -- wait for the GPU at each swap, as a GLX
+			double buffer would (default is 1)
+		"dynamicResolution=<min>[,<max>]" -- render the world at a scale
+			that follows the frame time, as with the "glx" windows
+
+	Any other GLX options (eg. "display=", "title=") are ignored.
+
+TODO:
+	- option to read back the pbuffer to a file for regression testing
+
+	- render text with something other than X fonts
+
+**************************************************************************/
+#include <string.h>
+#include <math.h>			/* needed for HUGE_VAL (aka __infinity) definition */
+
+#include "vr_visren.h"
+#include "vr_visren.egl.h"
+#include "vr_basicgfx.glx.h"		/* needed for vrGLRenderDefaultSimulator() & vrGLRenderStatsChart() */
+#include "vr_callback.h"		/* also included within vr_input.h, but left for clarity */
+#include "vr_input.h"
+#include "vr_debug.h"
+#include "vr_utils.h"			/* for declarations of vrStringCharWidth() & vrStringCharHeight() */
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#  define EGL_PLATFORM_SURFACELESS_MESA	0x31DD
+#endif
+
+#if 0 /* set to 1 to prevent local vrTrace messages */
+#  ifdef vrTrace
+#    undef	vrTrace
+#    define	vrTrace(a,b) ;
+#  endif
+#endif
+
+
+/****************************************************************************/
+void vrFprintEglPrivateInfo(FILE *file, vrEglPrivateInfo *aux, vrPrintStyle style)
+{
+	/* if null pointer given, print an empty shell and return */
+	if (aux == NULL) {
+		vrFprintf(file, "eglinfo \"(nil)\" = { }\n");
+		return;
+	}
+
+	switch (style) {
+	case one_line:
+		vrFprintf(file, "EglInfo = { device = \"%s\" size = %dx%d Display = %#p Surface = %#p }\n",
+			aux->device,
+			aux->width,
+			aux->height,
+			aux->egl_display,
+			aux->egl_surface);
+		break;
+
+	default:
+	case verbose:
+		vrFprintf(file, "EglInfo (%#p) = {\n", aux);
+		vrFprintf(file, "\r"
+			"\tdevice = \"%s\"\n\tsize = %dx%d\n"
+			"\tDisplay = %#p\n\tSurface = %#p\n\tContext = %#p\n\n"
+			"\tmapped = %d\n\tfinish = %d\n",
+			aux->device,
+			aux->width,
+			aux->height,
+			aux->egl_display,
+			aux->egl_surface,
+			aux->egl_context,
+			aux->mapped,
+			aux->finish);
+		vrDynresFprint(file, &(aux->dynres));
+		vrCaptureFprint(file, &(aux->capture));
+		vrGpuTimerFprint(file, &(aux->gputimer));
+		vrFprintf(file, "\r}\n");
+		break;
+	}
+}
+
+
+/****************************************************************************/
+static char *_EglGLErrorCodeString(GLenum code)
+{
+	switch (code) {
+	case GL_NO_ERROR:		return "no error";
+	case GL_INVALID_ENUM:		return "invalid enum";
+	case GL_INVALID_VALUE:		return "invalid value";
+	case GL_INVALID_OPERATION:	return "invalid operation";
+	case GL_STACK_OVERFLOW:		return "stack overflow";
+	case GL_STACK_UNDERFLOW:	return "stack underflow";
+	case GL_OUT_OF_MEMORY:		return "out of memory";
+	}
+
+	return "unknown error code";
+}
+
+
+/*****************************************************************/
+static void _EglParseArgs(vrEglPrivateInfo *aux, char *args)
+{
+	char	*str = NULL;
+
+	/*****************************************************************/
+	/** Argument format: "geometry=" [WxH][+X+Y] [(";" | ",")] **/
+	/*****************************************************************/
+	/* NOTE: only the size matters for a pbuffer, the position is */
+	/*   allowed so that the arguments of a GLX window work as is. */
+	if (str = strstr(args, "geometry=")) {
+		int	width, height;
+
+		if (sscanf(strchr(str, '=') + 1, "%dx%d", &width, &height) == 2) {
+			aux->width = width;
+			aux->height = height;
+		}
+	}
+
+	/*****************************************************************/
+	/** Argument format: "device=" {surfaceless|default} [(";" | ",")] **/
+	/*****************************************************************/
+	if (str = strstr(args, "device=")) {
+		char	*device_str = strchr(str, '=') + 1;
+
+		if (!strncasecmp(device_str, "default", 7))
+			aux->device = vrShmemStrDup("default");
+		else if (!strncasecmp(device_str, "surfaceless", 11))
+			aux->device = vrShmemStrDup("surfaceless");
+		else	vrErrPrintf("_EglParseArgs(): " RED_TEXT "unknown EGL device in '%s'.\n" NORM_TEXT, str);
+	}
+
+	/************************************************/
+	/** Argument format: "finish=" {0|1} [(";" | ",")] **/
+	/************************************************/
+	if (str = strstr(args, "finish=")) {
+		aux->finish = atoi(strchr(str, '=') + 1);
+	}
+
+	/*****************************************************************************/
+	/** Argument format: "dynamicResolution=" <min>[,<max>] [(";" | ",")]        **/
+	/*****************************************************************************/
+	vrDynresParseArgs(&(aux->dynres), args);
+
+	vrDbgPrintf("================================================\n");
+	vrDbgPrintf("done parsing argument string `%s'\n", args);
+	vrDbgPrintf("aux->device = '%s'\n", aux->device);
+	vrDbgPrintf("aux->size = %dx%d\n", aux->width, aux->height);
+	vrDbgPrintf("aux->finish = %d\n", aux->finish);
+	vrDbgPrintf("aux->dynres = %d (%.2f - %.2f)\n", aux->dynres.enabled, aux->dynres.min_scale, aux->dynres.max_scale);
+	vrDbgPrintf("================================================\n");
+}
+
+
+/****************************************************************************/
+/* _EglGetProcAddress(): fetch a GL function for the dynres, capture, gputimer & shapes code */
+static void *_EglGetProcAddress(const char *name)
+{
+	return (void *)eglGetProcAddress(name);
+}
+
+
+/*****************************************************************/
+/* _EglGetDisplay(): get the EGL display of the requested device,  */
+/*   falling back to the default display.                          */
+static EGLDisplay _EglGetDisplay(vrEglPrivateInfo *aux)
+{
+	PFNEGLGETPLATFORMDISPLAYEXTPROC	get_platform_display;
+	const char			*extensions;
+	EGLDisplay			display;
+
+	if (!strcmp(aux->device, "surfaceless")) {
+		/* NOTE: client extensions are queried with no display */
+		extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+		get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+		if (extensions != NULL && strstr(extensions, "EGL_MESA_platform_surfaceless") && get_platform_display != NULL) {
+			display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+			if (display != EGL_NO_DISPLAY)
+				return display;
+		}
+		vrDbgPrintfN(EGL_DBGLVL, "_EglGetDisplay(): no surfaceless platform -- using the default EGL display.\n");
+		aux->device = vrShmemStrDup("default");
+	}
+
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+
+/* The opening and initialization function -- this line is to help diff match */
+/**************************************************************************/
+/* _EglOpenFunc() initializes the auxiliary window info for the specified */
+/* window.                                                                */
+/**************************************************************************/
+static void _EglOpenFunc(vrWindowInfo *window)
+{
+static	char		trace_msg[256];
+	vrEglPrivateInfo *aux = NULL;
+	EGLint		config_attribs[] = {
+				EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+				EGL_RED_SIZE, 1,
+				EGL_GREEN_SIZE, 1,
+				EGL_BLUE_SIZE, 1,
+				EGL_DEPTH_SIZE, 1,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_NONE
+			};
+	EGLint		pbuffer_attribs[] = {
+				EGL_WIDTH, 0,		/* filled in below */
+				EGL_HEIGHT, 0,
+				EGL_NONE
+			};
+	EGLint		num_configs;
+	EGLint		major, minor;
+
+	sprintf(trace_msg, BOLD_TEXT "Entering for window '%s' %#p\n" NORM_TEXT, window->name, window);
+	vrTrace("_EglOpenFunc", trace_msg);
+
+
+	/****************************************/
+	/*** initialize memory for the window ***/
+	/****************************************/
+
+	window->aux_data = (void *)vrShmemAlloc0(sizeof(vrEglPrivateInfo));
+	aux = (vrEglPrivateInfo *)window->aux_data;
+
+
+	/*************************************/
+	/*** set/get the window parameters ***/
+	/*************************************/
+
+	/* set some default values */
+	aux->device = vrShmemStrDup("surfaceless");
+	aux->width = 200;			/* the same default as the GLX windows */
+	aux->height = 200;
+	aux->finish = 1;
+	vrDynresInit(&(aux->dynres));		/* render at the window's full resolution */
+	vrCaptureInit(&(aux->capture));		/* not capturing */
+	vrGpuTimerInit(&(aux->gputimer));	/* not measuring the GPU */
+
+	/* parse the arguments to override defaults */
+	_EglParseArgs(aux, window->args);
+	vrCaptureParseArgs(window, window->args);	/* "capture=" is kept in the window */
+	vrGpuTimerParseArgs(window, window->args);	/* so is "gpuTimer=" */
+	vrTrace("_EglOpenFunc", "Arguments parsed");
+
+	if (aux->width <= 0)
+		aux->width = 100;
+	if (aux->height <= 0)
+		aux->height = 100;
+
+
+	/*****************************************/
+	/*** open the EGL display (per window) ***/
+	/*****************************************/
+
+	aux->egl_display = _EglGetDisplay(aux);
+	if (aux->egl_display == EGL_NO_DISPLAY || !eglInitialize(aux->egl_display, &major, &minor)) {
+		vrErrPrintf("_EglOpenFunc(): " RED_TEXT "Could not initialize an EGL display for window '%s' (error 0x%x)\n" NORM_TEXT,
+			window->name, eglGetError());
+		return;		/* returning without mapping the window */
+	}
+	sprintf(trace_msg, "EGL %d.%d display '%s' has been initialized.", major, minor, aux->device);
+	vrTrace("_EglOpenFunc", trace_msg);
+	vrDbgPrintfN(EGL_DBGLVL, "_EglOpenFunc(): %s\n", trace_msg);
+
+	/* FreeVR renders with (compatibility profile) desktop OpenGL */
+	if (!eglBindAPI(EGL_OPENGL_API)) {
+		vrErrPrintf("_EglOpenFunc(): " RED_TEXT "EGL display for window '%s' does not support desktop OpenGL\n" NORM_TEXT, window->name);
+		return;
+	}
+
+	/**********************************************/
+	/* get a pbuffer configuration for the window */
+	if (!eglChooseConfig(aux->egl_display, config_attribs, &aux->egl_config, 1, &num_configs) || num_configs < 1) {
+		vrErrPrintf("_EglOpenFunc(): " RED_TEXT "no pbuffer configuration for window '%s'\n" NORM_TEXT, window->name);
+		return;
+	}
+
+	/* Set "dualeye_buffer" so the rendering routine will know we don't have a quad buffer */
+	window->dualeye_buffer = 0;
+
+	/*******************************************/
+	/*** create the pbuffer and its context! ***/
+	/*******************************************/
+	pbuffer_attribs[1] = aux->width;
+	pbuffer_attribs[3] = aux->height;
+	aux->egl_surface = eglCreatePbufferSurface(aux->egl_display, aux->egl_config, pbuffer_attribs);
+	if (aux->egl_surface == EGL_NO_SURFACE) {
+		vrErrPrintf("_EglOpenFunc(): " RED_TEXT "could not create a %dx%d pbuffer for window '%s' (error 0x%x)\n" NORM_TEXT,
+			aux->width, aux->height, window->name, eglGetError());
+		return;
+	}
+
+	vrTrace("_EglOpenFunc", BOLD_TEXT "about to create a rendering context" NORM_TEXT);
+	aux->egl_context = eglCreateContext(aux->egl_display, aux->egl_config, EGL_NO_CONTEXT, NULL);
+	if (aux->egl_context == EGL_NO_CONTEXT) {
+		vrErrPrintf("_EglOpenFunc(): " RED_TEXT "could not create a rendering context for window '%s' (error 0x%x)\n" NORM_TEXT,
+			window->name, eglGetError());
+		return;
+	}
+
+	/* fill in the window-info structure with the correct viewport details */
+	window->geometry.origX = 0;
+	window->geometry.origY = 0;
+	window->geometry.width = aux->width;
+	window->geometry.height = aux->height;
+
+	/* Calculate the left viewport values */
+	if (window->viewport_left.origX == -1) {
+		/* Calculate the absolute viewport in OpenGL terms from the fractional viewports. */
+		/* NOTE: fractional viewports default to 0.0 -> 1.0 when not specified. */
+		window->viewport_left.origX =  window->geometry.width  *  (int)window->viewportF_left.min_X;
+		window->viewport_left.width =  window->geometry.width  * (int)(window->viewportF_left.max_X - window->viewportF_left.min_X);
+		window->viewport_left.origY =  window->geometry.height *  (int)window->viewportF_left.min_Y;
+		window->viewport_left.height = window->geometry.height * (int)(window->viewportF_left.max_Y - window->viewportF_left.min_Y);
+	} else {
+		/* Calculate the fractional viewport size from the given absolute viewport. */
+		window->viewportF_left.min_X =  (float)window->viewport_left.origX / window->geometry.width;
+		window->viewportF_left.max_X = ((float)window->viewport_left.width / window->geometry.width) + window->viewportF_left.min_X;
+		window->viewportF_left.min_Y =  (float)window->viewport_left.origY / window->geometry.height;
+		window->viewportF_left.max_Y = ((float)window->viewport_left.height / window->geometry.height) + window->viewportF_left.min_Y;
+	}
+
+	/* Now do the same with the right viewport */
+	if (window->viewport_right.origX == -1) {
+		window->viewport_right.origX =  window->geometry.width  *  (int)window->viewportF_right.min_X;
+		window->viewport_right.width =  window->geometry.width  * (int)(window->viewportF_right.max_X - window->viewportF_right.min_X);
+		window->viewport_right.origY =  window->geometry.height *  (int)window->viewportF_right.min_Y;
+		window->viewport_right.height = window->geometry.height * (int)(window->viewportF_right.max_Y - window->viewportF_right.min_Y);
+	} else {
+		window->viewportF_right.min_X =  (float)window->viewport_right.origX / window->geometry.width;
+		window->viewportF_right.max_X = ((float)window->viewport_right.width / window->geometry.width) + window->viewportF_right.min_X;
+		window->viewportF_right.min_Y =  (float)window->viewport_right.origY / window->geometry.height;
+		window->viewportF_right.max_Y = ((float)window->viewport_right.height / window->geometry.height) + window->viewportF_right.min_Y;
+	}
+
+	/* there is nothing to wait for -- the pbuffer is ready */
+	aux->mapped = 1;
+
+
+	/***************************************************/
+	/*** Configure this OpenGL context for rendering ***/
+	/***************************************************/
+
+	vrTrace("_EglOpenFunc", "about to make GL calls");
+
+	eglMakeCurrent(aux->egl_display, aux->egl_surface, aux->egl_surface, aux->egl_context);
+	vrShapeGLContextInit(_EglGetProcAddress);
+
+	glEnable(GL_DEPTH_TEST);
+
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	glFrustum(-1.0, 1.0, -1.0, 1.0, 1.0, 1000.0);
+	glMatrixMode(GL_MODELVIEW);
+
+	glViewport(0, 0, aux->width, aux->height);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDrawBuffer(GL_BACK);			/* a pbuffer only has a back buffer */
+	glClearColor(0.0, 0.0, 0.0, 0.0);
+	glClearDepth(1.0);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	/* For windows that use the dual-viewport method of rendering, enable the Scissor test */
+	if (window->visrenmode == VRVISREN_DUALVP) {
+		glEnable(GL_SCISSOR_TEST);
+	}
+
+	vrMsgPrintf("FreeVR: window '%s' is rendering headless into a %dx%d EGL pbuffer (%s).\n",
+		window->name, aux->width, aux->height, (char *)glGetString(GL_RENDERER));
+
+	sprintf(trace_msg, BOLD_TEXT "Exiting _EglOpenFunc() for window '%s' %#p\n" NORM_TEXT, window->name, window);
+	vrTrace("_EglOpenFunc", trace_msg);
+}
+/* end of open function -- for diff match */
+
+
+/****************************************************************************/
+static void _EglCloseFunc(vrWindowInfo *window)
+{
+	vrEglPrivateInfo	*aux = (vrEglPrivateInfo *)(window->aux_data);
+
+	/* finish writing any capture or export in progress, and */
+	/*   free the GPU timer queries                          */
+	if (aux->capture.buffers || aux->gputimer.active) {
+		eglMakeCurrent(aux->egl_display, aux->egl_surface, aux->egl_surface, aux->egl_context);
+		vrCaptureStop(&(aux->capture));
+		vrGpuTimerStop(&(aux->gputimer));
+	}
+
+	if (aux->egl_context != EGL_NO_CONTEXT) {
+		/* delete the buffers of the basic shapes in this context */
+		eglMakeCurrent(aux->egl_display, aux->egl_surface, aux->egl_surface, aux->egl_context);
+		vrShapeGLContextRelease();
+
+		eglMakeCurrent(aux->egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(aux->egl_display, aux->egl_context);
+	}
+	if (aux->egl_surface != EGL_NO_SURFACE)
+		eglDestroySurface(aux->egl_display, aux->egl_surface);
+
+	/* NOTE: the display isn't terminated, as other windows of the */
+	/*   process are given the same EGL display.                   */
+
+	/* TODO: should we also free memory of the things aux points to? */
+	vrShmemFree(aux);
+}
+
+
+/****************************************************************************/
+/* _EglSwapFunc(): there is no buffer to swap in a pbuffer, so this just    */
+/*   makes sure the frame has been rendered, as the glXWaitGL() of a GLX    */
+/*   swap would.                                                            */
+static void _EglSwapFunc(vrWindowInfo *info)
+{
+	vrEglPrivateInfo	*aux = (vrEglPrivateInfo *)(info->aux_data);
+
+	/* If this window hasn't been mapped yet, then skip the swap */
+	if (!aux->mapped)
+		return;
+
+	eglMakeCurrent(aux->egl_display, aux->egl_surface, aux->egl_surface, aux->egl_context);
+	vrGpuTimerSwapBegin(&(aux->gputimer), info, _EglGetProcAddress);
+	vrCaptureFrame(&(aux->capture), info, _EglGetProcAddress);
+	if (aux->finish)
+		glFinish();
+	else	glFlush();
+	vrGpuTimerSwapEnd(&(aux->gputimer), info);
+}
+
+
+/****************************************************************************/
+/* A function to check the rendering library error flag(s) and report any   */
+/*   error conditions.                                                      */
+static void _EglRenderErrors()
+{
+	GLenum	error_code;
+
+	while ((error_code = glGetError()) != GL_NO_ERROR) {
+		vrPrintf("_EglRenderErrors(): " RED_TEXT" a GL error of type '%s' (%d) has occurred.\n" NORM_TEXT,
+			_EglGLErrorCodeString(error_code),
+			(int)error_code);
+	}
+}
+
+
+/****************************************************************************/
+static void _EglRenderTransform(vrMatrix *mat)
+{
+	glMultMatrixd(mat->v);
+}
+
+
+/****************************************************************************/
+/* _EglSetProjectionTransform() allows the top value of the GL projection   */
+/*   stack to be set to the corresponding values in the vrPerspData         */
+/*   structure.  The pushing/popping of this data is left to the calling    */
+/*   function(s) to handle.                                                 */
+/* NOTE: this is primarily used for the feature of allowing a 2nd POV to    */
+/*   be rendered to the screen for particular elements in the virtual world.*/
+static void _EglSetProjectionTransform(vrPerspData *pd)
+{
+
+	/* 6/18/01: by putting the viewing transformation on the projection-matrix */
+	/*   stack, lighting and environment maps should work.  However, to have   */
+	/*   fog effects work the viewing transform needs to go on the ModelView   */
+	/*   stack instead.                                                        */
+
+	/* TODO: there should be be an option that allows the application to */
+	/*   choose to put the perspective matrix on the ModelView stack in  */
+	/*   case it prefers to have working fog over working lighting.      */
+
+	glMatrixMode(GL_PROJECTION);
+
+#ifdef USE_FRUSTUMEYE
+	glLoadIdentity();
+	if (pd->frustum.n.left != -HUGE_VAL) {
+		glFrustum(pd->frustum.n.left,
+			pd->frustum.n.right,
+			pd->frustum.n.bottom,
+			pd->frustum.n.top,
+			pd->frustum.n.near_clip,
+			pd->frustum.n.far_clip);
+	} else {
+		vrDbgPrintfN(EGL_DBGLVL, "_EglSetProjectionTransform(): " RED_TEXT "Invalid Frustum, viewpoint on render plane\n" NORM_TEXT);
+		glFrustum(-1.0, 1.0, -1.0, 1.0, 0.1, 10.0);	/* NOTE: this is of course, wrong, but at least puts something on the screen. */
+	}
+#else
+	if (!VRMAT_ROWCOL(&pd->mat, VR_W, VR_W) == 0.0) {
+		glLoadMatrixd(pd->mat.v);
+	} else {
+		vrDbgPrintfN(EGL_DBGLVL, "_EglSetProjectionTransform(): " RED_TEXT "Invalid Perspective Matrix, viewpoint on render plane\n" NORM_TEXT);
+		glFrustum(-1.0, 1.0, -1.0, 1.0, 0.1, 10.0);	/* NOTE: this is of course, wrong, but at least puts something on the screen. */
+	}
+#endif
+
+#ifdef USE_FRUSTUMEYE
+	/* NOTE: Stuart says the real-world to window transform should be  */
+	/*   on the ModelView stack in order to get proper lighting, etc.  */
+	/* TODO: provide an option to do the eye & rw2s transforms on the  */
+	/*   perspective stack.                                            */
+	/* TODO: test the difference in stack choice on the VRtut lighting */
+	/*   solution.                                                     */
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+	glTranslated(-pd->eye[VR_X], -pd->eye[VR_Y], -pd->eye[VR_Z]);
+	glMultMatrixd(pd->rw2w_xform.v);
+#else
+	/* BS: (TODO:) should we go into ModelView mode first and then do the transformation? */
+	glMultMatrixd(pd->rw2w_xform.v);
+	glMatrixMode(GL_MODELVIEW);
+	/* BS: (TODO:) should there be a glLoadIdentity() after going into MODELVIEW matrix mode? */
+#endif
+
+}
+
+
+/* The render function */
+/****************************************************************************/
+static void _EglRenderFunc(vrRenderInfo *renderinfo)
+{
+static	int		nocallback_msg = 0;	/* has the no rendering callback message been displayed yet? */
+static	char		trace_msg[2048];
+	char		*buffer_name;		/* name of the GL buffer selected */
+	vrPerspData	*pd = renderinfo->persp;
+	vrWindowInfo	*curr_window = renderinfo->window;
+	vrEyeInfo	*curr_eye = renderinfo->eye;
+	vrUserInfo	*curr_user = curr_eye->user;
+	vrEglPrivateInfo *aux = (vrEglPrivateInfo *)curr_window->aux_data;
+	vrCallback	*callback = NULL;
+	int		count;
+	int		twod_ortho_mode = 0;	/* set to one when rendering in 2D */
+
+	if (curr_window->name == NULL) {
+		printf("_EglRenderFunc(): something is seriously wrong -- no window name.\n");
+		return;
+	}
+	sprintf(trace_msg, "beginning window render loop for window '%s' %#p", curr_window->name, curr_window);
+	vrTrace("_EglRenderFunc", trace_msg);
+
+	if (!aux->mapped) {
+		vrTrace("_EglRenderFunc", "unmapped window -- skip rendering");
+		return;
+	}
+
+	eglMakeCurrent(aux->egl_display, aux->egl_surface, aux->egl_surface, aux->egl_context);
+
+	/* NOTE: there are no X events (nor simulator keys) for a pbuffer */
+	/********************************************/
+	/* Handle other possible simulator controls */
+	if (curr_window->mount == VRWINDOW_SIMULATOR) {
+
+		/* when the flag is set, continually jump to the user's head position */
+		if (curr_window->sim_follow_head) {
+			/* TODO: try to convert this into a vrSimulatorMove() operation */
+			vrMatrixInvert(curr_window->rw2w_xform, curr_user->head->visren_position);
+			vrMatrixPreTranslate3d(curr_window->rw2w_xform, pd->eye[VR_X], pd->eye[VR_Y], pd->eye[VR_Z] + 0.0);
+		}
+	}
+
+
+#if 1	/* don't include this if GFXINIT_TOP is not set to 2 in vr_visren.c */
+	/*****************************************************/
+	/* (0) call graphics initialization callback, if new */
+	if (curr_window->call_visreninit == 1) {
+		/* The initialization functions are only called once per window  */
+		/*   per setting of the initialization function, so this is only */
+		/*   done when a new VisrenInit callback was assigned.           */
+
+		/* TODO: consider whether a per-user initialization routine */
+		/*   is important.  This implementation does not refer to a */
+		/*   per-user init callback -- because we don't know the    */
+		/*   user until we get down to phase (3c).                  */
+vrPrintf("_EglRenderFunc(): " RED_TEXT "Calling VisrenInit callback for window '%s' -- call_visreninit was set to 1.\n" NORM_TEXT, curr_window->name);
+
+		vrTrace("_EglRenderFunc", "prep: initialization callback");
+		callback = curr_window->VisrenInit;
+		vrCallbackInvokeDynamic(callback, 1, renderinfo);
+		curr_window->call_visreninit = 0;
+		vrTrace("_EglRenderFunc", "done: initialization callback");
+	}
+#endif
+
+	/* measure: the GPU time of this eye (when the window's gpu_timer is set) */
+	vrGpuTimerEyeBegin(&(aux->gputimer));
+
+
+	/*****************************/
+	/* (i) push gfx matrix/state */
+
+	/* NOTE: attributes are not pushed to allow the application render */
+	/*   routine to set the state in one call, and be able to expect   */
+	/*   that state to be unchanging until it decides to change it.    */
+	/* Perhaps we are now giving the same courtesy to the transformation matrix. */
+
+
+	/*****************************************/
+	/* (ii) handle viewport and frame buffer */
+	vrTrace("_EglRenderFunc", "(ii) handle viewport");
+
+	/* set the buffer into which we should render (based on the eye) */
+	/*   -- except with single-pass stereo, where the world callback */
+	/*   sets the viewport of each eye itself, so the whole window   */
+	/*   is made available.                                          */
+	if (renderinfo->stereo != NULL) {
+		glDrawBuffer(GL_BACK);
+		buffer_name = "GL_BACK";
+		glViewport(0, 0, curr_window->geometry.width, curr_window->geometry.height);
+		glScissor(0, 0, curr_window->geometry.width, curr_window->geometry.height);
+	} else switch (curr_eye->render_framebuffer) {
+	default:
+		/* Really, we shouldn't need to rely on the default, so print a warning message and continue. */
+		vrMsgPrintf("By default rendering to the Back buffer\n");
+	case VRFB_FULL:
+		glDrawBuffer(GL_BACK);
+		buffer_name = "GL_BACK";
+		break;
+	case VRFB_LEFT:
+	case VRFB_RIGHT:
+		/* A pbuffer has no stereo buffers, but both eyes are still  */
+		/*   rendered (each over the other), so that the load on the */
+		/*   GPU is the same as that of a quad-buffered display.     */
+		glDrawBuffer(GL_BACK);
+		buffer_name = "GL_BACK";
+		break;
+
+	/* NOTE: [5/5/02] We may want a special dualvp rendering mode      */
+	/*   that is independent of specifically rendering a left or right */
+	/*   eye view.                                                     */
+	/* NOTE: [6/11/02: hmmm, now trying to use this as the only option, */
+	/*   and for systems with just one eye to a window, the viewport    */
+	/*   will take care of things.                                      */
+	case VRFB_FULL_LEFTEYE:	  /* NOTE: this will just have a viewport encompassing the entire window */
+	case VRFB_SPLIT_LEFTEYE:
+		glDrawBuffer(GL_BACK);
+		buffer_name = "GL_BACK";
+		glViewport(curr_window->viewport_left.origX, curr_window->viewport_left.origY,
+			curr_window->viewport_left.width, curr_window->viewport_left.height);
+		glScissor(curr_window->viewport_left.origX, curr_window->viewport_left.origY,
+			curr_window->viewport_left.width, curr_window->viewport_left.height);
+		break;
+	case VRFB_FULL_RIGHTEYE:  /* NOTE: this will just have a viewport encompassing the entire window */
+	case VRFB_SPLIT_RIGHTEYE:
+		glDrawBuffer(GL_BACK);
+		buffer_name = "GL_BACK";
+		glViewport(curr_window->viewport_right.origX, curr_window->viewport_right.origY,
+			curr_window->viewport_right.width, curr_window->viewport_right.height);
+		glScissor(curr_window->viewport_right.origX, curr_window->viewport_right.origY,
+			curr_window->viewport_right.width, curr_window->viewport_right.height);
+		break;
+	}
+#if 1	/* I don't like removing the error from the OpenGL state at this point, but I at least need to figure out how to keep from attempting to access a bad buffer before this section can be removed. */
+    {
+	GLenum gl_error = glGetError();
+	if (gl_error != 0) {
+		if (gl_error == GL_INVALID_OPERATION) {
+			vrErrPrintf("_EglRenderFunc(): " RED_TEXT "attempt to set GL-buffer to '%s' (%d) has failed -- visrenmode is '%s'(%d).\n" NORM_TEXT, buffer_name, curr_eye->render_framebuffer,
+			vrVisrenModeName(curr_window->visrenmode), curr_window->visrenmode);
+		} else {
+			vrErrPrintf("_EglRenderFunc(): " RED_TEXT" a GL error of type '%s' (%d) has occurred.\n" NORM_TEXT,
+				_EglGLErrorCodeString(gl_error),
+				(int)gl_error);
+		}
+	}
+    }
+#endif
+
+	/* with dynamic resolution, the world goes to the offscreen framebuffer */
+	vrDynresBegin(&(aux->dynres), renderinfo, _EglGetProcAddress);
+
+
+	/******************************/
+	/* (iii) handle color masking */
+	switch (curr_eye->color) {
+	case VRANAGLYPH_ALL:
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		break;
+	case VRANAGLYPH_RED:
+		glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_TRUE);
+		break;
+	case VRANAGLYPH_GREEN:
+		glColorMask(GL_FALSE, GL_TRUE, GL_FALSE, GL_TRUE);
+		break;
+	case VRANAGLYPH_BLUE:
+		glColorMask(GL_FALSE, GL_FALSE, GL_TRUE, GL_TRUE);
+		break;
+	}
+
+
+	/************************/
+	/* (iv) handle viewmask */
+	/* TODO: perhaps this task should be done after all the rendering is complete */
+
+	/* TODO: this task */
+
+
+
+	/*****************************************/
+	/* (v) put transform matrix on the stack */
+	vrTrace("_EglRenderFunc", "(v) put transform matrix on the stack");
+
+	/* 6/18/01: by putting the viewing transformation on the projection-matrix */
+	/*   stack, lighting and environment maps should work.  However, to have   */
+	/*   fog effects work the viewing transform needs to go on the modelview   */
+	/*   stack instead.                                                        */
+
+	/* TODO: there should be be an option that allows the application to */
+	/*   choose to put the perspective matrix on the ModelView stack in  */
+	/*   case it prefers to have working fog over working lighting.      */
+
+	glPushMatrix(); /* { */
+
+#if 1 /* since I've just created this new function for an additional purpose, I thought I might also use it here. */
+	_EglSetProjectionTransform(pd);		/* this call puts the proper projection matrices at the top of the PROJECTION & MODELVIEW stacks */
+
+#else /* { */
+	glMatrixMode(GL_PROJECTION);
+#ifdef USE_FRUSTUMEYE
+	glLoadIdentity();
+	if (pd->frustum.n.left != -HUGE_VAL) {
+		glFrustum(pd->frustum.n.left,
+			pd->frustum.n.right,
+			pd->frustum.n.bottom,
+			pd->frustum.n.top,
+			pd->frustum.n.near_clip,
+			pd->frustum.n.far_clip);
+	} else {
+		vrDbgPrintfN(EGL_DBGLVL, "_EglRenderFunc(): " RED_TEXT "Invalid Frustum, viewpoint on render plane\n" NORM_TEXT);
+	}
+#else
+	if (!VRMAT_ROWCOL(&pd->mat, VR_W, VR_W) == 0.0)
+		glLoadMatrixd(pd->mat.v);
+	else	vrDbgPrintfN(EGL_DBGLVL, "_EglRenderFunc(): " RED_TEXT "Invalid Perspective Matrix, viewpoint on render plane\n" NORM_TEXT);
+#endif
+
+#ifdef USE_FRUSTUMEYE
+	/* NOTE: Stuart says the real-world to window transform should be */
+	/*   on the ModelView stack in order to get proper lighting, etc. */
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+	glTranslated(-pd->eye[VR_X], -pd->eye[VR_Y], -pd->eye[VR_Z]);
+	glMultMatrixd(curr_window->rw2w_xform->v);
+#else
+	glMultMatrixd(curr_window->rw2w_xform->v);
+	glMatrixMode(GL_MODELVIEW);
+#endif
+#endif /* } */
+
+	/**************************/
+	/* (vi) render the world  */
+      if (curr_window->world_show || curr_window->mount != VRWINDOW_SIMULATOR) {	/* NOTE: world rendering can only be disabled in simulator windows */
+	vrTrace("_EglRenderFunc", "(vi) render the world");
+
+	/* set the world rendering callback.  Start with the user's callback because that takes precedence. */
+	/*   (A single-pass stereo frame is rendered by the stereo callback.) */
+	if (renderinfo->stereo != NULL)
+		callback = curr_window->VisrenWorldStereo;
+	else	callback = curr_user->VisrenWorld;
+	if (!callback)
+		callback = curr_window->VisrenWorld;
+	if (!callback) {
+		if (nocallback_msg == 0) {
+			vrErrPrintf("_EglRenderFunc(): no callback for rendering the world available\n");
+			nocallback_msg = 1;
+		}
+	}
+
+	/* if a non-default rendermode is set, then set it */
+	if (curr_window->frontrendermode != GL_NONE) {
+		glPolygonMode(GL_FRONT, curr_window->frontrendermode);
+	}
+	if (curr_window->backrendermode != GL_NONE) {
+		glPolygonMode(GL_BACK, curr_window->backrendermode);
+	}
+
+	glPushMatrix(); /* { */
+	vrTrace("_EglRenderFunc", "(vi) invoking the callback");
+	/* TODO: beginning with version 0.5a, add the renderinfo to this callback -- 2/27/03, or maybe 0.4f */
+	vrCallbackInvokeDynamic(callback, 1, renderinfo);
+	glPopMatrix(); /* } */
+
+	/* TODO: check whether GL is in an error state (or has set */
+	/*   the error flag), and print a warning if it has.       */
+	/*   Probably best (timewise) to only do this when at a    */
+	/*   sufficiently high debug level the default is probably */
+	/*   good.                                                 */
+	/* Hmmmm, why is the error check being done in the _EglRenderText() routine?  Did I put it in the wrong place? */
+	/*   Looking back, I think what happened is that Ed put the error calls int _EglRenderText() in order to debug */
+	/*   that routine, and then they got left there.  Currently, the call is made in phase 1 of the rendering in   */
+	/*   vr_visren.c, just before the framebuffer swap.  NOTE: it's called via a callback to the _EglRenderErrors()*/
+	/*   function contained here in this file.  So, ideally, that should be sufficient -- having it there also     */
+	/*   covers possible rendering errors in FreeVR, but I should see and solve those right away.                  */
+
+	/* if a non-default rendermode is set, then restore to fill-mode */
+	if (curr_window->frontrendermode != GL_NONE) {
+		glPolygonMode(GL_FRONT, GL_FILL);
+	}
+	if (curr_window->backrendermode != GL_NONE) {
+		glPolygonMode(GL_BACK, GL_FILL);
+	}
+       } else {
+		/* If we don't render the world, then we at least need to clear the screen */
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+       }
+
+	/* upscale the world into the window (when rendered offscreen) */
+	vrDynresEnd(&(aux->dynres), renderinfo);
+
+	/* measure: time just spent in rendering each eye (not counting the simulator and information displays) */
+	/*   (but not from a render thread -- only the process itself makes the marks) */
+	if (!curr_window->render_thread)
+		vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDER1, 1);
+
+	/*****************************************************/
+	/* (vii) call simulator_render (if simulator window) */
+	/* NOTE: this is done after world_render because the window */
+	/*       is typically cleared by world_render.              */
+	if (curr_window->mount == VRWINDOW_SIMULATOR) {
+		vrTrace("_EglRenderFunc", "(vii) call simulator_render");
+
+		callback = curr_user->VisrenSim;
+		if (!callback) {
+			callback = curr_window->VisrenSim;
+		}
+		if (callback) {
+			vrCallbackInvokeDynamic(callback, 2, renderinfo, curr_window->simulator_mask);
+		} else	vrDbgPrintfN(ALWAYS_DBGLVL, "_EglRenderFunc(): " RED_TEXT "no simulator callback available\n" NORM_TEXT);
+
+	}
+
+
+	/**************************************************************/
+	/* (viii) display extra-world information (fps, stats, etc. ) */
+
+
+	/*** render the timing statistics as a bar-graph ***/
+      if (curr_window->stats_show) {
+	for (count = 0; count < VR_MAXSTATS; count++) {
+		if (curr_window->stats[count] != NULL && *curr_window->stats[count] != NULL && (*(curr_window->stats[count]))->show_flag
+		    && ((*(curr_window->stats[count]))->window_name == NULL || !strcmp((*(curr_window->stats[count]))->window_name, curr_window->name))) {
+			vrProcessStats	*stats = *(curr_window->stats[count]);
+			double		char_height = 13;		/* empirically determined height of characters in pixels */
+			double		char_width = 6.05;		/* empirically determined width of characters in pixels */
+			double		text_scale = (char_height / curr_window->geometry.height);
+			double		bottom = stats->yloc;			/* y location of bottom of chart */
+			double		y;
+			int		segment;				/* for counting through the elements */
+
+			/* if not currently rendering in 2D-ortho mode, then do so */
+			if (!twod_ortho_mode) {
+				/** go into 2-D ortho perspective mode **/
+				glPushAttrib(0
+					| GL_CURRENT_BIT	/* covers current color and rendering mode */
+					| GL_ENABLE_BIT		/* covers all enable bits (inc. texture 2d)*/
+					| GL_TRANSFORM_BIT	/* covers glMatrixMode, glNormalize & others */
+					| GL_LINE_BIT		/* covers glLineWidth */
+					| GL_STENCIL_BUFFER_BIT	/* covers all the stencil stuff */
+				);
+				glDisable(GL_LIGHTING);
+				glDisable(GL_TEXTURE_1D);
+				glDisable(GL_TEXTURE_2D);
+				/* TODO: add 3D, after checking for that extension */
+
+	#if 1 /* Option: without this the text will be masked by polygons "between the window and the viewer" */
+				glDisable(GL_DEPTH_TEST);
+	#endif
+
+				glMatrixMode(GL_PROJECTION);
+				glLoadIdentity();
+				glOrtho(0.0, 1.0,  0.0, 1.0, -1.0, 1.0);	/* allows raster pos to be specified as 0.0 to 1.0 */
+				glMatrixMode(GL_MODELVIEW);
+				glPushMatrix();
+				glLoadIdentity();
+				twod_ortho_mode = 1;
+			}
+
+			/* draw the backdrops, time lines and bars in one batch */
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);/* also works with GL_ONE as arg2 */
+			vrGLRenderStatsChart(stats, curr_window->geometry.width, curr_window->geometry.height);
+
+			/* draw the element labels */
+			y = bottom + (2.2 * text_scale);
+			for (segment = 0; segment < stats->elements; segment++) {
+				glColor4fv(stats->elem_colors[segment]);
+				glRasterPos2f(0.04, y);
+				_EglRenderText(renderinfo, stats->elem_labels[segment]);
+				y += text_scale /* 0.012 */;	/* TODO: was ... "0.012 * scale", but that doesn't make sense -- perhaps we could have a "window_scale" value based on the size of the window */
+			}
+
+
+			/* draw the overall stats label */
+			glColor4fv(stats->label_color);
+			glRasterPos2f(0.01, bottom + (text_scale /*0.005*/ /*  * scale */));
+			_EglRenderText(renderinfo, stats->label);
+		}
+	}
+      }
+
+	/*** render the frame rate as text ***/
+	if (curr_window->fps_show) {
+static		char	fps_string[128];
+
+		vrTrace("_EglRenderFunc", "(viii) display the frame rate");
+
+		/* if not currently rendering in 2D-ortho mode, then do so */
+		if (!twod_ortho_mode) {
+			/** go into 2-D ortho perspective mode **/
+			glPushAttrib(0
+				| GL_CURRENT_BIT	/* covers current color and rendering mode */
+				| GL_ENABLE_BIT		/* covers all enable bits (inc. texture 2d)*/
+				| GL_TRANSFORM_BIT	/* covers glMatrixMode, glNormalize & others */
+				| GL_LINE_BIT		/* covers glLineWidth */
+				| GL_STENCIL_BUFFER_BIT	/* covers all the stencil stuff */
+			);
+			glDisable(GL_LIGHTING);
+			glDisable(GL_TEXTURE_1D);
+			glDisable(GL_TEXTURE_2D);
+			/* TODO: add 3D, after checking for that extension */
+
+#if 1 /* Option: without this the text will be masked by polygons "between the window and the viewer" */
+			glDisable(GL_DEPTH_TEST);
+#endif
+
+			glMatrixMode(GL_PROJECTION);
+			glLoadIdentity();
+			glOrtho(0.0, 1.0,  0.0, 1.0, -1.0, 1.0);	/* allows raster pos to be specified as 0.0 to 1.0 */
+			glMatrixMode(GL_MODELVIEW);
+			glPushMatrix();
+			glLoadIdentity();
+			twod_ortho_mode = 1;
+		}
+
+		/** now render the frame rate data **/
+		glColor3fv(curr_window->fps_color);
+		glRasterPos2f(curr_window->fps_loc[0], curr_window->fps_loc[1]);
+		sprintf(fps_string, "FPS: %5.2f(1) %5.2f(10)", curr_window->proc->fps1, curr_window->proc->fps10);
+		_EglRenderText(renderinfo, fps_string);
+	}
+
+	/*** render input histories ***/
+	if (curr_window->inputs_show) {
+static		char		string[256];
+		vrInputInfo	*inputs = renderinfo->context->input;	/* aka "vrInputs" */
+		int		count;
+
+		vrTrace("_EglRenderFunc", "(viii) display input histories");
+
+		/* first do a simple render of the first wand */
+		glPushMatrix();
+		vrRenderTransform6sensor(renderinfo, 1);
+		glBegin(GL_LINES);
+			/* a cyan line pointing out */
+			glColor3ub(0, 255, 255);
+			glVertex3f(0.0, 0.0, 0.0);
+			glVertex3f(0.0, 0.0, -1.0);
+
+			/* a red line pointing up */
+			glColor3ub(255, 50, 50);
+			glVertex3f(0.0, 0.0, 0.0);
+			glVertex3f(0.0, 0.5, 0.0);
+
+			/* a green line side to side */
+			glColor3ub(50, 255, 50);
+			glVertex3f(-0.5, 0.0, 0.0);
+			glVertex3f( 0.5, 0.0, 0.0);
+		glEnd();
+		glPopMatrix();
+
+		/* if not currently rendering in 2D-ortho mode, then do so */
+		if (!twod_ortho_mode) {
+			/** go into 2-D ortho perspective mode **/
+			glPushAttrib(0
+				| GL_CURRENT_BIT	/* covers current color and rendering mode */
+				| GL_ENABLE_BIT		/* covers all enable bits (inc. texture 2d)*/
+				| GL_TRANSFORM_BIT	/* covers glMatrixMode, glNormalize & others */
+				| GL_LINE_BIT		/* covers glLineWidth */
+				| GL_STENCIL_BUFFER_BIT	/* covers all the stencil stuff */
+			);
+			glDisable(GL_LIGHTING);
+			glDisable(GL_TEXTURE_1D);
+			glDisable(GL_TEXTURE_2D);
+			/* TODO: add 3D, after checking for that extension */
+
+#if 1 /* Option: without this the text will be masked by polygons "between the window and the viewer" */
+			glDisable(GL_DEPTH_TEST);
+#endif
+
+			glMatrixMode(GL_PROJECTION);
+			glLoadIdentity();
+			glOrtho(0.0, 1.0,  0.0, 1.0, -1.0, 1.0);	/* allows raster pos to be specified as 0.0 to 1.0 */
+			glMatrixMode(GL_MODELVIEW);
+			glPushMatrix();
+			glLoadIdentity();
+			twod_ortho_mode = 1;
+		}
+
+		/** now render the historical input data **/
+		glColor3fv(curr_window->fps_color);			/* TODO: should this have it's own color? */
+		glLineWidth(5.0);					/* TODO: should this be configurable somewhere */
+
+#if 1
+		/* history of the 2-switches */
+		for (count = 0; count < inputs->num_2ways; count++) {
+			vr2switch	*input = inputs->switch2[count];
+
+			/* if the history for this input is enabled, then render it as a ... */
+			if (input->num_measures > 0) {
+				int	step;
+
+				for (step = 0; step < input->num_measures; step++) { 
+#if 0 /* [12/04/09: This is a choice between sweep/scope view and stream/scroll view] */
+					int	measurement = ((step-(input->current_measure-1))+(input->num_measures)) % input->num_measures;
+#else
+					int	measurement = (step+(input->current_measure+1)) % input->num_measures;
+#endif
+#if 0
+if (count == 1)
+printf("input %d: step = %d, current = %d, measurement = %d, timestamp = %lf\n", count, step, input->current_measure, measurement, input->timestamp);
+#endif
+
+					if (input->measures[measurement]) {
+						double	yloc = 0.18 + count * 0.05;
+#if 0
+						double	xloc = (double)(measurement)/(double)(input->num_measures) + 0.003;
+#else
+						double	xloc = (double)(step)/(double)(input->num_measures) + 0.0003;
+#endif
+
+						glBegin(GL_LINE_STRIP);
+							glVertex2d(xloc, yloc);
+							yloc += 0.04;
+							glVertex2d(xloc, yloc);
+						glEnd();
+					}
+				}
+			}
+		}
+#endif
+
+		/* history of the valuators */
+		for (count = 0; count < inputs->num_valuators; count++) { vrValuator	*input = inputs->valuator[count]; /* if the history for this input is enabled, then render it as a ... */ if (input->num_measures > 0) { int	step; switch (count) { case 0:	glColor3ub(240,  50,  50); break;	/* red */ case 1:	glColor3ub(240, 240, 240); break;	/* white */ case 2:	glColor3ub( 50, 240, 240); break;	/* cyan */
+				case 3:	glColor3ub(100,   0, 255); break;	/* dark purple */
+				case 4: glColor3ub(  0, 255,   0); break;	/* green */
+				case 5: glColor3ub(191, 121,   0); break;	/* dark yellow */
+				case 6: glColor3ub(240, 138, 133); break;	/* rose */
+				case 7: glColor3ub(240, 130,  30); break;	/* orange */
+				}
+				for (step = 0; step < input->num_measures; step++) { 
+#if 0 /* [12/04/09: This is a choice between sweep/scope view and stream/scroll view] */
+					int	measurement = ((step-(input->current_measure-1))+(input->num_measures)) % input->num_measures;
+#else
+					int	measurement = (step+(input->current_measure+1)) % input->num_measures;
+#endif
+					double	yloc = 0.06 + count * 0.08;
+					double	xloc = (double)(step)/(double)(input->num_measures) + 0.0003;
+
+#if 0
+if (count == 1)
+printf("input %d: step = %d, current = %d, measurement = %d, xloc = %0.4f\n", count, step, input->current_measure, measurement, xloc);
+#endif
+
+					glBegin(GL_LINE_STRIP);
+						glVertex2d(xloc, yloc);
+						yloc += input->measures[measurement] * 0.05;
+						glVertex2d(xloc, yloc);
+					glEnd();
+				}
+
+				/** now render the input name and current value **/
+#if 0
+				glColor3fv(curr_window->fps_color);
+				glRasterPos2f(curr_window->fps_loc[0], curr_window->fps_loc[1]);
+#else
+				glRasterPos2f(0.70, 0.05 + count * 0.08);
+#endif
+				sprintf(string, "input: %s (%5.2f)", input->my_object->name, input->measures[(input->current_measure-1) % input->num_measures]);
+				_EglRenderText(renderinfo, string);
+			}
+		}
+	}
+
+	/*** render the user-interface information on screen ***/
+	if (curr_window->ui_show) {
+#if defined(MP_PTHREADS) || defined(MP_PTHREADS2)	/* pthreads requires a separate copy for each string to avoid overwriting */
+		char	ui_string[2048];
+		char	ui_string_tok[2048];
+#else
+static		char	ui_string[2048];
+static		char	ui_string_tok[2048];
+#endif
+		char	*next_line;			/* the current line to be rendered */
+		float	back_color[4] = { 0.20, 0.20, 0.20, 0.50 };	/* a semi-transparent dark gray */
+		float	border_color[4] = { 1.00, 1.00, 1.00, 1.00 };	/* an opaque white */
+		double	char_height = 13;		/* empirically determined height of characters in pixels */
+		double	char_width = 6.00;		/* empirically determined width of characters in pixels */
+		double	xscale;				/* text char separation (basically a percentage of screen) */
+		double	yscale;				/* text line separation (basically a percentage of screen) */
+		double	top = curr_window->ui_loc[1];	/* y location of top of display */
+		double	left =  curr_window->ui_loc[0];	/* x location of left of display */
+		double	bottom;				/* y location of bottom of display (calculated) */
+		double	right;				/* x location of right of display (calculated) */
+		double	y;				/* for advancing text lines */
+		int	width, height;			/* the character dimensions of the string */
+
+		vrTrace("_EglRenderFunc", "(viii) display the user-interface information");
+
+		/* if not currently rendering in 2D-ortho mode, then do so */
+		if (!twod_ortho_mode) {
+			/** go into 2-D ortho perspective mode **/
+			glPushAttrib(0
+				| GL_CURRENT_BIT	/* covers current color and rendering mode */
+				| GL_ENABLE_BIT		/* covers all enable bits (inc. texture 2d)*/
+				| GL_TRANSFORM_BIT	/* covers glMatrixMode, glNormalize & others */
+				| GL_LINE_BIT		/* covers glLineWidth */
+				| GL_STENCIL_BUFFER_BIT	/* covers all the stencil stuff */
+			);
+			glDisable(GL_LIGHTING);
+			glDisable(GL_TEXTURE_1D);
+			glDisable(GL_TEXTURE_2D);
+			/* TODO: add 3D, after checking for that extension */
+
+#if 1 /* Option: without this the text will be masked by polygons "between the window and the viewer" */
+			glDisable(GL_DEPTH_TEST);
+#endif
+
+			glMatrixMode(GL_PROJECTION);
+			glLoadIdentity();
+			glOrtho(0.0, 1.0,  0.0, 1.0, -1.0, 1.0);	/* allows raster pos to be specified as 0.0 to 1.0 */
+			glMatrixMode(GL_MODELVIEW);
+			glPushMatrix();
+			glLoadIdentity();
+			twod_ortho_mode = 1;
+		}
+
+		/* make the user-interface output string */
+		vrSprintInputUI(ui_string, renderinfo->context->input, sizeof(ui_string), verbose);
+		width = vrStringCharWidth(ui_string);
+		height = vrStringCharHeight(ui_string) - 1;	/* subtract the trailing, empty, line */
+
+		/* adjust the right and bottom values based on size of window and string */
+
+#if 0
+		scale = curr_window->geometry.height * 0.0001;
+		bottom = top - (height * scale);
+		right = left + (width * scale * 0.2);
+#else
+		xscale = char_width / curr_window->geometry.width;
+		yscale = char_height / curr_window->geometry.height;
+		right = left + (xscale * (width + 2));
+		bottom = top - (yscale * (height + 1));
+#endif
+
+		/* adjust the colors of the background (darker and transparent)  */
+		/*   and the border (lighter and opaque) based on the text color */
+		back_color[0] = curr_window->ui_color[0] * 0.20;
+		back_color[1] = curr_window->ui_color[1] * 0.20;
+		back_color[2] = curr_window->ui_color[2] * 0.20;
+		back_color[3] = 0.50;
+
+		border_color[0] = 1.0 - ((1.0 - curr_window->ui_color[0]) * 0.50);
+		border_color[1] = 1.0 - ((1.0 - curr_window->ui_color[1]) * 0.50);
+		border_color[2] = 1.0 - ((1.0 - curr_window->ui_color[2]) * 0.50);
+		border_color[3] = 1.0;
+
+		/* draw a semi-transparent background to help contrast */
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);/* also works with GL_ONE as arg2 */
+
+		glColor4fv(back_color);				/* usually semi-transparent */
+		glBegin(GL_POLYGON);
+			glVertex2d(left,  bottom);
+			glVertex2d(left,  top);
+			glVertex2d(right, top);
+			glVertex2d(right, bottom);
+		glEnd();
+
+		/* and put a white border around three sides -- since we don't know how far left the text will go */
+		glColor4fv(border_color);
+		glBegin(GL_LINE_LOOP);
+			glVertex2d(right, top);
+			glVertex2d(left,  top);
+			glVertex2d(left,  bottom);
+			glVertex2d(right, bottom);
+		glEnd();
+
+		/** now render the user-interface data **/
+		glColor3fv(curr_window->ui_color);
+
+		y = top - (1.30 * yscale);
+		next_line = strtok_r(ui_string, "\n", (char **)&ui_string_tok);
+		do {
+			glRasterPos2f(left + 1.0 * xscale, y);
+			_EglRenderText(renderinfo, next_line);
+			y -= yscale;
+		} while (next_line = strtok_r(NULL, "\n", (char **)&ui_string_tok));
+	}
+
+	/*** restore to 3D mode if we changed into 2D ortho mode ***/
+	if (twod_ortho_mode) {
+		glPopMatrix();
+		glPopAttrib();
+	}
+
+	/* measure: time just spent in rendering the simulator and information displays */
+	/*   (but not from a render thread -- only the process itself makes the marks) */
+	if (!curr_window->render_thread)
+		vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDERINFO, 1);
+
+
+	/**************************************/
+	/* TODO: does viewmask stuff go here? */
+
+
+	/***********************************/
+	/* (ix) restore gfx matrix/state */
+	glPopMatrix(); /* } */
+
+	vrGpuTimerEyeEnd(&(aux->gputimer));
+
+	sprintf(trace_msg, "ending window render loop for window '%s' %#p", curr_window->name, curr_window);
+	vrTrace("_EglRenderFunc", trace_msg);
+}
+/* end of render function */
+
+
+/****************************************************************************/
+static void _EglRenderNullWorld()
+{
+	glClearColor(0.0, 0.0, 0.0, 0.0);
+	glClearDepth(1.0);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+
+/****************************************************************************/
+/* _EglRenderText(): there are no X fonts to render with, and nobody to see */
+/*   the text anyway, so the text is skipped.                               */
+static void _EglRenderText(vrRenderInfo *renderinfo, char *string)
+{
+	vrDbgPrintfN(RARE_DBGLVL, "_EglRenderText(): not rendering '%s'\n", (string == NULL ? "(null)" : string));
+}
+
+
+/****************************************************************************/
+/* vrEglInitWindowInfo(): setup all the callbacks needed for EGL rendering. */
+/****************************************************************************/
+void vrEglInitWindowInfo(vrWindowInfo *info)
+{
+	vrDbgPrintfN(DEFAULT_DBGLVL, "Initializing callback and version Info for Window at %#p\n", info);
+
+	info->version = (char *)vrShmemStrDup("EGL headless render window");
+	info->PrintAux = vrCallbackCreateNamed("EglWindow:PrintAux-Def", vrFprintEglPrivateInfo, 0);
+	info->PreOpenInit = vrCallbackCreateNamed("EglWindow:PreOpenInit-DN", vrDoNothing, 0);
+	info->Open = vrCallbackCreateNamed("EglWindow:Open-Def", _EglOpenFunc, 1, info);
+	info->Close = vrCallbackCreateNamed("EglWindow:Close-Def", _EglCloseFunc, 1, info);
+	info->Swap = vrCallbackCreateNamed("EglWindow:Swap-Def", _EglSwapFunc, 1, info);
+	info->SwapWait = vrCallbackCreateNamed("EglWindow:SwapWait-DN", vrDoNothing, 0);
+	info->Errors = vrCallbackCreateNamed("EglWindow:Errors-Def", _EglRenderErrors, 0);
+	info->RenderTransform = vrCallbackCreateNamed("EglWindow:Transform-Def", _EglRenderTransform, 0);
+	info->SetProjectionTransform = vrCallbackCreateNamed("EglWindow:ProjectionTransform-Def", _EglSetProjectionTransform, 0);
+	info->Render = vrCallbackCreateNamed("EglWindow:Render-Def", _EglRenderFunc, 0);
+	info->single_pass_stereo = 1;	/* _EglRenderFunc() can hand both eyes to the world callback */
+	info->RenderText = vrCallbackCreateNamed("EglWindow:RenderText-Def", _EglRenderText, 0);
+	info->RenderNullWorld = vrCallbackCreateNamed("EglWindow:RenderNW-Def", _EglRenderNullWorld, 0);
+	info->RenderSimulator = vrCallbackCreateNamed("EglWindow:RenderSim-Def", vrGLRenderDefaultSimulator, 0);
+}
+
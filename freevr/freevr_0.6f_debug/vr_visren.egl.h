@@ -0,0 +1,70 @@
+/* ======================================================================
+ *
+ * HH   HH         vr_visren.egl.h
+ * HH   HH         Author(s): agent
+ * HHHHHHH         Created: October 19, 2026 (based on vr_visren.glx.h)
+ * HH   HH         Last Modified: October 19, 2026
+ * HH   HH
+ *
+ * Header file for FreeVR visual rendering into headless (offscreen)
+ *   EGL pbuffer windows.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * Based on vr_visren.glx.h, Copyright 2014, Bill Sherman, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#ifndef __VRVISREN_EGL_H__
+#define __VRVISREN_EGL_H__
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+
+#if !defined(TEST_APP) /* { */
+#include "vr_visren.h"
+#include "vr_visren.dynres.h"
+#include "vr_visren.capture.h"
+#include "vr_visren.gputimer.h"
+#endif /* } !TEST_APP */
+
+
+/**************************************************/
+/* EGL-specific data (private to each EGL window) */
+/*   This structure is pointed to by the "aux_data" field of the vrWindowInfo structure.*/
+typedef struct {
+
+		char		*device;	/* CONFIG-arg: which EGL display to use ("surfaceless" or "default") */
+		int		width;		/* CONFIG-arg: width of the pbuffer */
+		int		height;		/* CONFIG-arg: height of the pbuffer */
+		int		finish;		/* CONFIG-arg: flag to wait for the GPU at each swap */
+		vrDynresInfo	dynres;		/* CONFIG-arg: the dynamic resolution scaling of the world */
+		vrCaptureInfo	capture;	/* the frame capture of the window */
+		vrGpuTimerInfo	gputimer;	/* the GPU time measurement of the window */
+
+		EGLDisplay	egl_display;	/* the EGL display connection */
+		EGLConfig	egl_config;	/* the chosen framebuffer configuration */
+		EGLSurface	egl_surface;	/* the offscreen pbuffer surface */
+		EGLContext	egl_context;	/* the graphics context */
+		int		mapped;		/* a boolean to indicate that the pbuffer is ready */
+	} vrEglPrivateInfo;
+
+
+/*****************************/
+/*** Function declarations ***/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void	vrEglInitWindowInfo(vrWindowInfo *);
+
+/* locally scoped functions (ie. used only in vr_visren.egl.c) */
+static	void	_EglRenderFunc(vrRenderInfo *renderinfo);
+static	void	_EglRenderNullWorld();
+static	void	_EglRenderText(vrRenderInfo *renderinfo, char *string);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -22,6 +22,28 @@ FreeVR USAGE:
 			(use "none" when windows will be joined with neighboring windows)
 		"title=window title" -- set the title on the window title bar
 		"cursor={default|blank|dot|bigdot|superdot}" -- set the name of the cursor
+		"framesInFlight=<n>" -- rather than waiting for the GPU at each swap, allow
+			up to <n> (1 to 3) swapped frames to be pending, using GL sync fences.
+			The waiting is done once all the windows of the process are swapped.
+			(default is 0 -- wait for the GPU in each swap)
+		"eventThread={0|1}" -- read the window's X events in a separate thread
+			(with its own X connection), leaving the render loop to only
+			check a queue of the events.  (default is 0 -- read the
+			events in the render loop)
+		"dynamicResolution=<min>[,<max>]" -- render the world of each eye
+			into an offscreen framebuffer at a scale (of each axis) between
+			<min> and <max> (default 1.0), and upscale it into the window.
+			The scale follows the frame time of the process, to keep it
+			within the window's "frameBudget".  Not for simulator windows.
+			(default is off)
+		"swapTiming={0|1}" -- measure when each swapped frame reaches the
+			display (with GLX_OML_sync_control), giving the window's
+			motion-to-photon latency and missed vertical blanks.  Without
+			the extension, the display time is estimated as when the GPU
+			was known to be done with the swap.  (default is 0 -- off)
+			NOTE: this has only been compiled, never run against an X
+			server -- neither with the extension, nor with the estimate.
+			EGL windows ignore it.
 
 	Controls are specified in the freevrrc file:
 	  :-(	e.g.: control "<control option>" = "switch2(button[{1|2|3|4|5|6|7|8|Star}])";
@@ -60,10 +82,11 @@ TODO:
 #include <string.h>
 #include <X11/keysym.h>
 #include <math.h>			/* needed for HUGE_VAL (aka __infinity) definition */
+#include <time.h>			/* for clock_gettime() -- the clock of the swap times */
 
 #include "vr_visren.h"
 #include "vr_visren.glx.h"
-#include "vr_basicgfx.glx.h"		/* needed for vrGLRenderDefaultSimulator() */
+#include "vr_basicgfx.glx.h"		/* needed for vrGLRenderDefaultSimulator() & vrGLRenderStatsChart() */
 #include "vr_callback.h"		/* also included within vr_input.h, but left for clarity */
 #include "vr_input.h"
 #include "vr_debug.h"
@@ -73,13 +96,45 @@ TODO:
 #include <osgUtil/SceneView>
 #include <osg/FrameStamp>
 #include <osg/Timer>
+#include <osg/State>
+#include <osg/GraphicsContext>
+#include <osgDB/DatabasePager>
+#include <osgUtil/IncrementalCompileOperation>
 
 /* Local Globals */
-/* Question: do these need to be local to a single process, or all visren processes? */
-/* TODO: determine the necessity of these as global variables */
+/* NOTE: when the FreeVR processes are forked, each visren process has its  */
+/*   own copy of these (and of the scene graph), but when they are threads */
+/*   (MP_PTHREADS) they all share one graph with the application.  Either  */
+/*   way, the graph is guarded by osg_graph_lock: the cull & draw of each   */
+/*   render hold it for reading (so render threads still cull in parallel), */
+/*   while the once-per-frame update (_GlxOSGFrameUpdate()) and the        */
+/*   application's vrOSGBeginModifySceneGraph() hold it for writing.       */
 static osg::ref_ptr<osg::Node>			osg_scenedata = NULL;	/* Pointer to scene graph */
-static vrLock					osg_sg_lock;		/* Lock to protect scene graph changes */
 static osg::ref_ptr<osgDB::DatabasePager>	osg_databasePager = NULL;/* Database pager for PagedLOD */
+static osg::ref_ptr<osgUtil::IncrementalCompileOperation> osg_compile_op = NULL;/* compiles the GL objects of the pager's tiles */
+static osg::ref_ptr<osg::FrameStamp>		osg_framestamp = NULL;	/* the frame stamp shared by all the eyes of a frame */
+static osg::Timer_t				osg_start_tick;		/* Start tick of the first frame -- for the frame stamp */
+static long					osg_frame_count = -1;	/* the frame the scene graph was last updated for */
+static vrCallback				*osg_update_callback = NULL;/* application changes to the graph (once per frame) */
+static pthread_mutex_t				osg_frame_lock = PTHREAD_MUTEX_INITIALIZER;/* picks the one window to do the update */
+static pthread_rwlock_t				osg_graph_lock;		/* read by the renders, written by changes to the graph */
+static pthread_once_t				osg_graph_lock_once = PTHREAD_ONCE_INIT;
+
+/* The database pager's per-frame budget (see vrOSGSetPagerBudget()) */
+/* NOTE: a tile can only be merged into the graph all at once, so the   */
+/*   merge slice is kept by holding back the ready tiles until they are */
+/*   expected to fit -- and by only compiling as many tiles as a single */
+/*   slice can merge.  So that a backlog can't starve, the ready tiles  */
+/*   are merged regardless after GLX_OSG_MAXMERGEDEFER frames.          */
+#define	GLX_OSG_MAXMERGEDEFER	10
+static double					osg_pager_merge_time = 0.002;	/* secs per frame to spend merging loaded tiles */
+static double					osg_pager_compile_time = 0.004;	/* secs per frame (per window) to spend compiling & deleting GL objects */
+static double					osg_pager_tile_cost = 0.0;	/* smoothed time to merge one tile */
+static int					osg_pager_deferred = 0;		/* frames the ready tiles have been held back */
+
+#if 1 /* compile-time option: compile the pager's GL objects in a thread with a shared context (else in the render loop) */
+#  define GLX_OSG_COMPILE_THREAD
+#endif
 #endif
 
 #if 0 /* set to 1 to prevent local vrTrace messages */
@@ -196,7 +251,9 @@ void vrFprintGlxPrivateInfo(FILE *file, vrGlxPrivateInfo *aux, vrPrintStyle styl
 			"\tDisplay = %#p\n\tWindow = %#p\n\tXvisual = %#p\n"
 			"\tXcolormap = %#p\n\tGLXContext = 0x%x\n"
 			"\tscreen_size = %dx%d\n\tdecorations = 0x%x\n\n"
-			"\tmapped = %d\n\tused_by_input = %d\n\tstereo buffer = %d\n\tdouble buffer = %d\n",
+			"\tmapped = %d\n\tused_by_input = %d\n\tstereo buffer = %d\n\tdouble buffer = %d\n"
+			"\tframes in flight = %d\n"
+			"\tevent thread = %d (running = %d, events dropped = %u)\n",
 			aux->xhost,
 			aux->xserver,
 			aux->xscreen,
@@ -211,7 +268,19 @@ void vrFprintGlxPrivateInfo(FILE *file, vrGlxPrivateInfo *aux, vrPrintStyle styl
 			aux->mapped,
 			aux->used_by_input,
 			aux->stereo_buf,
-			aux->doub_buf);
+			aux->doub_buf,
+			aux->frames_in_flight,
+			aux->event_thread,
+			aux->event_thread_running,
+			aux->events_dropped);
+		vrDynresFprint(file, &(aux->dynres));
+		vrCaptureFprint(file, &(aux->capture));
+		vrGpuTimerFprint(file, &(aux->gputimer));
+		vrFprintf(file, "\r\tswap timing: oml = %d, vblank period = %.2fms, swaps timed = %ld, mean motion-to-photon = %.2fms\n",
+			aux->oml_status,
+			aux->msc_period * 1000.0,
+			aux->swaps_timed,
+			aux->photon_mean);
 		vrFprintf(file, "\r}  /* TODO: add more GLX details */\n");
 
 		/* TODO: the rest of the fields */
@@ -238,6 +307,193 @@ static char *_GlxGLErrorCodeString(GLenum code)
 }
 
 
+/****************************************************************************/
+/* The sync object functions (OpenGL 3.2, or GL_ARB_sync) used for the swap  */
+/*   fences.  These are fetched at run-time since the GL library to which we */
+/*   link need not have them.  NOTE: on GLX the function addresses are the   */
+/*   same for every context, so they are only fetched once per process.     */
+static	PFNGLFENCESYNCPROC		glFenceSync_func = NULL;
+static	PFNGLCLIENTWAITSYNCPROC		glClientWaitSync_func = NULL;
+static	PFNGLDELETESYNCPROC		glDeleteSync_func = NULL;
+
+/* _GlxLoadSyncFuncs(): returns 1 if the sync functions are available   */
+/*   to the current context, after fetching them if not already fetched. */
+static int _GlxLoadSyncFuncs()
+{
+	const char	*version = (const char *)glGetString(GL_VERSION);
+	const char	*extensions = (const char *)glGetString(GL_EXTENSIONS);
+	int		major = 0;
+	int		minor = 0;
+
+	if (version != NULL)
+		sscanf(version, "%d.%d", &major, &minor);
+	if ((major < 3 || (major == 3 && minor < 2)) && (extensions == NULL || strstr(extensions, "GL_ARB_sync") == NULL))
+		return 0;
+
+	if (glFenceSync_func == NULL) {
+		glFenceSync_func = (PFNGLFENCESYNCPROC)glXGetProcAddressARB((const GLubyte *)"glFenceSync");
+		glClientWaitSync_func = (PFNGLCLIENTWAITSYNCPROC)glXGetProcAddressARB((const GLubyte *)"glClientWaitSync");
+		glDeleteSync_func = (PFNGLDELETESYNCPROC)glXGetProcAddressARB((const GLubyte *)"glDeleteSync");
+	}
+
+	return (glFenceSync_func != NULL && glClientWaitSync_func != NULL && glDeleteSync_func != NULL);
+}
+
+
+/****************************************************************************/
+/* _GlxGetProcAddress(): fetch a GL function for the dynres, capture, gputimer & shapes code */
+static void *_GlxGetProcAddress(const char *name)
+{
+	return (void *)glXGetProcAddressARB((const GLubyte *)name);
+}
+
+
+/****************************************************************************/
+/* The GLX_OML_sync_control functions are fetched at run-time, since the GLX */
+/*   library to which we link need not have them.                            */
+static	PFNGLXGETSYNCVALUESOMLPROC	glXGetSyncValuesOML_func = NULL;
+static	PFNGLXGETMSCRATEOMLPROC		glXGetMscRateOML_func = NULL;
+static	PFNGLXSWAPBUFFERSMSCOMLPROC	glXSwapBuffersMscOML_func = NULL;
+static	PFNGLXWAITFORSBCOMLPROC		glXWaitForSbcOML_func = NULL;
+
+/* _GlxSwapTimingInit(): check whether the swaps of the window can be timed  */
+/*   with GLX_OML_sync_control (which fails on some Mesa drivers, even when  */
+/*   advertised), and find the period of its vertical blanks.                */
+static void _GlxSwapTimingInit(vrWindowInfo *window, vrGlxPrivateInfo *aux)
+{
+	const char	*extensions = glXQueryExtensionsString(aux->xdisplay, DefaultScreen(aux->xdisplay));
+	int64_t		ust, msc, sbc;
+	int32_t		numerator, denominator;
+	int		count;
+
+	aux->oml_status = -1;
+	if (extensions != NULL && strstr(extensions, "GLX_OML_sync_control") != NULL) {
+		if (glXWaitForSbcOML_func == NULL) {
+			glXGetSyncValuesOML_func = (PFNGLXGETSYNCVALUESOMLPROC)glXGetProcAddressARB((const GLubyte *)"glXGetSyncValuesOML");
+			glXGetMscRateOML_func = (PFNGLXGETMSCRATEOMLPROC)glXGetProcAddressARB((const GLubyte *)"glXGetMscRateOML");
+			glXSwapBuffersMscOML_func = (PFNGLXSWAPBUFFERSMSCOMLPROC)glXGetProcAddressARB((const GLubyte *)"glXSwapBuffersMscOML");
+			glXWaitForSbcOML_func = (PFNGLXWAITFORSBCOMLPROC)glXGetProcAddressARB((const GLubyte *)"glXWaitForSbcOML");
+		}
+		if (glXGetSyncValuesOML_func != NULL && glXGetMscRateOML_func != NULL
+		    && glXSwapBuffersMscOML_func != NULL && glXWaitForSbcOML_func != NULL
+		    && glXGetSyncValuesOML_func(aux->xdisplay, aux->xwindow, &ust, &msc, &sbc))
+			aux->oml_status = 1;
+	}
+
+	/* the refresh period: from the extension, or else the window's frame budget */
+	if (aux->oml_status > 0 && glXGetMscRateOML_func(aux->xdisplay, aux->xwindow, &numerator, &denominator) && numerator > 0)
+		aux->msc_period = (double)denominator / (double)numerator;
+	else	aux->msc_period = (window->frame_budget > 0.0 ? window->frame_budget * 0.001 : 1.0 / 60.0);
+
+	if (aux->oml_status > 0) {
+		aux->swap_sbc = sbc;
+	} else {
+		vrMsgPrintf("_GlxSwapTimingInit(): no GLX_OML_sync_control for window '%s' -- "
+			"the display of its frames is estimated from the GPU finishing the swaps.\n", window->name);
+	}
+	for (count = 0; count < GLX_SWAPTIMINGS; count++)
+		aux->swap_ring_sbc[count] = -1;
+	aux->done_sbc = aux->swap_sbc;
+	aux->timed_sbc = aux->swap_sbc;
+	aux->timed_msc = -1;
+	aux->timed_wtime = 0.0;
+	aux->swaps_timed = 0;
+}
+
+
+/****************************************************************************/
+/* _GlxSwapTimingCollect(): measure the display of the newest swap that is   */
+/*   done -- its motion-to-photon latency (from the time of the head sample  */
+/*   it was rendered from), and the vertical blanks missed since the last.   */
+/*   This is done before the next swap, when the previous is usually done,   */
+/*   so that it doesn't wait.                                                */
+/* NOTE: the UST of GLX_OML_sync_control is the CLOCK_MONOTONIC time (usecs) */
+/*   under Linux, so it's moved to the wall clock of the input timestamps.   */
+static void _GlxSwapTimingCollect(vrWindowInfo *window, vrGlxPrivateInfo *aux)
+{
+	int64_t		ust, msc, sbc;
+	struct timespec	mono;
+	vrTime		display_wtime;
+	vrTime		latency;
+	long		missed = 0;
+	int		slot;
+
+	if (aux->oml_status > 0) {
+		if (!glXGetSyncValuesOML_func(aux->xdisplay, aux->xwindow, &ust, &msc, &sbc) || sbc <= aux->timed_sbc)
+			return;
+
+		/* the swap is already done, so this returns at once, with its display time */
+		if (!glXWaitForSbcOML_func(aux->xdisplay, aux->xwindow, sbc, &ust, &msc, &sbc) || ust == 0)
+			return;
+		clock_gettime(CLOCK_MONOTONIC, &mono);
+		display_wtime = (double)ust * 0.000001 + (vrCurrentWallTime() - ((double)mono.tv_sec + (double)mono.tv_nsec * 0.000000001));
+	} else {
+		sbc = aux->done_sbc;
+		if (sbc <= aux->timed_sbc)
+			return;
+		display_wtime = aux->done_wtime;
+		msc = -1;
+	}
+
+	/* the vertical blanks that passed with no new frame to show */
+	if (msc >= 0 && aux->timed_msc >= 0)
+		missed = (long)((msc - aux->timed_msc) - (sbc - aux->timed_sbc));
+	else if (msc < 0 && aux->swaps_timed > 0)
+		missed = (long)((display_wtime - aux->timed_wtime) / aux->msc_period + 0.5) - (long)(sbc - aux->timed_sbc);
+	if (missed < 0)
+		missed = 0;
+	window->missed_vblanks += missed;
+
+	/* measure: the missed vertical blanks (summed by way of the */
+	/*   window, as this may be the window's render thread)     */
+	vrWindowStatsValue(window, VR_VALUE_MISSEDVBLANKS, (double)missed);
+
+	slot = (int)(sbc % GLX_SWAPTIMINGS);
+	if (aux->swap_ring_sbc[slot] == sbc && aux->swap_ring_input[slot] > 0.0) {
+		latency = (display_wtime - aux->swap_ring_input[slot]) * 1000.0;
+		window->photon_latency = latency;
+		if (aux->swaps_timed == 0)
+			aux->photon_mean = latency;
+		else	aux->photon_mean += 0.1 * (latency - aux->photon_mean);
+
+		/* measure: the motion-to-photon latency */
+		vrWindowStatsValueSet(window, VR_VALUE_PHOTONLATENCY, latency);
+	}
+
+	aux->timed_sbc = sbc;
+	aux->timed_msc = msc;
+	aux->timed_wtime = display_wtime;
+	aux->swaps_timed++;
+}
+
+
+/****************************************************************************/
+/* _GlxSwapBuffers(): swap the buffers of the window -- when timing the swaps, */
+/*   noting the swap's count, and the input time of the frame it shows.      */
+static void _GlxSwapBuffers(vrWindowInfo *window, vrGlxPrivateInfo *aux)
+{
+	int64_t	sbc;
+
+	if (!window->swap_timing || aux->oml_status == 0) {
+		glXSwapBuffers(aux->xdisplay, aux->xwindow);
+		return;
+	}
+
+	/* NOTE: with all zero targets, this is the same as glXSwapBuffers(), */
+	/*   but returns the count the swap will have when done.  It returns  */
+	/*   -1 having made no swap, so then -- as when the display is only   */
+	/*   estimated -- the buffers are swapped as usual, and counted here. */
+	if (aux->oml_status > 0 && (sbc = glXSwapBuffersMscOML_func(aux->xdisplay, aux->xwindow, 0, 0, 0)) > 0) {
+		aux->swap_sbc = sbc;
+	} else {
+		glXSwapBuffers(aux->xdisplay, aux->xwindow);
+		aux->swap_sbc++;
+	}
+	aux->swap_ring_sbc[aux->swap_sbc % GLX_SWAPTIMINGS] = aux->swap_sbc;
+	aux->swap_ring_input[aux->swap_sbc % GLX_SWAPTIMINGS] = window->input_wtime;
+}
+
+
 /****************************************************************************/
 static void _GlxParseArgs(vrGlxPrivateInfo *aux, char *args)
 {
@@ -395,6 +651,34 @@ static void _GlxParseArgs(vrGlxPrivateInfo *aux, char *args)
 		aux->cursor_name = vrShmemStrDup(tok);
 	}
 
+	/***********************************************************/
+	/** Argument format: "framesInFlight=" <int> [(";" | ",")] **/
+	/***********************************************************/
+	/* where <int> is the number of swapped frames that may still */
+	/*   be pending on the GPU before the swap waits for them.    */
+	if (str = strstr(args, "framesInFlight=")) {
+		aux->frames_in_flight = atoi(strchr(str, '=') + 1);
+		if (aux->frames_in_flight < 0)
+			aux->frames_in_flight = 0;
+		if (aux->frames_in_flight > GLX_MAXFRAMESINFLIGHT) {
+			vrErrPrintf("_GlxParseArgs(): " RED_TEXT "framesInFlight of %d is more than the maximum, using %d.\n" NORM_TEXT,
+				aux->frames_in_flight, GLX_MAXFRAMESINFLIGHT);
+			aux->frames_in_flight = GLX_MAXFRAMESINFLIGHT;
+		}
+	}
+
+	/*********************************************************/
+	/** Argument format: "eventThread=" {0|1} [(";" | ",")] **/
+	/*********************************************************/
+	if (str = strstr(args, "eventThread=")) {
+		aux->event_thread = atoi(strchr(str, '=') + 1);
+	}
+
+	/*****************************************************************************/
+	/** Argument format: "dynamicResolution=" <min>[,<max>] [(";" | ",")]        **/
+	/*****************************************************************************/
+	vrDynresParseArgs(&(aux->dynres), args);
+
 	vrDbgPrintf("================================================\n");
 	vrDbgPrintf("done parsing argument string `%s'\n", args);
 	vrDbgPrintf("aux->window_title = '%s'\n", aux->window_title);
@@ -407,11 +691,341 @@ static void _GlxParseArgs(vrGlxPrivateInfo *aux, char *args)
 		aux->xsize_hints.x, aux->xsize_hints.y);
 	vrDbgPrintf("xsize_hints.flags = %d\n", aux->xsize_hints.flags);
 	vrDbgPrintf("aux->cursor_name = '%s'\n", aux->cursor_name);
+	vrDbgPrintf("aux->frames_in_flight = %d\n", aux->frames_in_flight);
+	vrDbgPrintf("aux->event_thread = %d\n", aux->event_thread);
+	vrDbgPrintf("aux->dynres = %d (%.2f - %.2f)\n", aux->dynres.enabled, aux->dynres.min_scale, aux->dynres.max_scale);
 	vrDbgPrintf("================================================\n");
 }
 
 
 
+/****************************************************************************/
+/* _GlxEventThread(): the body of a window's event thread.  It blocks on    */
+/*   its own X connection, and passes each event (along with the keysym of  */
+/*   key presses) to the render loop through a single-reader/single-writer  */
+/*   ring -- so neither side ever needs a lock.  The thread quits when the  */
+/*   close function sets "event_quit" and wakes it with a ClientMessage.    */
+static void *_GlxEventThread(void *data)
+{
+	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)data;
+	vrGlxQueuedEvent	*slot;
+	XEvent			event;
+	unsigned int		tail;
+
+	while (1) {
+		XNextEvent(aux->event_xdisplay, &event);
+
+		if (event.type == ClientMessage && event.xclient.message_type == aux->event_quit_atom && aux->event_quit)
+			break;
+
+		tail = aux->event_tail;
+		if (tail - aux->event_head >= GLX_EVENTQUEUESIZE) {
+			/* the render loop has fallen far behind -- drop the event */
+			if (aux->events_dropped++ == 0)
+				vrErrPrintf("_GlxEventThread(): " RED_TEXT "X event queue is full -- dropping events.\n" NORM_TEXT);
+			continue;
+		}
+
+		slot = &(aux->event_queue[tail % GLX_EVENTQUEUESIZE]);
+		slot->event = event;
+		if (event.type == KeyPress)
+			slot->keysym = XLookupKeysym((XKeyEvent *)&event, 0);
+		else	slot->keysym = NoSymbol;
+
+		/* the event must be complete before the render loop can see it */
+		vrMemoryBarrier();
+		aux->event_tail = tail + 1;
+	}
+
+	return NULL;
+}
+
+
+/****************************************************************************/
+/* _GlxEventThreadStart(): open a second X connection for the window, move  */
+/*   the selection of the window's events to it, and start the thread that  */
+/*   reads them.  On any failure, the events stay with the render loop.     */
+static void _GlxEventThreadStart(vrWindowInfo *window)
+{
+	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)window->aux_data;
+
+	aux->event_xdisplay = XOpenDisplay(aux->xdisplay_string);
+	if (aux->event_xdisplay == NULL) {
+		vrErrPrintf("_GlxEventThreadStart(): " RED_TEXT "unable to open an event connection to '%s' for window '%s' -- reading events in the render loop.\n" NORM_TEXT,
+			aux->xdisplay_string, window->name);
+		aux->event_thread = 0;
+		return;
+	}
+	XSelectInput(aux->event_xdisplay, aux->xwindow, aux->xwindow_attr.event_mask);
+	XSync(aux->event_xdisplay, False);
+
+	aux->event_quit_atom = XInternAtom(aux->xdisplay, "FREEVR_EVENT_THREAD_QUIT", False);
+	aux->event_quit = 0;
+	aux->event_head = 0;
+	aux->event_tail = 0;
+	if (pthread_create(&(aux->event_tid), NULL, _GlxEventThread, (void *)aux) != 0) {
+		vrErrPrintf("_GlxEventThreadStart(): " RED_TEXT "unable to create the event thread for window '%s' -- reading events in the render loop.\n" NORM_TEXT,
+			window->name);
+		XCloseDisplay(aux->event_xdisplay);
+		aux->event_xdisplay = NULL;
+		aux->event_thread = 0;
+		return;
+	}
+	aux->event_thread_running = 1;
+
+	/* the rendering connection no longer needs any events -- though */
+	/*   those already sent to it (eg. from the window manager as the */
+	/*   window was mapped) are still handled by the render loop.     */
+	XSelectInput(aux->xdisplay, aux->xwindow, NoEventMask);
+	XSync(aux->xdisplay, False);
+
+	vrDbgPrintfN(GLX_DBGLVL, "_GlxEventThreadStart(): X events of window '%s' are now read by the event thread.\n", window->name);
+}
+
+
+#ifdef GFX_OSG
+/****************************************************************************/
+/* _GlxOSGGraphLockInit(): make the scenegraph's reader/writer lock.  As the */
+/*   renders take it for reading over and over, a waiting writer is given   */
+/*   preference (where the pthreads library allows), so that the changes    */
+/*   of vrOSGBeginModifySceneGraph() aren't starved.                         */
+static void _GlxOSGGraphLockInit()
+{
+	pthread_rwlockattr_t	attr;
+
+	pthread_rwlockattr_init(&attr);
+#  if defined(__GLIBC__)
+	pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#  endif
+	pthread_rwlock_init(&osg_graph_lock, &attr);
+	pthread_rwlockattr_destroy(&attr);
+}
+
+
+/****************************************************************************/
+/* _GlxOSGCompileRoom(): returns the number of tiles that may be compiled   */
+/*   now -- such that the tiles ready to merge never outgrow what a single  */
+/*   frame's merge slice can take.  At least one tile is always allowed.    */
+static int _GlxOSGCompileRoom()
+{
+	int	allowed = 1;
+
+	if (osg_pager_tile_cost > 0.0 && osg_pager_merge_time / osg_pager_tile_cost > 1.0)
+		allowed = (int)(osg_pager_merge_time / osg_pager_tile_cost);
+
+	return (allowed - (int)osg_databasePager->getDataToMergeListSize());
+}
+
+
+/****************************************************************************/
+/* _GlxOSGContext: how a GLX context of FreeVR appears to OSG.  The pager's */
+/*   IncrementalCompileOperation compiles the GL objects of new tiles for   */
+/*   each osg::GraphicsContext it has been given, so each window gives it   */
+/*   one of these -- standing for either the window's own context, or the  */
+/*   context of its compile thread.  FreeVR makes the GLX context current  */
+/*   itself, so the operations OSG would use for that do nothing.          */
+class _GlxOSGContext : public osg::GraphicsContext {
+public:
+	_GlxOSGContext(osg::State *state) { setState(state); }
+
+	virtual osg::Object *cloneType() const { return NULL; }
+	virtual osg::Object *clone(const osg::CopyOp &) const { return NULL; }
+	virtual const char *libraryName() const { return "FreeVR"; }
+	virtual const char *className() const { return "_GlxOSGContext"; }
+
+	virtual bool valid() const { return true; }
+	virtual bool realizeImplementation() { return true; }
+	virtual bool isRealizedImplementation() const { return true; }
+	virtual void closeImplementation() { }
+	virtual bool makeCurrentImplementation() { return true; }
+	virtual bool makeContextCurrentImplementation(osg::GraphicsContext *) { return true; }
+	virtual bool releaseContextImplementation() { return true; }
+	virtual void bindPBufferToTextureImplementation(GLenum) { }
+	virtual void swapBuffersImplementation() { }
+};
+
+
+/****************************************************************************/
+/* _GlxOSGCompile(): compile (and delete) the GL objects of the pager's     */
+/*   tiles for a slice of time, in whatever context is current.  This only */
+/*   compiles when the tiles ready to merge have room for more.             */
+/* NOTE: the IncrementalCompileOperation gives half its time to compiling,  */
+/*   and half to deleting.  As the context is never cleared by OSG, it      */
+/*   always takes the minimum time -- which is the compile budget.          */
+static void _GlxOSGCompile(osg::GraphicsContext *gc)
+{
+	if (!osg_compile_op.valid() || osg_databasePager->getDataToCompileListSize() == 0 || _GlxOSGCompileRoom() <= 0)
+		return;
+
+	(*osg_compile_op)(gc);
+}
+
+
+#  ifdef GLX_OSG_COMPILE_THREAD
+/****************************************************************************/
+/* _GlxOSGCompileThread(): the body of a window's compile thread.  The GL   */
+/*   objects (textures, buffers & display lists) of newly loaded tiles are  */
+/*   made in a context that shares them with the window's context, so the  */
+/*   window's first draw of a tile doesn't stall on them.  The objects are  */
+/*   made under the window's OSG context ID, so they are the ones its draw  */
+/*   will then use.                                                         */
+static void *_GlxOSGCompileThread(void *data)
+{
+	vrWindowInfo		*window = (vrWindowInfo *)data;
+	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)window->aux_data;
+
+	glXMakeCurrent(aux->xdisplay, aux->compile_xwindow, aux->compile_context);
+
+	while (!aux->compile_quit) {
+		if (osg_databasePager->getDataToCompileListSize() == 0 || _GlxOSGCompileRoom() <= 0) {
+			vrSleep(1000);		/* 1 ms */
+			continue;
+		}
+
+		_GlxOSGCompile(aux->compile_gc.get());
+
+		/* the objects must be complete before the window can draw them */
+		glFinish();
+	}
+
+	glXMakeCurrent(aux->xdisplay, None, NULL);
+	return NULL;
+}
+
+
+/****************************************************************************/
+/* _GlxOSGCompileThreadStart(): make a small unmapped window, and a context */
+/*   that shares the window's GL objects, and start the thread that         */
+/*   compiles the pager's tiles in them.  Both are made on the window's own */
+/*   X connection, as GLX only shares objects between the contexts of one  */
+/*   connection (which is why vrGlxInitWindowInfo() calls XInitThreads()).  */
+/*   Returns 0 on any failure, in which case the tiles are compiled in the  */
+/*   render loop instead.                                                   */
+static int _GlxOSGCompileThreadStart(vrWindowInfo *window)
+{
+	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)window->aux_data;
+	XSetWindowAttributes	attributes;
+
+	attributes.colormap = aux->xcolormap;
+	attributes.border_pixel = 0;
+	aux->compile_xwindow = XCreateWindow(aux->xdisplay, RootWindow(aux->xdisplay, aux->xscreen),
+		0, 0, 1, 1, 0, aux->xvisual->depth, InputOutput, aux->xvisual->visual,
+		CWColormap | CWBorderPixel, &attributes);
+	aux->compile_context = glXCreateContext(aux->xdisplay, aux->xvisual, aux->glx_context, GL_TRUE);
+	if (aux->compile_context == NULL) {
+		vrErrPrintf("_GlxOSGCompileThreadStart(): " RED_TEXT "unable to create a shared context for window '%s' -- compiling in the render loop.\n" NORM_TEXT,
+			window->name);
+		XDestroyWindow(aux->xdisplay, aux->compile_xwindow);
+		return 0;
+	}
+
+	/* the compile thread's context has its own OSG state, but the same */
+	/*   context ID as the window, since the two share their objects.   */
+	aux->compile_gc = new _GlxOSGContext(new osg::State);
+	aux->compile_gc->getState()->setContextID(window->id);
+	aux->compile_gc->getState()->setFrameStamp(osg_framestamp.get());
+
+	aux->compile_quit = 0;
+	if (pthread_create(&(aux->compile_tid), NULL, _GlxOSGCompileThread, (void *)window) != 0) {
+		vrErrPrintf("_GlxOSGCompileThreadStart(): " RED_TEXT "unable to create the compile thread for window '%s' -- compiling in the render loop.\n" NORM_TEXT,
+			window->name);
+		aux->compile_gc = NULL;
+		glXDestroyContext(aux->xdisplay, aux->compile_context);
+		XDestroyWindow(aux->xdisplay, aux->compile_xwindow);
+		return 0;
+	}
+	aux->compile_thread_running = 1;
+
+	vrDbgPrintfN(GLX_DBGLVL, "_GlxOSGCompileThreadStart(): the pager's tiles of window '%s' are now compiled by the compile thread.\n", window->name);
+	return 1;
+}
+
+
+/****************************************************************************/
+/* _GlxOSGCompileThreadStop(): stop a window's compile thread -- it checks  */
+/*   the quit flag after each compile slice -- and free its X resources.    */
+static void _GlxOSGCompileThreadStop(vrWindowInfo *window)
+{
+	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)window->aux_data;
+
+	if (!aux->compile_thread_running)
+		return;
+
+	aux->compile_quit = 1;
+	pthread_join(aux->compile_tid, NULL);
+	glXDestroyContext(aux->xdisplay, aux->compile_context);
+	XDestroyWindow(aux->xdisplay, aux->compile_xwindow);
+	aux->compile_thread_running = 0;
+}
+#  endif /* GLX_OSG_COMPILE_THREAD */
+
+
+/****************************************************************************/
+/* _GlxOSGCompileSetup(): give the pager an IncrementalCompileOperation (the */
+/*   first time), and give that a context of this window in which to compile */
+/*   the tiles -- that of a compile thread when one can be started, else   */
+/*   the window's own (with the SceneView's state, as the two must agree on */
+/*   what GL state is current).                                             */
+static void _GlxOSGCompileSetup(vrWindowInfo *window)
+{
+	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)window->aux_data;
+
+	pthread_mutex_lock(&osg_frame_lock);
+	if (!osg_compile_op.valid()) {
+		osg_compile_op = new osgUtil::IncrementalCompileOperation;
+		osg_compile_op->setMinimumTimeAvailableForGLCompileAndDeletePerFrame(osg_pager_compile_time);
+		osg_databasePager->setIncrementalCompileOperation(osg_compile_op.get());
+	}
+	pthread_mutex_unlock(&osg_frame_lock);
+
+#  ifdef GLX_OSG_COMPILE_THREAD
+	if (!_GlxOSGCompileThreadStart(window))
+#  endif
+		aux->compile_gc = new _GlxOSGContext(aux->sceneview->getState());
+
+	osg_compile_op->addGraphicsContext(aux->compile_gc.get());
+}
+#endif /* GFX_OSG */
+
+
+/****************************************************************************/
+/* _GlxNextEvent(): get the next X event for the render loop, if any.  With */
+/*   an event thread this is just a check of the event queue, otherwise the */
+/*   rendering X connection is polled as it always was.                     */
+static int _GlxNextEvent(vrGlxPrivateInfo *aux, XEvent *event, KeySym *keysym)
+{
+	vrGlxQueuedEvent	*slot;
+	unsigned int		head;
+
+	/* NOTE: XQLength() only checks events already read, so no syscall */
+	if (!aux->event_thread_running || XQLength(aux->xdisplay) > 0) {
+		if (!XPending(aux->xdisplay))
+			return 0;
+		XNextEvent(aux->xdisplay, event);
+		if (event->type == KeyPress)
+			*keysym = XLookupKeysym((XKeyEvent *)event, 0);
+		else	*keysym = NoSymbol;
+		return 1;
+	}
+
+	head = aux->event_head;
+	if (head == aux->event_tail)
+		return 0;
+
+	/* don't read the slot before seeing the new tail */
+	vrMemoryBarrier();
+	slot = &(aux->event_queue[head % GLX_EVENTQUEUESIZE]);
+	*event = slot->event;
+	*keysym = slot->keysym;
+
+	/* and don't release the slot until it has been read */
+	vrMemoryBarrier();
+	aux->event_head = head + 1;
+
+	return 1;
+}
+
+
 #ifndef GFX_PERFORMER /* This is used by GLX, but not Performer. */
 /*****************************************************************/
 /* vrWaitForWindowMapping(): used by _GlxOpenFunc() to wait for  */
@@ -439,6 +1053,7 @@ static void _GlxOpenFunc(vrWindowInfo *window)
 static	char		trace_msg[256];
 	vrGlxPrivateInfo *aux = NULL;
 	char		xdisplay_name[64];
+	char		*str;
 	unsigned long	winattr_mask = 0;	/* the window attributes that have been set in the attribute structure */
 	Atom		mwm_hints_atom;		/* used for hinting at the decorations to the WM */
 	Pixmap		icon_pixmap;		/* An X11 pixmap for creating an icon -- TODO: how to make this thread safe? */
@@ -471,6 +1086,11 @@ static	char		trace_msg[256];
 	aux->xsize_hints.y = 10;		/*   of the overall window structure, and would be  */
 	aux->xsize_hints.width = 200;		/*   given initial values in vr_visren.c.           */
 	aux->xsize_hints.height = 200;
+	aux->frames_in_flight = 0;		/* wait for the GPU at each swap */
+	aux->event_thread = 0;			/* read the X events in the render loop */
+	vrDynresInit(&(aux->dynres));		/* render at the window's full resolution */
+	vrCaptureInit(&(aux->capture));		/* not capturing */
+	vrGpuTimerInit(&(aux->gputimer));	/* not measuring the GPU */
 
 	if (window->mount == VRWINDOW_SIMULATOR)
 		aux->cursor_name = vrShmemStrDup("default");	/* the simulator default cursor */
@@ -482,6 +1102,15 @@ static	char		trace_msg[256];
 	/* parse the arguments to override defaults            */
 	/*   this will fill in aux->xserver, aux->xscreen, etc. */
 	_GlxParseArgs(aux, window->args);
+	vrCaptureParseArgs(window, window->args);	/* "capture=" is kept in the window */
+	vrGpuTimerParseArgs(window, window->args);	/* so is "gpuTimer=" */
+	if (window->args != NULL && (str = strstr(window->args, "swapTiming=")))
+		window->swap_timing = atoi(strchr(str, '=') + 1);	/* and "swapTiming=" */
+	aux->oml_status = 0;				/* checked at the first timed swap */
+	aux->swap_sbc = 0;
+	aux->msc_period = 0.0;
+	aux->swaps_timed = 0;
+	aux->photon_mean = 0.0;
 	vrTrace("_GlxOpenFunc", "Arguments parsed");
 	vrDbgPrintfN(GLX_DBGLVL, "_GlxOpenFunc(): %s", "Arguments parsed");
 
@@ -812,6 +1441,10 @@ vrPrintf("sizeof mwm_hints = %d, sizeof mwm_hints.flags = %d\n", sizeof(aux->mwm
 	XIfEvent(aux->xdisplay, &event, vrWaitForWindowMapping, (XPointer)aux->xwindow);
 	aux->mapped = 1;
 
+	/* from here on, the window's events can be read off the render path */
+	if (aux->event_thread)
+		_GlxEventThreadStart(window);
+
 
 	/***************************************************/
 	/*** Configure this OpenGL context for rendering ***/
@@ -820,14 +1453,20 @@ vrPrintf("sizeof mwm_hints = %d, sizeof mwm_hints.flags = %d\n", sizeof(aux->mwm
 	vrTrace("_GlxOpenFunc", "about to make GLX calls");
 
 	glXMakeCurrent(aux->xdisplay, aux->xwindow, aux->glx_context);
+	vrShapeGLContextInit(_GlxGetProcAddress);
 
 #ifdef GFX_OSG
 	/* TODO: make sure this is the proper location for this code */
 
 	/* Allocate and setup a  osgUtil::SceneView for each rendering context */
 	/* ***************** THIS MUST BE DONE AFTER THE CONTEXT IS CURRENT ***************** */
-	aux->frame_num = 0;						/* Initialize frame count */
-	aux->start_tick = osg::Timer::instance()->tick();		/* We need the approximate time of the start of the first frame */
+	pthread_once(&osg_graph_lock_once, _GlxOSGGraphLockInit);
+	pthread_mutex_lock(&osg_frame_lock);
+	if (!osg_framestamp.valid()) {
+		osg_framestamp = new osg::FrameStamp;
+		osg_start_tick = osg::Timer::instance()->tick();	/* We need the approximate time of the start of the first frame */
+	}
+	pthread_mutex_unlock(&osg_frame_lock);
 
 	vrTrace("_GlxOpenFunc-OSG", "Just created osg-lock");
 	aux->sceneview = new osgUtil::SceneView;
@@ -838,13 +1477,23 @@ vrPrintf("sizeof mwm_hints = %d, sizeof mwm_hints.flags = %d\n", sizeof(aux->mwm
 	aux->sceneview->getState()->setContextID(window->id);		/* Needed for OpenGL "objects" e.g. textures */
 	vrTrace("_GlxOpenFunc-OSG", "done initializing OSG");
 
-	/* Setup database pager if it's been initialized */
-	if (osg_databasePager.valid())
+	/* Setup database pager if it's been initialized -- the GL objects */
+	/*   of its tiles are compiled before they are merged, either by a */
+	/*   compile thread, or a slice at a time after each draw.         */
+	if (osg_databasePager.valid()) {
 		((vrGlxPrivateInfo *)aux)->sceneview->getCullVisitor()->setDatabaseRequestHandler(osg_databasePager.get());
+		_GlxOSGCompileSetup(window);
+	}
 
 	vrDbgPrintfN(GLX_DBGLVL, "_GlxOpenFunc(): OSG Info: Window: %d SceneView: %p\n", window->id, ((vrGlxPrivateInfo *)aux)->sceneview.get());
 #endif
 
+	/* the swap fences require sync objects (OpenGL 3.2 or GL_ARB_sync) */
+	if (aux->frames_in_flight > 0 && !_GlxLoadSyncFuncs()) {
+		vrErrPrintf("_GlxOpenFunc(): " RED_TEXT "sync objects are not available for window '%s' -- ignoring framesInFlight.\n" NORM_TEXT, window->name);
+		aux->frames_in_flight = 0;
+	}
+
 	glEnable(GL_DEPTH_TEST);
 
 	glMatrixMode(GL_PROJECTION);
@@ -887,6 +1536,64 @@ vrPrintf("sizeof mwm_hints = %d, sizeof mwm_hints.flags = %d\n", sizeof(aux->mwm
 static void _GlxCloseFunc(vrWindowInfo *window)
 {
 	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)(window->aux_data);
+	XEvent			quit_event;
+	int			count;
+
+	/* stop the event thread -- it's waiting inside XNextEvent(), so wake */
+	/*   it with a ClientMessage.  The message is sent (from the render   */
+	/*   connection) to the clients selecting the window's events, which  */
+	/*   is now only the event thread's connection.                       */
+	if (aux->event_thread_running) {
+		aux->event_quit = 1;
+		vrMemoryBarrier();
+
+		memset(&quit_event, 0, sizeof(quit_event));
+		quit_event.xclient.type = ClientMessage;
+		quit_event.xclient.window = aux->xwindow;
+		quit_event.xclient.message_type = aux->event_quit_atom;
+		quit_event.xclient.format = 32;
+		XSendEvent(aux->xdisplay, aux->xwindow, False, aux->xwindow_attr.event_mask, &quit_event);
+		XFlush(aux->xdisplay);
+
+		pthread_join(aux->event_tid, NULL);
+		XCloseDisplay(aux->event_xdisplay);
+		aux->event_thread_running = 0;
+	}
+
+#ifdef GFX_OSG
+#  ifdef GLX_OSG_COMPILE_THREAD
+	_GlxOSGCompileThreadStop(window);
+#  endif
+	if (aux->compile_gc.valid()) {
+		osg_compile_op->removeGraphicsContext(aux->compile_gc.get());
+		aux->compile_gc = NULL;
+	}
+#endif
+
+	/* finish writing any capture or export in progress, and */
+	/*   free the GPU timer queries                          */
+	if (aux->capture.buffers || aux->gputimer.active) {
+		glXMakeCurrent(aux->xdisplay, aux->xwindow, aux->glx_context);
+		vrCaptureStop(&(aux->capture));
+		vrGpuTimerStop(&(aux->gputimer));
+	}
+
+	/* delete the fences of the swaps still in flight */
+	if (aux->frames_in_flight > 0 && aux->glx_context != NULL) {
+		glXMakeCurrent(aux->xdisplay, aux->xwindow, aux->glx_context);
+		for (count = 0; count <= GLX_MAXFRAMESINFLIGHT; count++) {
+			if (aux->swap_fences[count] != NULL) {
+				glDeleteSync_func((GLsync)aux->swap_fences[count]);
+				aux->swap_fences[count] = NULL;
+			}
+		}
+	}
+
+	/* delete the buffers of the basic shapes in this context */
+	if (aux->glx_context != NULL) {
+		glXMakeCurrent(aux->xdisplay, aux->xwindow, aux->glx_context);
+		vrShapeGLContextRelease();
+	}
 
 	/* TODO: should we also free memory of the things aux points to? */
 	vrShmemFree(aux);
@@ -922,16 +1629,81 @@ static void _GlxSwapFunc(vrWindowInfo *info)
 		return;
 
 	glXMakeCurrent(aux->xdisplay, aux->xwindow, aux->glx_context);
-	if (aux->doub_buf) {
-		glXSwapBuffers(aux->xdisplay, aux->xwindow);
+
+	/* measure the display of the last swap, before making the next */
+	if (info->swap_timing && aux->doub_buf) {
+		if (aux->oml_status == 0)
+			_GlxSwapTimingInit(info, aux);
+		_GlxSwapTimingCollect(info, aux);
+	} else if (!info->swap_timing) {
+		aux->oml_status = 0;		/* ie. check again when turned back on */
+	}
+
+	vrGpuTimerSwapBegin(&(aux->gputimer), info, _GlxGetProcAddress);
+	vrCaptureFrame(&(aux->capture), info, _GlxGetProcAddress);
+	if (aux->doub_buf && aux->frames_in_flight > 0) {
+		/* Place a fence after the swap, and leave the waiting */
+		/*   for _GlxSwapWaitFunc() -- after all the windows    */
+		/*   have been swapped.                                 */
+		_GlxSwapBuffers(info, aux);
+		aux->swap_fences[aux->swap_fence_next] = (void *)glFenceSync_func(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		aux->swap_fence_next = (aux->swap_fence_next + 1) % (aux->frames_in_flight + 1);
+		glFlush();		/* make sure the fence is sent to the GPU */
+	} else if (aux->doub_buf) {
+		_GlxSwapBuffers(info, aux);
 #if 1
 		glXWaitGL();
 #elif 1
 		glFinish();
 #endif
+		aux->done_sbc = aux->swap_sbc;
+		aux->done_wtime = vrCurrentWallTime();
 	} else {
 		glFlush();
 	}
+	vrGpuTimerSwapEnd(&(aux->gputimer), info);
+}
+
+
+/****************************************************************************/
+/* _GlxSwapWaitFunc(): wait for the oldest frame still pending on the GPU,   */
+/*   such that no more than "framesInFlight" swapped frames are pending.    */
+/*   The time spent waiting is added to the process' "fence-wait" value.    */
+static void _GlxSwapWaitFunc(vrWindowInfo *info)
+{
+	vrGlxPrivateInfo	*aux = (vrGlxPrivateInfo *)(info->aux_data);
+	GLsync			fence;
+	GLenum			result;
+	vrTime			start_wtime;
+
+	if (!aux->mapped || aux->frames_in_flight <= 0)
+		return;
+
+	/* the slot of the next fence holds the oldest one */
+	fence = (GLsync)aux->swap_fences[aux->swap_fence_next];
+	if (fence == NULL)
+		return;
+
+	glXMakeCurrent(aux->xdisplay, aux->xwindow, aux->glx_context);
+	start_wtime = vrCurrentWallTime();
+	do {
+		/* NOTE: the fence was flushed when placed, so no flush bit is needed */
+		result = glClientWaitSync_func(fence, 0, 1000000000);	/* 1 second */
+		if (result == GL_TIMEOUT_EXPIRED)
+			vrDbgPrintfN(GLX_DBGLVL, "_GlxSwapWaitFunc(): still waiting for the GPU on window '%s'\n", info->name);
+	} while (result == GL_TIMEOUT_EXPIRED);
+	if (result == GL_WAIT_FAILED)
+		vrErrPrintf("_GlxSwapWaitFunc(): " RED_TEXT "wait on swap fence failed for window '%s'.\n" NORM_TEXT, info->name);
+
+	glDeleteSync_func(fence);
+	aux->swap_fences[aux->swap_fence_next] = NULL;
+
+	/* the fence was placed framesInFlight swaps ago (for the swap timing estimate) */
+	aux->done_sbc = aux->swap_sbc - aux->frames_in_flight;
+	aux->done_wtime = vrCurrentWallTime();
+
+	/* measure: time spent waiting for the GPU */
+	vrWindowStatsValue(info, VR_VALUE_FENCEWAIT, (vrCurrentWallTime() - start_wtime) * 1000.0);
 }
 
 
@@ -1027,6 +1799,77 @@ static void _GlxSetProjectionTransform(vrPerspData *pd)
 }
 
 
+#ifdef GFX_OSG
+/****************************************************************************/
+/* _GlxOSGFrameUpdate(): makes the once-per-frame changes to the scenegraph */
+/*   -- advancing the shared frame stamp, merging in what the database      */
+/*   pager has loaded, and calling the application's update callback.  The  */
+/*   first window (or render thread) of the frame to get here does this,    */
+/*   while any others wait for it to finish.                                */
+/****************************************************************************/
+static void _GlxOSGFrameUpdate(vrRenderInfo *renderinfo)
+{
+	pthread_mutex_lock(&osg_frame_lock);
+	if (osg_frame_count != renderinfo->frame_count) {
+		/* with the graph locked for writing, no cull is in progress */
+		pthread_rwlock_wrlock(&osg_graph_lock);
+
+		if (osg_frame_count >= 0 && osg_databasePager.valid())
+			osg_databasePager->signalEndFrame();
+
+		osg_framestamp->setReferenceTime(osg::Timer::instance()->delta_s(osg_start_tick, osg::Timer::instance()->tick()));
+		osg_framestamp->setFrameNumber(renderinfo->frame_count);
+
+		if (osg_databasePager.valid()) {
+			vrProcessStats	*stats = renderinfo->window->proc->stats;
+			double		slice = osg_pager_merge_time;
+			int		ready;
+			int		merged = 0;
+
+			osg_databasePager->signalBeginFrame(osg_framestamp.get());
+
+			/* a frame already predicted to go over its budget gets a smaller slice */
+			if (renderinfo->frame_budget > 0.0 && renderinfo->frame_headroom < slice)
+				slice = (renderinfo->frame_headroom > 0.0 ? renderinfo->frame_headroom : 0.0);
+
+			/* NOTE: the expired tiles are also removed in updateSceneGraph(), */
+			/*   so it is still called when nothing is ready to be merged.    */
+			ready = osg_databasePager->getDataToMergeListSize();
+			if (ready == 0 || ready * osg_pager_tile_cost <= slice || osg_pager_deferred >= GLX_OSG_MAXMERGEDEFER) {
+				vrTime	merge_wtime = vrCurrentWallTime();
+
+				osg_databasePager->updateSceneGraph(*osg_framestamp);
+
+				if (ready > 0) {
+					double	tile_cost = (vrCurrentWallTime() - merge_wtime) / ready;
+
+					if (osg_pager_tile_cost == 0.0)
+						osg_pager_tile_cost = tile_cost;
+					else	osg_pager_tile_cost = 0.8 * osg_pager_tile_cost + 0.2 * tile_cost;
+					merged = ready;
+				}
+				osg_pager_deferred = 0;
+			} else {
+				osg_pager_deferred++;
+			}
+
+			/* measure: the state of the pager's queues */
+			vrProcessStatsValue(stats, VR_VALUE_PAGERREQUESTS, osg_databasePager->getFileRequestListSize(), 0);
+			vrProcessStatsValue(stats, VR_VALUE_PAGERMERGED, merged, 0);
+			vrProcessStatsValue(stats, VR_VALUE_PAGERWAITING, osg_databasePager->getDataToCompileListSize() + osg_databasePager->getDataToMergeListSize(), 0);
+		}
+
+		if (osg_update_callback != NULL)
+			vrCallbackInvokeDynamic(osg_update_callback, 1, osg_scenedata.get());
+
+		osg_frame_count = renderinfo->frame_count;
+		pthread_rwlock_unlock(&osg_graph_lock);
+	}
+	pthread_mutex_unlock(&osg_frame_lock);
+}
+#endif
+
+
 /* The render function */
 /****************************************************************************/
 static void _GlxRenderFunc(vrRenderInfo *renderinfo)
@@ -1041,6 +1884,7 @@ static	char		trace_msg[2048];
 	vrGlxPrivateInfo *aux = (vrGlxPrivateInfo *)curr_window->aux_data;
 	vrCallback	*callback = NULL;
 	XEvent		event;
+	KeySym		keysym;			/* the keysym of KeyPress events */
 	int		count;
 	int		twod_ortho_mode = 0;	/* set to one when rendering in 2D */
 
@@ -1062,8 +1906,8 @@ static	char		trace_msg[2048];
 
 	/****************************/
 	/* get x events, if any ... */
-	while (XPending(aux->xdisplay)) {
-		XNextEvent(aux->xdisplay, &event);
+	/*   (with an event thread, this only checks the event queue) */
+	while (_GlxNextEvent(aux, &event, &keysym)) {
 
 		switch (event.type) {
 
@@ -1109,13 +1953,13 @@ static	char		trace_msg[2048];
 
 		case KeyPress: {
 			/* TODO: this keysym lookup code should take into account the current modifier states */
-			KeySym	key = XLookupKeysym((XKeyEvent *)&event, 0);
+			KeySym	key = keysym;
 			int	key_used_by_sim = 1;
 
 #if 0 /* print each keypress received for debugging */
-vrPrintf("_GlxRenderFunc(): Got a key press of type %X\n", XLookupKeysym((XKeyEvent *)&event, 0));
+vrPrintf("_GlxRenderFunc(): Got a key press of type %X\n", key);
 #endif
-			vrDbgPrintfN(XWIN_DBGLVL, "_GlxRenderFunc(): Got a key press of type %X\n", XLookupKeysym((XKeyEvent *)&event, 0));
+			vrDbgPrintfN(XWIN_DBGLVL, "_GlxRenderFunc(): Got a key press of type %X\n", key);
 
 			if (curr_window->mount == VRWINDOW_SIMULATOR) {
 				switch (key) {
@@ -1282,7 +2126,7 @@ vrPrintf("_GlxRenderFunc(): Got a key press of type %X\n", XLookupKeysym((XKeyEv
 
 			default:
 				if (!key_used_by_sim)
-					vrDbgPrintfN(INPUT_DBGLVL, "_GlxRenderFunc(): Got an unused key press of type %X\n", XLookupKeysym((XKeyEvent *)&event, 0));
+					vrDbgPrintfN(INPUT_DBGLVL, "_GlxRenderFunc(): Got an unused key press of type %X\n", key);
 				break;
 			}
 		}	break;
@@ -1346,6 +2190,9 @@ vrPrintf("_GlxRenderFunc(): " RED_TEXT "Calling VisrenInit callback for window '
 	}
 #endif
 
+	/* measure: the GPU time of this eye (when the window's gpu_timer is set) */
+	vrGpuTimerEyeBegin(&(aux->gputimer));
+
 
 	/*****************************/
 	/* (i) push gfx matrix/state */
@@ -1361,7 +2208,18 @@ vrPrintf("_GlxRenderFunc(): " RED_TEXT "Calling VisrenInit callback for window '
 	vrTrace("_GlxRenderFunc", "(ii) handle viewport");
 
 	/* set the buffer into which we should render (based on the eye) */
-	switch (curr_eye->render_framebuffer) {
+	/*   -- except with single-pass stereo, where the world callback */
+	/*   sets the viewport of each eye itself, so the whole window   */
+	/*   is made available.                                          */
+	if (renderinfo->stereo != NULL) {
+		/* NOTE: the viewports may have changed with a ConfigureNotify event */
+		renderinfo->stereo->viewport[VR_STEREO_LEFT] = curr_window->viewport_left;
+		renderinfo->stereo->viewport[VR_STEREO_RIGHT] = curr_window->viewport_right;
+		glDrawBuffer(GL_BACK);
+		buffer_name = "GL_BACK";
+		glViewport(0, 0, curr_window->geometry.width, curr_window->geometry.height);
+		glScissor(0, 0, curr_window->geometry.width, curr_window->geometry.height);
+	} else switch (curr_eye->render_framebuffer) {
 	default:
 		/* Really, we shouldn't need to rely on the default, so print a warning message and continue. */
 		vrMsgPrintf("By default rendering to the Back buffer\n");
@@ -1389,6 +2247,7 @@ vrPrintf("_GlxRenderFunc(): " RED_TEXT "Calling VisrenInit callback for window '
 			sprintf(trace_msg, "premature ending window render loop for window '%s' %#p -- non-existant stereo buffer", curr_window->name, curr_window);
 			vrTrace("_GlxRenderFunc", trace_msg);
 
+			vrGpuTimerEyeEnd(&(aux->gputimer));
 			return;
 		}
 		break;
@@ -1434,6 +2293,11 @@ vrPrintf("_GlxRenderFunc(): " RED_TEXT "Calling VisrenInit callback for window '
     }
 #endif
 
+#ifndef GFX_OSG
+	/* with dynamic resolution, the world goes to the offscreen framebuffer */
+	vrDynresBegin(&(aux->dynres), renderinfo, _GlxGetProcAddress);
+#endif
+
 
 	/******************************/
 	/* (iii) handle color masking */
@@ -1607,28 +2471,17 @@ printf("YO: default case, color = %d\n", curr_eye->color);
 		eyeMat.preMult(transMat);
 		aux->sceneview->setViewMatrix(eyeMat);
 
-		/* We don't want this but apparently OSG changes stuff during it's READ-ONLY cull traversal!? */
-		/* This prevents random segfaults when OSG is changing the scene graph                        */
-		/* TODO: Find which nodes or parts of OSG are changing during cull traversal */
-		osg::ref_ptr<osg::FrameStamp> frameStamp = new osg::FrameStamp;
-		frameStamp->setReferenceTime(osg::Timer::instance()->delta_s(aux->start_tick, osg::Timer::instance()->tick()));
-		frameStamp->setFrameNumber(aux->frame_num++);
-		aux->sceneview->setFrameStamp(frameStamp.get());
-
-		if (osg_databasePager.valid())
-			osg_databasePager->signalBeginFrame(frameStamp.get());
-
-		vrLockWriteSet(osg_sg_lock);
-		aux->sceneview->setSceneData(osg_scenedata.get());
-		if (osg_databasePager.valid())
-			osg_databasePager->updateSceneGraph(frameStamp->getReferenceTime());
-#if 0
-		aux->sceneview->update();
-#endif
-		vrLockWriteRelease(osg_sg_lock);
-
-		if (osg_databasePager.valid())
-			osg_databasePager->signalEndFrame();
+		/* The pager's changes (and the update callback's) are made once per  */
+		/*   frame, by the first window to get here.  All the eyes of the     */
+		/*   frame then share its frame stamp.  The graph is locked for        */
+		/*   reading through the cull and draw, so that the application can't */
+		/*   change it (with vrOSGBeginModifySceneGraph()) in the middle.     */
+		/* NOTE: the lock must not be held while calling _GlxOSGFrameUpdate(). */
+		_GlxOSGFrameUpdate(renderinfo);
+		pthread_rwlock_rdlock(&osg_graph_lock);
+		aux->sceneview->setFrameStamp(osg_framestamp.get());
+		if (aux->sceneview->getSceneData() != osg_scenedata.get())
+			aux->sceneview->setSceneData(osg_scenedata.get());
 #if 0
 		printf("Near: %lf Far: %lf\n", 
 			aux->sceneview->getCullVisitor()->getCalculatedNearPlane(), 
@@ -1636,10 +2489,13 @@ printf("YO: default case, color = %d\n", curr_eye->color);
 #endif
 
 		/* Render scene */
-		vrLockReadSet(osg_sg_lock);
 		aux->sceneview->cull();
 		aux->sceneview->draw();
-		vrLockReadRelease(osg_sg_lock);
+		pthread_rwlock_unlock(&osg_graph_lock);
+
+		/* without a compile thread, the pager's tiles are compiled here */
+		if (aux->compile_gc.valid() && !aux->compile_thread_running)
+			_GlxOSGCompile(aux->compile_gc.get());
 
 		/* Restore our original (pre-osg) GL state */
 		glMatrixMode(GL_TEXTURE);
@@ -1717,7 +2573,10 @@ printf("YO: default case, color = %d\n", curr_eye->color);
 	vrTrace("_GlxRenderFunc", "(vi) render the world");
 
 	/* set the world rendering callback.  Start with the user's callback because that takes precedence. */
-	callback = curr_user->VisrenWorld;
+	/*   (A single-pass stereo frame is rendered by the stereo callback.) */
+	if (renderinfo->stereo != NULL)
+		callback = curr_window->VisrenWorldStereo;
+	else	callback = curr_user->VisrenWorld;
 	if (!callback)
 		callback = curr_window->VisrenWorld;
 	if (!callback) {
@@ -1765,8 +2624,15 @@ printf("YO: default case, color = %d\n", curr_eye->color);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
        }
 
+#ifndef GFX_OSG
+	/* upscale the world into the window (when rendered offscreen) */
+	vrDynresEnd(&(aux->dynres), renderinfo);
+#endif
+
 	/* measure: time just spent in rendering each eye (not counting the simulator and information displays) */
-	vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDER1, 1);
+	/*   (but not from a render thread -- only the process itself makes the marks) */
+	if (!curr_window->render_thread)
+		vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDER1, 1);
 
 	/*****************************************************/
 	/* (vii) call simulator_render (if simulator window) */
@@ -1797,17 +2663,14 @@ printf("YO: default case, color = %d\n", curr_eye->color);
 	/*** render the timing statistics as a bar-graph ***/
       if (curr_window->stats_show) {
 	for (count = 0; count < VR_MAXSTATS; count++) {
-		if (curr_window->stats[count] != NULL && *curr_window->stats[count] != NULL && (*(curr_window->stats[count]))->show_flag) {
+		if (curr_window->stats[count] != NULL && *curr_window->stats[count] != NULL && (*(curr_window->stats[count]))->show_flag
+		    && ((*(curr_window->stats[count]))->window_name == NULL || !strcmp((*(curr_window->stats[count]))->window_name, curr_window->name))) {
 			vrProcessStats	*stats = *(curr_window->stats[count]);
 			double		char_height = 13;		/* empirically determined height of characters in pixels */
 			double		char_width = 6.05;		/* empirically determined width of characters in pixels */
-			double		scale = stats->time_scale * 2.0;
 			double		text_scale = (char_height / curr_window->geometry.height);
 			double		bottom = stats->yloc;			/* y location of bottom of chart */
-			double		top =    bottom+(scale*stats->top_time);/* y location of top of chart */
-			float		bar_width;
 			double		y;
-			int		frame;					/* for counting through the frames */
 			int		segment;				/* for counting through the elements */
 
 			/* if not currently rendering in 2D-ortho mode, then do so */
@@ -1838,89 +2701,10 @@ printf("YO: default case, color = %d\n", curr_eye->color);
 				twod_ortho_mode = 1;
 			}
 
-			/* draw a semi-transparent background to help contrast */
+			/* draw the backdrops, time lines and bars in one batch */
 			glEnable(GL_BLEND);
 			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);/* also works with GL_ONE as arg2 */
-
-			glColor4fv(stats->back_color);			/* usually semi-transparent */
-			glBegin(GL_POLYGON);
-				glVertex2d(0.00, bottom);
-				glVertex2d(0.00, top);
-				glVertex2d(1.00, top);
-				glVertex2d(1.00, bottom);
-			glEnd();
-
-			/* draw some horizontal lines to mark time */
-			glShadeModel(GL_FLAT);
-			glLineWidth(1.0);
-			glColor3ub(0, 0, 0);		/* black */
-			for (y = bottom; y <= top; y += stats->hline_interval * scale) {
-				glBegin(GL_LINE_STRIP);
-					glVertex2d(0.0, y);
-					glVertex2d(1.0, y);
-				glEnd();
-			}
-
-			/* draw the statistics as a bar graph */
-			bar_width = (curr_window->geometry.width/stats->frames) * 0.80;
-			glLineWidth(bar_width);
-			for (frame = 0; frame < stats->frames; frame++) {
-				int	first_element = stats->elements * frame;
-				double	yloc = bottom;
-#if 1 /* set to 0 for xloc that produces a heart-rate (oscilloscope) style display */
-				double	xloc = (((frame-stats->time_frame)+(stats->frames-1)) % stats->frames)/(double)stats->frames + 0.005;
-#else
-				double	xloc = (double)frame/stats->frames + 0.005;
-#endif
-				for (segment = 0; segment < stats->elements; segment++) {
-
-#if 0
-vrPrintf("showmask = %x, compared with %x (segment %d)\n", stats->show_mask, (1 << segment), segment);
-#endif
-					if (stats->show_mask & (1 << segment)) {
-						glBegin(GL_LINE_STRIP);
-							glVertex2d(xloc, yloc);
-
-#if 0
-							switch (segment) {
-							case 0:	glColor3ub(240,  50,  50); break;	/* red */
-							case 1:	glColor3ub(240, 240, 240); break;	/* white */
-							case 2:	glColor3ub( 50, 240, 240); break;	/* cyan */
-							case 3:	glColor3ub(100,   0, 255); break;	/* dark purple */
-							case 4: glColor3ub(  0, 255,   0); break;	/* green */
-							case 5: glColor3ub(191, 121,   0); break;	/* dark yellow */
-							case 6: glColor3ub(240, 138, 133); break;	/* rose */
-							case 7: glColor3ub(240, 130,  30); break;	/* orange */
-							}
-#else
-							glColor4fv(stats->elem_colors[segment]);
-#endif
-							yloc += scale * stats->measures[first_element+segment];
-							glVertex2d(xloc, yloc);
-						glEnd();
-					}
-				}
-			}
-
-			/* redraw lines over the bars in semi-transparent color */
-			glLineWidth(1.0);
-			glColor4ub(0, 0, 0, 64);		/* semi-transparent black */
-			for (y = bottom; y <= top; y += stats->hline_interval * scale) {
-				glBegin(GL_LINE_STRIP);
-					glVertex2d(0.0, y);
-					glVertex2d(1.0, y);
-				glEnd();
-			}
-
-
-			/* draw semi-transparent backdrop specifically for the element labels */
-			glColor4fv(stats->back_color);			/* usually semi-transparent */
-			glBegin(GL_POLYGON);
-				glVertex2d(0.03, bottom + (2.0 * text_scale));
-				glVertex2d(0.03, bottom + (2.6 * text_scale) + (stats->elements * text_scale * 0.95));
-				glVertex2d(0.05 + (8 * text_scale), bottom + (2.6 * text_scale) + (stats->elements * text_scale * 0.95));
-				glVertex2d(0.05 + (8 * text_scale), bottom + (2.0 * text_scale));
-			glEnd();
+			vrGLRenderStatsChart(stats, curr_window->geometry.width, curr_window->geometry.height);
 
 			/* draw the element labels */
 			y = bottom + (2.2 * text_scale);
@@ -1932,15 +2716,6 @@ vrPrintf("showmask = %x, compared with %x (segment %d)\n", stats->show_mask, (1
 			}
 
 
-			/* draw semi-transparent backdrop specifically for the overall label */
-			glColor4fv(stats->back_color);			/* usually semi-transparent */
-			glBegin(GL_POLYGON);
-				glVertex2d(0.005, bottom + (0.80 * text_scale));
-				glVertex2d(0.005, bottom + (1.95 * text_scale));
-				glVertex2d(0.060, bottom + (1.95 * text_scale));
-				glVertex2d(0.060, bottom + (0.80 * text_scale));
-			glEnd();
-
 			/* draw the overall stats label */
 			glColor4fv(stats->label_color);
 			glRasterPos2f(0.01, bottom + (text_scale /*0.005*/ /*  * scale */));
@@ -2255,7 +3030,9 @@ static		char	ui_string_tok[2048];
 	}
 
 	/* measure: time just spent in rendering the simulator and information displays */
-	vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDERINFO, 1);
+	/*   (but not from a render thread -- only the process itself makes the marks) */
+	if (!curr_window->render_thread)
+		vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDERINFO, 1);
 
 
 	/**************************************/
@@ -2266,6 +3043,8 @@ static		char	ui_string_tok[2048];
 	/* (ix) restore gfx matrix/state */
 	glPopMatrix(); /* } */
 
+	vrGpuTimerEyeEnd(&(aux->gputimer));
+
 	sprintf(trace_msg, "ending window render loop for window '%s' %#p", curr_window->name, curr_window);
 	vrTrace("_GlxRenderFunc", trace_msg);
 }
@@ -2339,7 +3118,10 @@ static void _GlxRenderText(vrRenderInfo *renderinfo, char *string)
 /****************************************************************************/
 void vrOSGSetSceneData(osg::Node *sd)
 {
+	pthread_once(&osg_graph_lock_once, _GlxOSGGraphLockInit);
+	pthread_rwlock_wrlock(&osg_graph_lock);
 	osg_scenedata = sd;
+	pthread_rwlock_unlock(&osg_graph_lock);
 	printf("Setting scene Data!\n");
 }
 
@@ -2349,16 +3131,54 @@ void vrOSGSetDatabasePager (osgDB::DatabasePager *pager)
 	osg_databasePager = pager;
 }
 
+/****************************************************************************/
+/* vrOSGSetUpdateCallback(): Set the function that makes the application's  */
+/*   changes to the scenegraph.  It is called (with the scene data as its   */
+/*   argument) once per frame in each visren process, before any of the     */
+/*   frame's windows are culled, and with the graph locked for writing.    */
+/****************************************************************************/
+void vrOSGSetUpdateCallback(vrCallback *callback)
+{
+	pthread_mutex_lock(&osg_frame_lock);
+	osg_update_callback = callback;
+	pthread_mutex_unlock(&osg_frame_lock);
+}
+
+/****************************************************************************/
+/* vrOSGSetPagerBudget(): Set the time each frame may spend integrating the */
+/*   database pager's tiles: "merge_ms" for adding them to the scenegraph   */
+/*   (per process), and "compile_ms" for each slice of compiling their GL   */
+/*   objects and deleting those of expired tiles (per window), split evenly */
+/*   between the two.  The defaults are 2.0 and 4.0 milliseconds.           */
+/****************************************************************************/
+void vrOSGSetPagerBudget(double merge_ms, double compile_ms)
+{
+	pthread_mutex_lock(&osg_frame_lock);
+	osg_pager_merge_time = merge_ms / 1000.0;
+	osg_pager_compile_time = compile_ms / 1000.0;
+	if (osg_compile_op.valid())
+		osg_compile_op->setMinimumTimeAvailableForGLCompileAndDeletePerFrame(osg_pager_compile_time);
+	pthread_mutex_unlock(&osg_frame_lock);
+}
+
+/****************************************************************************/
+/* vrOSGBeginModifySceneGraph(): Lock the scenegraph for changing -- this   */
+/*   waits for the renders in progress to finish their cull & draw, and     */
+/*   keeps new ones (and the frame update) waiting until the matching call  */
+/*   of vrOSGEndModifySceneGraph().  Changes that can wait for the next     */
+/*   frame are better made with vrOSGSetUpdateCallback(), which doesn't    */
+/*   stall the rendering.                                                   */
 /****************************************************************************/
 void vrOSGBeginModifySceneGraph()
 {
-	vrLockWriteSet(osg_sg_lock);
+	pthread_once(&osg_graph_lock_once, _GlxOSGGraphLockInit);
+	pthread_rwlock_wrlock(&osg_graph_lock);
 }
 
 /****************************************************************************/
 void vrOSGEndModifySceneGraph()
 {
-	vrLockWriteRelease(osg_sg_lock);
+	pthread_rwlock_unlock(&osg_graph_lock);
 }
 #endif
 
@@ -2370,8 +3190,11 @@ void vrGlxInitWindowInfo(vrWindowInfo *info)
 {
 	vrDbgPrintfN(DEFAULT_DBGLVL, "Initializing callback and version Info for Window at %#p\n", info);
 
-#ifdef GFX_OSG
-        osg_sg_lock = vrLockCreateName(vrContext, "OSG scenegraph lock");
+#if defined(GFX_OSG) && defined(GLX_OSG_COMPILE_THREAD)
+	/* the compile thread uses the window's X connection along with the */
+	/*   render loop, so Xlib must lock it -- which must be asked for   */
+	/*   before any other Xlib call.                                     */
+	XInitThreads();
 #endif
 
 	info->version = (char *)vrShmemStrDup("GLX render window");
@@ -2380,10 +3203,12 @@ void vrGlxInitWindowInfo(vrWindowInfo *info)
 	info->Open = vrCallbackCreateNamed("GlxWindow:Open-Def", _GlxOpenFunc, 1, info);
 	info->Close = vrCallbackCreateNamed("GlxWindow:Close-Def", _GlxCloseFunc, 1, info);
 	info->Swap = vrCallbackCreateNamed("GlxWindow:Swap-Def", _GlxSwapFunc, 1, info);
+	info->SwapWait = vrCallbackCreateNamed("GlxWindow:SwapWait-Def", _GlxSwapWaitFunc, 1, info);
 	info->Errors = vrCallbackCreateNamed("GlxWindow:Errors-Def", _GlxRenderErrors, 0);
 	info->RenderTransform = vrCallbackCreateNamed("GlxWindow:Transform-Def", _GlxRenderTransform, 0);
 	info->SetProjectionTransform = vrCallbackCreateNamed("GlxWindow:ProjectionTransform-Def", _GlxSetProjectionTransform, 0);
 	info->Render = vrCallbackCreateNamed("GlxWindow:Render-Def", _GlxRenderFunc, 0);
+	info->single_pass_stereo = 1;	/* _GlxRenderFunc() can hand both eyes to the world callback */
 	info->RenderText = vrCallbackCreateNamed("GlxWindow:RenderText-Def", _GlxRenderText, 0);
 	info->RenderNullWorld = vrCallbackCreateNamed("GlxWindow:RenderNW-Def", _GlxRenderNullWorld, 0);
 	info->RenderSimulator = vrCallbackCreateNamed("GlxWindow:RenderSim-Def", vrGLRenderDefaultSimulator, 0);
@@ -16,15 +16,20 @@
 #define __VRVISREN_GLX_H__
 
 #include <GL/glx.h>
+#include <pthread.h>
 #if defined(GFX_OSG) && defined(__cplusplus)
 #  include <osgDB/ReadFile>
 #  include <osgUtil/SceneView>
 #  include <osg/Node>
 #  include <osg/Timer>
+#  include <osg/GraphicsContext>
 #endif
 
 #if !defined(TEST_APP) /* { */
 #include "vr_visren.h"
+#include "vr_visren.dynres.h"
+#include "vr_visren.capture.h"
+#include "vr_visren.gputimer.h"
 #endif /* } !TEST_APP */
 
 #undef	ENABLE_STENCIL_STEREO_TEST
@@ -124,6 +129,15 @@ typedef	struct {
 #define	DECORATION_MINMAX	0x04
 #define	DECORATION_ALL		0xFF
 
+/* the most swapped frames that may be left pending on the GPU (see "framesInFlight") */
+#define	GLX_MAXFRAMESINFLIGHT	3
+
+/* the number of X events the event thread can queue for the render loop (must be a power of 2) */
+#define	GLX_EVENTQUEUESIZE	64
+
+/* the number of recent swaps whose input time is kept, until their display is measured (see "swapTiming") */
+#define	GLX_SWAPTIMINGS		4
+
 /* these are for specifying the background and icon bitmap files */
 #define	XBM_BACK_FILE	"freevr_back.xbm"
 #define	XBM_BACK_BITS	freevr_logo_bits
@@ -169,6 +183,16 @@ static	int	stereo_buf_attribs[] = {
 		};
 
 
+/****************************************************************/
+/* An X event as queued by a window's event thread -- the keysym */
+/*   is looked up by the event thread, since only that thread    */
+/*   may use the event's display connection.                     */
+typedef struct {
+		XEvent		event;
+		KeySym		keysym;		/* for KeyPress events, otherwise NoSymbol */
+	} vrGlxQueuedEvent;
+
+
 /**************************************************/
 /* GLX-specific data (private to each GLX window) */
 /*   This structure is pointed to by the "aux_data" field of the vrWindowInfo structure.*/
@@ -210,6 +234,36 @@ typedef struct {
 		GLboolean	stereo_buf;	/* whether we have a stereo buffer */
 		GLboolean	doub_buf;	/* whether we have a double buffer */
 		GLXContext	glx_context;	/* the graphics context */
+		int		frames_in_flight;/* CONFIG-arg: number of swapped frames that may be pending (0 = wait at each swap) */
+		void		*swap_fences[GLX_MAXFRAMESINFLIGHT+1];/* ring of fences (GLsync) placed after each swap */
+		int		swap_fence_next;/* the ring slot for the next fence -- which also holds the oldest one */
+		int		event_thread;	/* CONFIG-arg: flag to read the X events in a separate thread */
+		int		event_thread_running;/* flag set once the event thread has been started */
+		pthread_t	event_tid;	/* the thread that reads this window's X events */
+		Display		*event_xdisplay;/* the event thread's own connection to the X server */
+		Atom		event_quit_atom;/* the type of the ClientMessage that wakes the event thread to quit */
+		volatile int	event_quit;	/* flag telling the event thread to quit (set by the close function) */
+		volatile unsigned int event_head;/* count of queued events read -- only changed by the render loop */
+		volatile unsigned int event_tail;/* count of queued events written -- only changed by the event thread */
+		unsigned int	events_dropped;	/* count of events lost to a full queue */
+		vrGlxQueuedEvent event_queue[GLX_EVENTQUEUESIZE];/* single-reader/single-writer ring of X events */
+		int		oml_status;	/* 1 when GLX_OML_sync_control gives the swap times, -1 if estimated, 0 if not yet checked */
+		double		msc_period;	/* the time (secs) between vertical blanks */
+		int64_t		swap_sbc;	/* the swap count (SBC) of the last swap issued */
+		int64_t		swap_ring_sbc[GLX_SWAPTIMINGS];/* the SBC of each recent swap */
+		double		swap_ring_input[GLX_SWAPTIMINGS];/* the input time of the frame of each recent swap */
+		int64_t		done_sbc;	/* (estimated) the SBC of the last swap known to be done on the GPU */
+		double		done_wtime;	/* (estimated) the wall time at which it was known to be done */
+		int64_t		timed_sbc;	/* the SBC of the last swap whose display was measured */
+		int64_t		timed_msc;	/* the vertical blank count (MSC) at which it was displayed (-1 when estimated) */
+		double		timed_wtime;	/* the wall time at which it was displayed */
+		long		swaps_timed;	/* count of the swaps whose display was measured */
+		double		photon_mean;	/* the smoothed motion-to-photon latency (ms) */
+#if !defined(TEST_APP)
+		vrDynresInfo	dynres;		/* CONFIG-arg: the dynamic resolution scaling of the world */
+		vrCaptureInfo	capture;	/* the frame capture of the window */
+		vrGpuTimerInfo	gputimer;	/* the GPU time measurement of the window */
+#endif
 		XFontStruct	*fontStruct;	/* the X font structure for a context */
 		GLuint		fontListBase;	/* the fontListBase for this window   */
 #ifdef GFX_PERFORMER
@@ -218,8 +272,12 @@ typedef struct {
 #endif
 #if defined(GFX_OSG) && defined(__cplusplus)	/* NOTE: it's dangerous to have source files with different ideas about the size of a structure, but in this case, only one source file makes use of the structure definition -- the others want other things from this header */
 		osg::ref_ptr<osgUtil::SceneView> sceneview;	/* camera & rendering data for each screen -- used to manage cull and render calls -- similar to Performer channels */
-		unsigned int	frame_num;	/* Number of current frame. Used for creating osg::FrameStamp. */
-		osg::Timer_t	start_tick;	/* Start tick of beginning of first frame. Used for creating osg::FrameStamp.*/
+		osg::ref_ptr<osg::GraphicsContext> compile_gc;	/* the context the pager's GL objects are compiled in (as known to the IncrementalCompileOperation) */
+		int		compile_thread_running;/* flag set once the pager's compile thread has been started */
+		volatile int	compile_quit;	/* flag telling the compile thread to finish */
+		pthread_t	compile_tid;	/* the thread that compiles the pager's GL objects for this window */
+		Window		compile_xwindow;/* an unmapped window (on xdisplay) for the compile thread's context */
+		GLXContext	compile_context;/* a context sharing the objects of glx_context */
 #endif
 	} vrGlxPrivateInfo;
 
@@ -247,7 +305,9 @@ pfChannel	*vrPfMasterChannel(void);
 /* some OSG specific functions */
 void		vrOSGSetSceneData(osg::Node * sd);			/* Set OpenSceneGraph Scene Data */
 void		vrOSGSetDatabasePager(osgDB::DatabasePager *pager);	/* Set OpenSceneGraph pager (for PagedLOD) */
-void		vrOSGBeginModifySceneGraph();				/* Locking function prior to modifying scenegraph */
+void		vrOSGSetUpdateCallback(vrCallback *callback);		/* Set the once-per-frame scenegraph changes of the application */
+void		vrOSGSetPagerBudget(double merge_ms, double compile_ms);	/* Set the per-frame time slices of the pager's merges and compiles */
+void		vrOSGBeginModifySceneGraph();				/* Locking function prior to modifying scenegraph (outside of rendering) */
 void		vrOSGEndModifySceneGraph();				/* Unlocking function post scenegraph modification */
 #endif
 
@@ -0,0 +1,316 @@
+/* ======================================================================
+ *
+ *  CCCCC          vr_visren.gputimer.c
+ * CC   CC         Author(s): agent
+ * CC              Created: October 19, 2026
+ * CC   CC         Last Modified: October 19, 2026
+ *  CCCCC
+ *
+ * Code file for the GPU time measurement of windows shared by the
+ *   OpenGL visual rendering types (GLX and EGL).
+ *
+ * The time marks of the process stats are taken from the CPU clock, so
+ *   they can't tell a frame the GPU is slow to render from one that the
+ *   application is slow to draw -- either way, the time goes to whatever
+ *   next has to wait for the GPU (usually the swap).  So, with the
+ *   "gpuTimer" window argument (or the telnet "window[<num>] gputimer 1"
+ *   command), the render of each eye and the swap are also bracketed by
+ *   GL_TIME_ELAPSED queries (OpenGL 3.3, or GL_ARB_timer_query), which
+ *   measure how long the GPU spent on the commands between them.
+ *
+ * The results are added to the process' "gpu-render" & "gpu-swap" stats
+ *   values (summed over the windows), kept in the window's gpu_render_time
+ *   & gpu_swap_time fields, and printed (per eye) with the window's
+ *   private data.  Since the queries are read a few frames late, so as
+ *   not to wait on the GPU, the values lag the CPU stats by that many
+ *   frames.
+ *
+ * NOTE: only one GL_TIME_ELAPSED query can be active at a time, so an
+ *   application that makes its own queries (within the world callback)
+ *   should not be measured this way.
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "vr_visren.gputimer.h"
+#include "vr_debug.h"
+
+
+/****************************************************************************/
+/* The query functions are fetched at run-time, since the GL library to     */
+/*   which we link need not have them.  The addresses are the same for every */
+/*   context, so they are only fetched once per process.                     */
+static	PFNGLGENQUERIESPROC		glGenQueries_func = NULL;
+static	PFNGLDELETEQUERIESPROC		glDeleteQueries_func = NULL;
+static	PFNGLBEGINQUERYPROC		glBeginQuery_func = NULL;
+static	PFNGLENDQUERYPROC		glEndQuery_func = NULL;
+static	PFNGLGETQUERYOBJECTIVPROC	glGetQueryObjectiv_func = NULL;
+static	PFNGLGETQUERYOBJECTUI64VPROC	glGetQueryObjectui64v_func = NULL;
+
+
+/****************************************************************************/
+/* _GpuTimerLoadFuncs(): returns 1 if the timer query functions are         */
+/*   available to the current context, after fetching them if not already   */
+/*   fetched.                                                                */
+static int _GpuTimerLoadFuncs(void *(*getproc)(const char *))
+{
+	const char	*version = (const char *)glGetString(GL_VERSION);
+	const char	*extensions = (const char *)glGetString(GL_EXTENSIONS);
+	int		major = 0;
+	int		minor = 0;
+
+	if (version != NULL)
+		sscanf(version, "%d.%d", &major, &minor);
+	if ((major < 3 || (major == 3 && minor < 3)) && (extensions == NULL || strstr(extensions, "GL_ARB_timer_query") == NULL))
+		return 0;
+
+	if (glGetQueryObjectui64v_func == NULL) {
+		glGenQueries_func = (PFNGLGENQUERIESPROC)getproc("glGenQueries");
+		glDeleteQueries_func = (PFNGLDELETEQUERIESPROC)getproc("glDeleteQueries");
+		glBeginQuery_func = (PFNGLBEGINQUERYPROC)getproc("glBeginQuery");
+		glEndQuery_func = (PFNGLENDQUERYPROC)getproc("glEndQuery");
+		glGetQueryObjectiv_func = (PFNGLGETQUERYOBJECTIVPROC)getproc("glGetQueryObjectiv");
+		glGetQueryObjectui64v_func = (PFNGLGETQUERYOBJECTUI64VPROC)getproc("glGetQueryObjectui64v");
+	}
+
+	return (glGenQueries_func != NULL && glDeleteQueries_func != NULL
+		&& glBeginQuery_func != NULL && glEndQuery_func != NULL
+		&& glGetQueryObjectiv_func != NULL && glGetQueryObjectui64v_func != NULL);
+}
+
+
+/****************************************************************************/
+/* _GpuTimerBegin(): begin the given query of the current frame -- unless   */
+/*   one is already begun, as they can't be nested.                         */
+static void _GpuTimerBegin(vrGpuTimerInfo *timer, int which)
+{
+	if (timer->open >= 0)
+		return;
+
+	glBeginQuery_func(GL_TIME_ELAPSED, timer->query[timer->frame][which]);
+	timer->issued[timer->frame][which] = 1;
+	timer->open = which;
+}
+
+
+/****************************************************************************/
+static void _GpuTimerEnd(vrGpuTimerInfo *timer)
+{
+	if (timer->open < 0)
+		return;
+
+	glEndQuery_func(GL_TIME_ELAPSED);
+	timer->open = -1;
+}
+
+
+/****************************************************************************/
+/* _GpuTimerCollect(): read the results of the given frame of the ring, if   */
+/*   they are all done, and free its queries for reuse.                      */
+static void _GpuTimerCollect(vrGpuTimerInfo *timer, vrWindowInfo *window, int frame)
+{
+	GLint		available;
+	GLuint64	elapsed;
+	double		render_time = 0.0;
+	int		eyes = 0;
+	int		issued = 0;
+	int		count;
+
+	/* NOTE: checking for the result of each query doesn't wait for it */
+	for (count = 0; count <= VR_GPUTIMER_EYES; count++) {
+		if (!timer->issued[frame][count])
+			continue;
+		issued++;
+		glGetQueryObjectiv_func(timer->query[frame][count], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) {
+			timer->frames_late++;
+			memset(timer->issued[frame], 0, sizeof(timer->issued[frame]));
+			return;
+		}
+	}
+	if (issued == 0)
+		return;
+
+	for (count = 0; count < VR_GPUTIMER_EYES; count++) {
+		if (!timer->issued[frame][count])
+			continue;
+		glGetQueryObjectui64v_func(timer->query[frame][count], GL_QUERY_RESULT, &elapsed);
+		timer->eye_time[count] = (double)elapsed / 1000000.0;
+		if (timer->frames_measured == 0)
+			timer->eye_mean[count] = timer->eye_time[count];
+		else	timer->eye_mean[count] += VR_GPUTIMER_SMOOTH * (timer->eye_time[count] - timer->eye_mean[count]);
+		render_time += timer->eye_time[count];
+		eyes++;
+	}
+	if (timer->issued[frame][VR_GPUTIMER_SWAP]) {
+		glGetQueryObjectui64v_func(timer->query[frame][VR_GPUTIMER_SWAP], GL_QUERY_RESULT, &elapsed);
+		timer->swap_time = (double)elapsed / 1000000.0;
+		if (timer->frames_measured == 0)
+			timer->swap_mean = timer->swap_time;
+		else	timer->swap_mean += VR_GPUTIMER_SMOOTH * (timer->swap_time - timer->swap_mean);
+	}
+	timer->eyes_measured = eyes;
+	timer->frames_measured++;
+	memset(timer->issued[frame], 0, sizeof(timer->issued[frame]));
+
+	window->gpu_render_time = render_time;
+	window->gpu_swap_time = timer->swap_time;
+
+	/* measure: the GPU time of the window's renders & swap */
+	vrWindowStatsValue(window, VR_VALUE_GPURENDER, render_time);
+	vrWindowStatsValue(window, VR_VALUE_GPUSWAP, timer->swap_time);
+}
+
+
+/*****************************************************************/
+/* vrGpuTimerInit(): set the defaults -- not measuring. */
+void vrGpuTimerInit(vrGpuTimerInfo *timer)
+{
+	memset(timer, 0, sizeof(vrGpuTimerInfo));
+	timer->status = 0;
+	timer->active = 0;
+	timer->open = -1;
+}
+
+
+/*****************************************************************/
+void vrGpuTimerParseArgs(vrWindowInfo *window, char *args)
+{
+	char	*str = NULL;
+
+	/**************************************************/
+	/** Argument format: "gpuTimer=" {0|1} [(";" | ",")] **/
+	/**************************************************/
+	if (str = strstr(args, "gpuTimer=")) {
+		window->gpu_timer = atoi(strchr(str, '=') + 1);
+	}
+}
+
+
+/*****************************************************************/
+void vrGpuTimerFprint(FILE *file, vrGpuTimerInfo *timer)
+{
+	int	count;
+
+	vrFprintf(file, "\r\tgputimer = { active = %d; measured = %ld; late = %ld; swap = %.3f ms (mean %.3f ms)",
+		timer->active,
+		timer->frames_measured,
+		timer->frames_late,
+		timer->swap_time,
+		timer->swap_mean);
+	for (count = 0; count < timer->eyes_measured; count++) {
+		vrFprintf(file, "; eye[%d] = %.3f ms (mean %.3f ms)",
+			count,
+			timer->eye_time[count],
+			timer->eye_mean[count]);
+	}
+	vrFprintf(file, " }\n");
+}
+
+
+/****************************************************************************/
+/* vrGpuTimerSwapBegin(): called by the Swap function of the graphics type, */
+/*   with the window's context current, before any of the swap's GL work    */
+/*   (eg. a capture).  This starts or stops the measurement as the window's */
+/*   "gpu_timer" flag requests, and begins the query of the swap.           */
+/* NOTE: the "getproc" function fetches a GL function of the graphics type */
+/*   (ie. glXGetProcAddressARB() or eglGetProcAddress()).                   */
+void vrGpuTimerSwapBegin(vrGpuTimerInfo *timer, vrWindowInfo *window, void *(*getproc)(const char *))
+{
+	if (!window->gpu_timer) {
+		if (timer->active)
+			vrGpuTimerStop(timer);
+		return;
+	}
+
+	if (!timer->active) {
+		if (timer->status == 0)
+			timer->status = (_GpuTimerLoadFuncs(getproc) ? 1 : -1);
+		if (timer->status < 0) {
+			vrErrPrintf("vrGpuTimerSwapBegin(): " RED_TEXT "window '%s' has no timer queries -- unable to measure the GPU.\n" NORM_TEXT, window->name);
+			window->gpu_timer = 0;
+			return;
+		}
+
+		glGenQueries_func(VR_GPUTIMER_FRAMES * (VR_GPUTIMER_EYES+1), &(timer->query[0][0]));
+		memset(timer->issued, 0, sizeof(timer->issued));
+		timer->frame = 0;
+		timer->eyes = 0;
+		timer->open = -1;
+		timer->eyes_measured = 0;
+		timer->frames_measured = 0;
+		timer->frames_late = 0;
+		timer->active = 1;
+
+		vrDbgPrintfN(SELDOM_DBGLVL, "vrGpuTimerSwapBegin(): measuring the GPU time of window '%s'.\n", window->name);
+	}
+
+	_GpuTimerBegin(timer, VR_GPUTIMER_SWAP);
+}
+
+
+/****************************************************************************/
+/* vrGpuTimerSwapEnd(): called by the Swap function once the buffers are    */
+/*   swapped.  This ends the frame -- its queries are read when the ring    */
+/*   comes back around to it -- and reads those of the oldest frame.        */
+void vrGpuTimerSwapEnd(vrGpuTimerInfo *timer, vrWindowInfo *window)
+{
+	if (!timer->active)
+		return;
+
+	_GpuTimerEnd(timer);
+
+	/* the next frame of the ring is the oldest, so its queries are the most likely done */
+	timer->frame = (timer->frame + 1) % VR_GPUTIMER_FRAMES;
+	timer->eyes = 0;
+	_GpuTimerCollect(timer, window, timer->frame);
+}
+
+
+/****************************************************************************/
+/* vrGpuTimerEyeBegin(): called by the Render function of the graphics type, */
+/*   with the window's context current, before rendering an eye (or both   */
+/*   eyes in one pass).                                                     */
+void vrGpuTimerEyeBegin(vrGpuTimerInfo *timer)
+{
+	if (!timer->active || timer->eyes >= VR_GPUTIMER_EYES)
+		return;
+
+	_GpuTimerBegin(timer, timer->eyes);
+	timer->eyes++;
+}
+
+
+/****************************************************************************/
+void vrGpuTimerEyeEnd(vrGpuTimerInfo *timer)
+{
+	if (!timer->active)
+		return;
+
+	_GpuTimerEnd(timer);
+}
+
+
+/****************************************************************************/
+/* vrGpuTimerStop(): delete the queries (so must be called with the window's */
+/*   context current).  The results of the frames still in the ring are     */
+/*   dropped.                                                               */
+void vrGpuTimerStop(vrGpuTimerInfo *timer)
+{
+	if (!timer->active)
+		return;
+
+	_GpuTimerEnd(timer);
+	glDeleteQueries_func(VR_GPUTIMER_FRAMES * (VR_GPUTIMER_EYES+1), &(timer->query[0][0]));
+	timer->active = 0;
+
+	vrDbgPrintfN(SELDOM_DBGLVL, "vrGpuTimerStop(): measured %ld frames (%ld late).\n",
+		timer->frames_measured, timer->frames_late);
+}
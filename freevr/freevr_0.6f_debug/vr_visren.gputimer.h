@@ -0,0 +1,83 @@
+/* ======================================================================
+ *
+ * HH   HH         vr_visren.gputimer.h
+ * HH   HH         Author(s): agent
+ * HHHHHHH         Created: October 19, 2026
+ * HH   HH         Last Modified: October 19, 2026
+ * HH   HH
+ *
+ * Header file for the GPU time measurement of windows shared by the
+ *   OpenGL visual rendering types (GLX and EGL).
+ *
+ * Copyright 2026, agent, All rights reserved.
+ * With the intent to provide an open-source license to be named later.
+ * ====================================================================== */
+#ifndef __VRVISREN_GPUTIMER_H__
+#define __VRVISREN_GPUTIMER_H__
+
+#include <stdio.h>
+#include <GL/gl.h>
+
+#if !defined(TEST_APP) /* { */
+#include "vr_visren.h"
+#endif /* } !TEST_APP */
+
+
+#define	VR_GPUTIMER_FRAMES	4	/* frames of queries in the ring -- ie. frames before a result is read */
+#define	VR_GPUTIMER_EYES	4	/* renders (eyes) measured per frame -- any more go unmeasured */
+#define	VR_GPUTIMER_SWAP	VR_GPUTIMER_EYES	/* the query of the swap follows those of the eyes */
+#define	VR_GPUTIMER_SMOOTH	0.1	/* weight of each new result in the smoothed times */
+
+
+/*******************************************************************/
+/* The GPU timer data of one window.  When the window's "gpu_timer" */
+/*   flag is set, each render of an eye (or of both eyes, with      */
+/*   single-pass stereo) and the swap are bracketed by a            */
+/*   GL_TIME_ELAPSED query.  The queries of a frame are only read   */
+/*   VR_GPUTIMER_FRAMES-1 frames later, when the GPU is long done   */
+/*   with them, so the measurement never waits on the GPU -- a      */
+/*   frame whose queries still aren't done is counted as "late",    */
+/*   and skipped.                                                   */
+/* This structure is part of the graphics type's private data of a  */
+/*   window, so it is only used by the process rendering it (but    */
+/*   may be printed from any).                                      */
+typedef struct {
+		int		status;		/* 1 when the query functions are loaded, -1 if they aren't available */
+		int		active;		/* flag set while the queries exist */
+		GLuint		query[VR_GPUTIMER_FRAMES][VR_GPUTIMER_EYES+1];/* the queries of each frame of the ring */
+		int		issued[VR_GPUTIMER_FRAMES][VR_GPUTIMER_EYES+1];/* flags for the queries begun in each frame */
+		int		frame;		/* the frame of the ring being measured */
+		int		eyes;		/* the renders measured so far this frame */
+		int		open;		/* the query begun but not yet ended (-1 for none) */
+
+		double		eye_time[VR_GPUTIMER_EYES];/* the last GPU time (ms) of each render */
+		double		swap_time;	/* the last GPU time (ms) of the swap */
+		double		eye_mean[VR_GPUTIMER_EYES];/* the smoothed GPU times */
+		double		swap_mean;
+		int		eyes_measured;	/* the number of renders in the last measured frame */
+		long		frames_measured;/* frames whose times were read */
+		long		frames_late;	/* frames whose queries weren't done in time */
+	} vrGpuTimerInfo;
+
+
+/*****************************/
+/*** Function declarations ***/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void	vrGpuTimerInit(vrGpuTimerInfo *timer);
+void	vrGpuTimerParseArgs(vrWindowInfo *window, char *args);
+void	vrGpuTimerFprint(FILE *file, vrGpuTimerInfo *timer);
+void	vrGpuTimerSwapBegin(vrGpuTimerInfo *timer, vrWindowInfo *window, void *(*getproc)(const char *));
+void	vrGpuTimerSwapEnd(vrGpuTimerInfo *timer, vrWindowInfo *window);
+void	vrGpuTimerEyeBegin(vrGpuTimerInfo *timer);
+void	vrGpuTimerEyeEnd(vrGpuTimerInfo *timer);
+void	vrGpuTimerStop(vrGpuTimerInfo *timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
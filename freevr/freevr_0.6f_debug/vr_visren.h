@@ -61,6 +61,30 @@ typedef enum vrWindowMountType_en {
 #define	VR_TIME_SWAP	 	8
 #define	VR_TIME_TRAVEL	 	9
 
+/* Array indices for (non-time) per-frame stats values */
+#define	VR_VALUE_LATCHAGE	0	/* how much newer (ms) the late-latched head is than the frozen one */
+#define	VR_VALUE_FREEZECOPIED	1	/* number of inputs the freeze had to copy */
+#define	VR_VALUE_FREEZESKIPPED	2	/* number of inputs the freeze found unchanged */
+#define	VR_VALUE_WINDOW0	3	/* render time (ms) of the first window -- one value per window */
+#define	VR_MAXWINDOWVALUES	4	/*   for up to this many windows                            */
+#define	VR_VALUE_FENCEWAIT	7	/* time (ms) spent waiting on the swap fences of all windows */
+#define	VR_VALUE_PERSPCACHED	8	/* number of eyes whose perspective was reused from the cache */
+#define	VR_VALUE_STEREOPASS	9	/* number of windows whose two eyes were rendered in a single pass */
+#define	VR_VALUE_OVERBUDGET	10	/* number of windows predicted to go over their frame budget */
+#define	VR_VALUE_RESSCALE	11	/* lowest resolution scale (%) of the windows (see "dynamicResolution") */
+#define	VR_VALUE_PAGERREQUESTS	12	/* (OSG) number of tiles the database pager has yet to load */
+#define	VR_VALUE_PAGERMERGED	13	/* (OSG) number of loaded tiles merged into the scene graph this frame */
+#define	VR_VALUE_PAGERWAITING	14	/* (OSG) number of loaded tiles still waiting to be compiled or merged */
+#define	VR_VALUE_CAPTURETIME	15	/* time (ms) spent capturing the frames of the windows (see "window[] capture") */
+#define	VR_VALUE_CAPTUREDROPPED	16	/* number of captured frames dropped because the writer fell behind */
+#define	VR_VALUE_GPURENDER	17	/* GPU time (ms) of rendering the eyes of the windows (see "gpuTimer") */
+#define	VR_VALUE_GPUSWAP	18	/* GPU time (ms) of swapping the windows (see "gpuTimer") */
+#define	VR_VALUE_PHOTONLATENCY	19	/* time (ms) from the head sample to the display of its frame (see "swapTiming") */
+#define	VR_VALUE_MISSEDVBLANKS	20	/* number of vertical blanks that passed with no new frame (see "swapTiming") */
+
+/* The frame budget (ms) of a window not given one in the configuration */
+#define	VR_DEFAULT_FRAMEBUDGET	(1000.0/60.0)	/* ie. a 60 Hz display */
+
 
 /****************************************************************************/
 /* TODO: consider making these an enumerated type */
@@ -126,6 +150,45 @@ typedef struct {
 	} vrPerspData;
 
 
+/*********************************************************************/
+/* A cache of the perspective data of one eye of a window.  The data */
+/*   is reused for as long as none of the values it is calculated    */
+/*   from -- the eye location (ie. the head pose plus the eye        */
+/*   offset), the window corners, the window transform and the       */
+/*   clipping planes -- has changed.                                 */
+typedef struct {
+		int			valid;		/* whether the data below has been calculated */
+		double			eye[3];		/* real-world location of the eye */
+		vrMatrix		rw2w_xform;	/* the window's real-world to window transform */
+		vrPoint			Lpoint;		/* the window's lower left corner */
+		vrPoint			Hpoint;		/* the window's upper right corner */
+		double			near_clip[3];	/* the window, system and default near clipping planes */
+		double			far_clip[3];	/* the window, system and default far clipping planes */
+		vrPerspData		persp;		/* the perspective calculated from the above */
+	} vrPerspCache;
+
+
+/*************************************************************************/
+/* The six planes bounding a view frustum.  Each plane is the equation  */
+/*   a*x + b*y + c*z + d = 0 (stored as { a, b, c, d }), normalized such */
+/*   that (a,b,c) is a unit vector pointing into the frustum -- so the   */
+/*   value of the equation at a point is its distance inside the plane.  */
+#define	VR_FRUSTUM_LEFT		0
+#define	VR_FRUSTUM_RIGHT	1
+#define	VR_FRUSTUM_BOTTOM	2
+#define	VR_FRUSTUM_TOP		3
+#define	VR_FRUSTUM_NEAR		4
+#define	VR_FRUSTUM_FAR		5
+typedef struct {
+		double		plane[6][4];
+	} vrFrustumPlanes;
+
+/* values returned by the culling functions */
+#define	VR_CULL_OUTSIDE		0	/* the object is entirely outside the frustum */
+#define	VR_CULL_PARTIAL		1	/* the object may be partially inside the frustum */
+#define	VR_CULL_INSIDE		2	/* the object is entirely inside the frustum */
+
+
 /***************************************************************************/
 /* Fields marked as "CONFIG" are filled in direction from the config       */
 /*   file.  Other fields are determined in combination with other factors. */
@@ -196,6 +259,29 @@ typedef struct vrWindowInfo_st {
 		char		*stats_procs;	/* CONFIG: a string of which processes to show stats */
 		vrProcessStats	**stats[VR_MAXSTATS];/* array of pointers to pointers to stats information from stats_procs */
 		int		inputs_show;	/* Changeable/CONFIG: A flag indicating whether to show input histories */
+		int		late_latch;	/* Changeable/CONFIG: A flag indicating whether to re-sample the head position just before rendering */
+		int		render_thread;	/* CONFIG: A flag indicating whether to render this window in a thread of its own */
+		double		thread_values[VR_MAXSTATSVALUES];/* the stats values summed by the render thread, until the process adds them in */
+		unsigned int	thread_values_set;/* bits of the thread_values that are set (rather than summed) -- see vrWindowStatsValueSet() */
+		float		frame_budget;	/* Changeable/CONFIG: target time (ms) of a frame, for the budget given to the render callbacks */
+		float		res_scale;	/* the scale of the resolution at which the world was last rendered (set by the graphics type) */
+		int		capture_request;/* Changeable/CONFIG: A flag indicating whether to capture (record) the frames of the window */
+		char		capture_file[256];/* Changeable/CONFIG: the file to capture into -- its extension sets the format */
+		int		export_request;/* Changeable/CONFIG: A flag indicating whether to export the frames of the window to shared memory */
+		char		export_name[256];/* Changeable/CONFIG: the name of the shared-memory object to export into */
+		int		gpu_timer;	/* Changeable/CONFIG: A flag indicating whether to measure the GPU time of the eyes & swap */
+		float		gpu_render_time;/* the GPU time (ms) of the eyes of a recent frame (set by the graphics type) */
+		float		gpu_swap_time;	/* the GPU time (ms) of the swap of a recent frame (set by the graphics type) */
+		int		swap_timing;	/* Changeable/CONFIG: A flag indicating whether to measure when the swapped frames are displayed */
+		vrTime		input_wtime;	/* the time of the head sample from which the current frame was rendered */
+		float		photon_latency;	/* the time (ms) from the head sample to the display of a recent frame (set by the graphics type) */
+		long		missed_vblanks;	/* the number of vertical blanks that passed with no new frame (set by the graphics type) */
+		vrPerspCache	*persp_cache;	/* the perspective data of each eye of the previous frame */
+		int		single_pass_stereo;/* A flag set by the graphics type when its Render can draw both eyes at once */
+		vrPerspData	*eye_persp;	/* the perspective data of each eye for the current frame */
+		vrFrustumPlanes	*eye_frustum;	/* the view frustum of each eye for the current frame (real-world coords) */
+		vrPoint		*eye_corners;	/* the eight corners of each of those frustums (real-world coords) */
+		vrFrustumPlanes	frustum;	/* a frustum containing those of all the eyes (real-world coords) */
 
 		int		show_in_simulator;/* Changeable/CONFIG: A flag/mask indicating whether to show this window in the simulator view.  (NOTE: this is unique in that it affects what happens in OTHER windows) */
 
@@ -206,6 +292,7 @@ typedef struct vrWindowInfo_st {
 		vrCallback	*VisrenFrame;	/* function to set state information for a rendering frame */
 		vrCallback	*VisrenWorld;	/* function to render the virtual world scene (called per eye) */
 		vrCallback	*VisrenSim;	/* function to render the simulator view */
+		vrCallback	*VisrenWorldStereo;/* function to render both eyes of the world at once (NULL for two passes) */
 		vrCallback	*VisrenExit;	/* function to restore any graphics state prior to exiting */
 
 		/*******************************/
@@ -216,6 +303,7 @@ typedef struct vrWindowInfo_st {
 		vrCallback	*Open;		/* function to open the rendering window */
 		vrCallback	*Close;		/* function to close the rendering window */
 		vrCallback	*Swap;		/* function to swap front and back graphics buffers */
+		vrCallback	*SwapWait;	/* function to wait for swapped frames to finish (called after all windows are swapped) */
 		vrCallback	*Errors;	/* function to report any errors from the graphics system */
 		vrCallback	*RenderTransform;/* function to make a 3D transformation */
 		vrCallback	*SetProjectionTransform;/* function to make set the top of the projection stack */
@@ -227,6 +315,22 @@ typedef struct vrWindowInfo_st {
 	} vrWindowInfo;
 
 
+/**************************************************************************/
+/* The views of both eyes of a window rendered in a single pass.  Index 0 */
+/*   is always the left eye, and index 1 the right -- regardless of the   */
+/*   order of the eyes in the window.  The world callback can draw both   */
+/*   views at once (eg. with instancing and viewport arrays, or into a    */
+/*   layered/multiview target) using the matrices from the functions      */
+/*   vrRenderGetStereoProjection() and vrRenderGetStereoView().           */
+#define	VR_STEREO_LEFT		0
+#define	VR_STEREO_RIGHT		1
+typedef struct {
+		vrEyeInfo	*eye[2];	/* the left and right eyes */
+		vrPerspData	persp[2];	/* the perspective data of each eye */
+		vrViewport	viewport[2];	/* the region of the window for each eye */
+	} vrStereoInfo;
+
+
 /*******************************************************/
 /* type definition for data passed to each render call */
 typedef struct {
@@ -236,6 +340,14 @@ typedef struct {
 		int		persp_stack_depth; /* Depth of the perspective stack        */
 		vrWindowInfo	*window;	/* Pointer to window rendering into         */
 		vrEyeInfo	*eye;		/* Pointer to eye rendering to              */
+		vrStereoInfo	*stereo;	/* Both eyes, when rendering a single-pass stereo frame (else NULL) */
+		vrFrustumPlanes	rw_frustum;	/* view frustum of the eye in real-world coords */
+		vrFrustumPlanes	rw_frustum_window;/* frustum containing all eyes of the window (real-world) */
+		vrFrustumPlanes	vw_frustum;	/* view frustum of the eye in virtual-world coords */
+		vrFrustumPlanes	vw_frustum_window;/* frustum containing all eyes of the window (virtual-world) */
+		vrTime		frame_budget;	/* target time of a frame (secs) -- from the window's frameBudget */
+		vrTime		frame_cost;	/* smoothed render time of recent frames of this process (secs) */
+		vrTime		frame_headroom;	/* predicted time left in the budget this frame (negative when over) */
 		vrMatrix	*rw2vw_xform;	/* transform from real to virtual CoordSys  */
 		vrMatrix	*vw2rw_xform;	/* transform from virtual to real CoordSys  */
 		long		frame_count;	/* This process' frame_count                */
@@ -291,11 +403,19 @@ void		vrRenderTransformUserTravelInv(vrRenderInfo *renderinfo);
 int		vrRenderTransform6sensor(vrRenderInfo *renderinfo, int sensor6_num);
 void		vrRenderTransform6sensorDirect(vrRenderInfo *renderinfo, vr6sensor *sensor6);
 void		vrRenderSetProjectionTransform(vrRenderInfo *renderinfo, vrPerspData *pd);
+vrMatrix	*vrRenderGetStereoProjection(vrRenderInfo *renderinfo, int which_eye, vrMatrix *mat);
+vrMatrix	*vrRenderGetStereoView(vrRenderInfo *renderinfo, int which_eye, vrMatrix *mat);
+int		vrFrustumCullSphere(vrFrustumPlanes *frustum, double *center, double radius);
+int		vrFrustumCullBox(vrFrustumPlanes *frustum, double *min, double *max);
+int		vrRenderCullSphere(vrRenderInfo *renderinfo, double *center, double radius);
+int		vrRenderCullBox(vrRenderInfo *renderinfo, double *min, double *max);
 int		vrRenderPushPerspFrom6sensor(vrRenderInfo *renderinfo, int sensor6_num);
 int		vrRenderPopPersp(vrRenderInfo *renderinfo);
 vrEuler		*vrRenderGetBillboardAngles3d(vrRenderInfo *renderinfo, vrEuler *eulers, double x_loc, double y_loc, double z_loc);
 vrEuler		*vrRenderGetBillboardAnglesAd(vrRenderInfo *renderinfo, vrEuler *eulers, double *loc);
 void		vrRenderCategory(vrRenderInfo *renderinfo, int tag);
+void		vrWindowStatsValue(vrWindowInfo *window, int value, double amount);
+void		vrWindowStatsValueSet(vrWindowInfo *window, int value, double amount);
 
 void		vrVisrenMainLoop(vrProcessInfo *myproc_info);
 void		vrVisrenGetInfo(vrWindowInfo *);
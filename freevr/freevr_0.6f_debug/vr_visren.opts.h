@@ -41,6 +41,10 @@ void	vrGlxInitWindowInfo(vrWindowInfo *);
 #endif
 #endif
 
+#ifdef WIN_EGL
+void	vrEglInitWindowInfo(vrWindowInfo *);
+#endif
+
 #ifdef WIN_WGL
 #if 0
 #include "vr_visren.wgl.h"
@@ -54,6 +58,9 @@ vrVisrenOptsType vrVisrenOpts[] = {
 #ifdef WIN_GLX
 		{ "glx", vrGlxInitWindowInfo },		/* fill in info struct for GLX */
 #endif
+#ifdef WIN_EGL
+		{ "egl", vrEglInitWindowInfo },		/* headless (offscreen) EGL pbuffers */
+#endif
 
 #ifdef WIN_WGL
 		/* NOTE: "glx" is used because really all the window placement stuff */
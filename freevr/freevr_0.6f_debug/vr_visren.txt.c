@@ -1026,7 +1026,9 @@ printf("YO: default case, color = %d\n", curr_eye->color);
        }
 
 	/* measure: time just spent in rendering each eye (not counting the simulator and information displays) */
-	vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDER1, 1);
+	/*   (but not from a render thread -- only the process itself makes the marks) */
+	if (!curr_window->render_thread)
+		vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDER1, 1);
 
 	/*****************************************************/
 	/* (vii) call simulator_render (if simulator window) */
@@ -1500,7 +1502,9 @@ static		char	ui_string_tok[2048];
 	}
 
 	/* measure: time just spent in rendering the simulator and information displays */
-	vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDERINFO, 1);
+	/*   (but not from a render thread -- only the process itself makes the marks) */
+	if (!curr_window->render_thread)
+		vrProcessStatsMark(curr_window->proc->stats, VR_TIME_RENDERINFO, 1);
 
 
 	/**************************************/